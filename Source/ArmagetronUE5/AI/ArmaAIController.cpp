@@ -4,6 +4,7 @@
 #include "Game/ArmaCycle.h"
 #include "Game/ArmaCycleMovement.h"
 #include "Game/ArmaWall.h"
+#include "Game/ArmaCollisionSubsystem.h"
 #include "Core/ArmaGrid.h"
 #include "Kismet/GameplayStatics.h"
 #include "Engine/World.h"
@@ -105,7 +106,7 @@ void AArmaAIController::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
 
-	float CurrentTime = GetWorld()->GetTimeSeconds();
+	float CurrentTime = UArmaCollisionSubsystem::GetSimTime(GetWorld());
 
 	// Check if it's time to think
 	if (CurrentTime >= NextThinkTime)
@@ -134,7 +135,7 @@ void AArmaAIController::OnUnPossess()
 void AArmaAIController::SwitchToState(EArmaAIState NewState, float MinTime)
 {
 	CurrentState = NewState;
-	NextStateChange = GetWorld()->GetTimeSeconds() + MinTime;
+	NextStateChange = UArmaCollisionSubsystem::GetSimTime(GetWorld()) + MinTime;
 
 	// Reset state-specific variables
 	bEmergency = false;
@@ -177,7 +178,7 @@ void AArmaAIController::CycleBlocksWay(AArmaCycle* A, AArmaCycle* B, int32 ADir,
 		{
 			Entry->Side = ADir;
 			Entry->Distance = BDist;
-			Entry->Time = A->GetWorld()->GetTimeSeconds();
+			Entry->Time = UArmaCollisionSubsystem::GetSimTime(A->GetWorld());
 		}
 	}
 }
@@ -280,7 +281,7 @@ void AArmaAIController::ThinkSurvive(FArmaAIThinkData& Data)
 	}
 
 	// Consider switching to trace or attack mode
-	float CurrentTime = GetWorld()->GetTimeSeconds();
+	float CurrentTime = UArmaCollisionSubsystem::GetSimTime(GetWorld());
 	if (CurrentTime > NextStateChange)
 	{
 		// Maybe switch to tracing if we're near a wall
@@ -317,7 +318,7 @@ void AArmaAIController::ThinkTrace(FArmaAIThinkData& Data)
 	}
 
 	// Consider changing trace side
-	float CurrentTime = GetWorld()->GetTimeSeconds();
+	float CurrentTime = UArmaCollisionSubsystem::GetSimTime(GetWorld());
 	if (CurrentTime - LastChangeAttempt > 2.0f && TraceSensor.Distance > 50.0f)
 	{
 		LastChangeAttempt = CurrentTime;
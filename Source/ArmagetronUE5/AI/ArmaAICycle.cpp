@@ -1,7 +1,6 @@
 // ArmaAICycle.cpp - AI-controlled lightcycle implementation
 
 #include "ArmaAICycle.h"
-#include "Game/ArmaWallRegistry.h"
 #include "DrawDebugHelpers.h"
 #include "Kismet/GameplayStatics.h"
 
@@ -33,7 +32,9 @@ void AArmaAICycle::BeginPlay()
 	AIThinkInterval = AIThinkInterval / IQFactor;
 	
 	// Set initial think time
-	NextThinkTime = GetWorld()->GetTimeSeconds() + AIThinkInterval;
+	Random.Initialize(FMath::Rand());
+	Bot.Params = MakeBotParams();
+	Bot.Reset(UArmaCollisionSubsystem::GetSimTime(GetWorld()));
 	
 	UE_LOG(LogTemp, Warning, TEXT("AI Cycle spawned: IQ=%d, ReactionTime=%.2f, Color=(%.1f,%.1f,%.1f)"), 
 		AIIQ, ReactionTime, CycleColor.R, CycleColor.G, CycleColor.B);
@@ -41,7 +42,7 @@ void AArmaAICycle::BeginPlay()
 
 void AArmaAICycle::Tick(float DeltaTime)
 {
-	float CurrentTime = GetWorld()->GetTimeSeconds();
+	float CurrentTime = UArmaCollisionSubsystem::GetSimTime(GetWorld());
 	
 	// DEBUG: Log AI position every second
 	static float LastLogTime = 0;
@@ -51,18 +52,18 @@ void AArmaAICycle::Tick(float DeltaTime)
 		UE_LOG(LogTemp, Warning, TEXT("AI TICK: Pos=(%.1f, %.1f, %.1f) Alive=%d Speed=%.1f Dir=(%.2f,%.2f)"),
 			Pos.X, Pos.Y, Pos.Z, bIsAlive, MoveSpeed, MoveDirection.X, MoveDirection.Y);
 		LastLogTime = CurrentTime;
-		
-		// Check if outside bounds
-		const float Boundary = 5000.0f;
-		if (FMath::Abs(Pos.X) > Boundary || FMath::Abs(Pos.Y) > Boundary)
-		{
-			UE_LOG(LogTemp, Error, TEXT("AI OUTSIDE BOUNDARY! Clamping from (%.1f, %.1f)"), Pos.X, Pos.Y);
-			Pos.X = FMath::Clamp(Pos.X, -4900.0f, 4900.0f);
-			Pos.Y = FMath::Clamp(Pos.Y, -4900.0f, 4900.0f);
-			SetActorLocation(Pos);
-		}
 	}
 	
+	// Let parent present the cycle (thinking happens through SimulateStep)
+	Super::Tick(DeltaTime);
+	
+	DrawSensors();
+}
+
+void AArmaAICycle::SimulateStep(float DeltaTime)
+{
+	float CurrentTime = UArmaCollisionSubsystem::GetSimTime(GetWorld());
+	
 	// Check if waiting to respawn
 	if (bWaitingToRespawn)
 	{
@@ -73,8 +74,7 @@ void AArmaAICycle::Tick(float DeltaTime)
 		return;
 	}
 	
-	// Let parent handle movement and collision
-	Super::Tick(DeltaTime);
+	Super::SimulateStep(DeltaTime);
 	
 	// Check if we died
 	if (!bIsAlive && !bWaitingToRespawn)
@@ -85,233 +85,71 @@ void AArmaAICycle::Tick(float DeltaTime)
 		return;
 	}
 	
-	// AI thinking
-	if (CurrentTime >= NextThinkTime && bIsAlive)
+	// AI thinking, and the planned turn once the reaction time has passed
+	if (FArmaSimWorld* Sim = GetSimWorld())
 	{
-		Think();
-		NextThinkTime = CurrentTime + AIThinkInterval;
-	}
-	
-	// Execute pending turn after reaction delay
-	if (PendingTurn != 0 && CurrentTime >= TurnDecisionTime + ReactionTime)
-	{
-		ExecuteTurn(PendingTurn);
-		PendingTurn = 0;
-	}
-}
-
-void AArmaAICycle::Think()
-{
-	// Update sensors
-	UpdateSensors();
-	
-	// State machine (simplified from Armagetron)
-	switch (CurrentState)
-	{
-	case EArmaAIState::Survive:
-		ThinkSurvive();
-		break;
-		
-	case EArmaAIState::Trace:
-		ThinkTrace();
-		break;
-		
-	case EArmaAIState::CloseCombat:
-		// TODO: Implement combat logic
-		ThinkSurvive();
-		break;
-		
-	case EArmaAIState::Path:
-	case EArmaAIState::Route:
-	default:
-		ThinkSurvive();
-		break;
+		Bot.Params = MakeBotParams();
+		Bot.Update(*Sim, SimCycle, Random);
+		SyncFromBot();
 	}
 }
 
-void AArmaAICycle::ThinkSurvive()
+FArmaSimBotParams AArmaAICycle::MakeBotParams() const
 {
-	// Emergency check first - is there a wall very close ahead?
-	if (FrontSensor.bHit && FrontSensor.Distance < EmergencyDistance)
-	{
-		EmergencySurvive();
-		return;
-	}
-	
-	// Proactive avoidance - turn before we get too close
-	float TurnThreshold = MoveSpeed * AIThinkInterval * 3.0f;  // 3 think intervals ahead
-	
-	if (FrontSensor.bHit && FrontSensor.Distance < TurnThreshold)
-	{
-		// Wall ahead, pick the better side
-		int PreferredSide = 0;
-		
-		if (LeftSensor.Distance > RightSensor.Distance)
-		{
-			PreferredSide = -1;  // More room on left
-		}
-		else
-		{
-			PreferredSide = 1;   // More room on right
-		}
-		
-		// Schedule the turn
-		if (PendingTurn == 0)
-		{
-			PendingTurn = PreferredSide;
-			TurnDecisionTime = GetWorld()->GetTimeSeconds();
-		}
-	}
-}
-
-void AArmaAICycle::ThinkTrace()
-{
-	// Trace mode: follow along a wall on one side
-	// From Armagetron: used to grind walls for speed
-	
-	// Emergency check
-	if (FrontSensor.bHit && FrontSensor.Distance < EmergencyDistance)
-	{
-		EmergencySurvive(TraceSide);
-		return;
-	}
-	
-	// Check if we're still near the wall we're tracing
-	FArmaAISensorData& TracedSensor = (TraceSide > 0) ? RightSensor : LeftSensor;
-	
-	if (!TracedSensor.bHit || TracedSensor.Distance > SensorRange * 0.5f)
-	{
-		// Lost the wall, switch to survive
-		CurrentState = EArmaAIState::Survive;
-		return;
-	}
-	
-	// If wall ahead, turn in trace direction
-	if (FrontSensor.bHit && FrontSensor.Distance < MoveSpeed * AIThinkInterval * 5.0f)
-	{
-		if (PendingTurn == 0)
-		{
-			PendingTurn = TraceSide;
-			TurnDecisionTime = GetWorld()->GetTimeSeconds();
-		}
-	}
+	// IQ is already folded into ReactionTime and AIThinkInterval (BeginPlay)
+	FArmaSimBotParams Params;
+	Params.ThinkInterval = AIThinkInterval;
+	Params.SensorRange = SensorRange;
+	Params.EmergencyDistance = EmergencyDistance;
+	Params.ReactionTime = ReactionTime;
+	return Params;
 }
 
-bool AArmaAICycle::EmergencySurvive(int PreferredDirection)
+void AArmaAICycle::SyncFromBot()
 {
-	// Emergency! Pick the safest direction to turn
-	
-	float LeftSpace = LeftSensor.Distance;
-	float RightSpace = RightSensor.Distance;
-	float FrontSpace = FrontSensor.Distance;
-	
-	int TurnDirection = 0;
-	
-	// If one side is clearly better, go that way
-	if (LeftSpace > RightSpace * 1.5f && LeftSpace > FrontSpace)
-	{
-		TurnDirection = -1;
-	}
-	else if (RightSpace > LeftSpace * 1.5f && RightSpace > FrontSpace)
-	{
-		TurnDirection = 1;
-	}
-	else if (PreferredDirection != 0)
-	{
-		// Use the preferred direction if no clear winner
-		TurnDirection = PreferredDirection;
-	}
-	else
-	{
-		// Random choice
-		TurnDirection = (FMath::FRand() > 0.5f) ? 1 : -1;
-	}
-	
-	// Execute immediately in emergency (bypass reaction time)
-	ExecuteTurn(TurnDirection);
-	PendingTurn = 0;
-	
-	return true;
+	const float Z = GetActorLocation().Z;
+	auto ToSensorData = [Z](const FArmaSimBotSensor& Sensor)
+	{
+		FArmaAISensorData Data;
+		Data.Distance = Sensor.Distance;
+		Data.bHit = Sensor.bHit;
+		Data.HitPoint = FVector(Sensor.HitPoint, Z);
+		Data.bIsOwnWall = Sensor.bOwnWall;
+		Data.bIsRim = Sensor.bRim;
+		return Data;
+	};
+	FrontSensor = ToSensorData(Bot.GetFrontSensor());
+	LeftSensor = ToSensorData(Bot.GetLeftSensor());
+	RightSensor = ToSensorData(Bot.GetRightSensor());
+	
+	CurrentState = Bot.GetMode() == FArmaSimBot::EMode::Trace ? EArmaAIState::Trace : EArmaAIState::Survive;
 }
 
-FArmaAISensorData AArmaAICycle::CastSensor(FVector Direction, float Range)
+void AArmaAICycle::DrawSensors()
 {
-	FArmaAISensorData Result;
-	
-	FVector2D MyPos2D(GetActorLocation().X, GetActorLocation().Y);
-	FVector2D Dir2D(Direction.X, Direction.Y);
-	Dir2D.Normalize();
+	if (!bDebugDrawEnabled) return;
 	
-	const float WallGracePeriod = 0.3f;
+	UWorld* World = GetWorld();
+	if (!World) return;
 	
-	// Use global wall registry to check ALL walls (own, other players', and rim walls)
-	UArmaWallRegistry* WallRegistry = UArmaWallRegistry::Get(GetWorld());
-	if (WallRegistry)
-	{
-		FArmaRegisteredWall HitWall;
-		float DummySide = 0.0f;
-		float HitDist = WallRegistry->RaycastWalls(MyPos2D, Dir2D, Range, this, WallGracePeriod, HitWall, DummySide);
-		
-		if (HitDist < MAX_FLT)
-		{
-			Result.Distance = HitDist;
-			Result.bHit = true;
-			FVector2D HitPt = MyPos2D + Dir2D * HitDist;
-			Result.HitPoint = FVector(HitPt.X, HitPt.Y, GetActorLocation().Z);
-			Result.bIsOwnWall = (HitWall.OwnerActor == this);
-			Result.bIsRim = (HitWall.WallType == EArmaWallType::Rim);
-		}
-	}
-	
-	return Result;
-}
-
-void AArmaAICycle::UpdateSensors()
-{
-	// Cast sensors in three directions
+	FVector Start = GetActorLocation();
 	FVector Forward = MoveDirection;
 	FVector Left = FVector(-MoveDirection.Y, MoveDirection.X, 0);
 	FVector Right = FVector(MoveDirection.Y, -MoveDirection.X, 0);
 	
-	FrontSensor = CastSensor(Forward, SensorRange);
-	LeftSensor = CastSensor(Left, SensorRange * 0.5f);
-	RightSensor = CastSensor(Right, SensorRange * 0.5f);
+	// Front - red if close, green if far
+	FColor FrontColor = FrontSensor.bHit ? 
+		(FrontSensor.Distance < EmergencyDistance ? FColor::Red : FColor::Yellow) : FColor::Green;
+	DrawDebugLine(World, Start, Start + Forward * FMath::Min(FrontSensor.Distance, SensorRange), 
+		FrontColor, false, -1.0f, 0, 3.0f);
 	
-	// Debug visualization
-	if (bDebugDrawEnabled)
-	{
-		UWorld* World = GetWorld();
-		if (World)
-		{
-			FVector Start = GetActorLocation();
-			
-			// Front - red if close, green if far
-			FColor FrontColor = FrontSensor.bHit ? 
-				(FrontSensor.Distance < EmergencyDistance ? FColor::Red : FColor::Yellow) : FColor::Green;
-			DrawDebugLine(World, Start, Start + Forward * FMath::Min(FrontSensor.Distance, SensorRange), 
-				FrontColor, false, -1.0f, 0, 3.0f);
-			
-			// Left - cyan
-			DrawDebugLine(World, Start, Start + Left * FMath::Min(LeftSensor.Distance, SensorRange * 0.5f), 
-				FColor::Cyan, false, -1.0f, 0, 2.0f);
-			
-			// Right - magenta
-			DrawDebugLine(World, Start, Start + Right * FMath::Min(RightSensor.Distance, SensorRange * 0.5f), 
-				FColor::Magenta, false, -1.0f, 0, 2.0f);
-		}
-	}
-}
-
-void AArmaAICycle::ExecuteTurn(int Direction)
-{
-	if (Direction < 0)
-	{
-		TurnLeft();
-	}
-	else if (Direction > 0)
-	{
-		TurnRight();
-	}
+	// Left - cyan
+	DrawDebugLine(World, Start, Start + Left * FMath::Min(LeftSensor.Distance, SensorRange * 0.5f), 
+		FColor::Cyan, false, -1.0f, 0, 2.0f);
+	
+	// Right - magenta
+	DrawDebugLine(World, Start, Start + Right * FMath::Min(RightSensor.Distance, SensorRange * 0.5f), 
+		FColor::Magenta, false, -1.0f, 0, 2.0f);
 }
 
 void AArmaAICycle::AIRespawn()
@@ -325,8 +163,7 @@ void AArmaAICycle::AIRespawn()
 	Respawn();
 	
 	// Reset state
-	CurrentState = EArmaAIState::Survive;
-	PendingTurn = 0;
-	NextThinkTime = GetWorld()->GetTimeSeconds() + AIThinkInterval;
+	Bot.Reset(UArmaCollisionSubsystem::GetSimTime(GetWorld()));
+	SyncFromBot();
 }
 
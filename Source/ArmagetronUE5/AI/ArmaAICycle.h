@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "Game/ArmaCyclePawn.h"
 #include "Core/ArmaTypes.h"
+#include "Sim/ArmaSimBot.h"
 #include "ArmaAICycle.generated.h"
 
 // Use EArmaAIState from ArmaTypes.h
@@ -35,6 +36,7 @@ struct FArmaAISensorData
 
 /**
  * AArmaAICycle - AI-controlled cycle based on Armagetron's gAIPlayer
+ * Decisions are made by an FArmaSimBot on the simulation, as in headless matches
  */
 UCLASS()
 class ARMAGETRONUE5_API AArmaAICycle : public AArmaCyclePawn
@@ -46,6 +48,7 @@ public:
 	
 	virtual void BeginPlay() override;
 	virtual void Tick(float DeltaTime) override;
+	virtual void SimulateStep(float DeltaTime) override;
 	
 	// ========== AI Settings ==========
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI")
@@ -85,39 +88,24 @@ public:
 protected:
 	// ========== AI Logic ==========
 	
-	// Main think function - called periodically
-	void Think();
+	// Bot parameters from the AI settings above
+	FArmaSimBotParams MakeBotParams() const;
 	
-	// State-specific think functions (from Armagetron)
-	void ThinkSurvive();
-	void ThinkTrace();
+	// Copy the bot's sensors and state into the properties above
+	void SyncFromBot();
 	
-	// Emergency survival - turn away from imminent collision
-	bool EmergencySurvive(int PreferredDirection = 0);
-	
-	// Cast a sensor in a direction
-	FArmaAISensorData CastSensor(FVector Direction, float Range);
-	
-	// Update all three sensors
-	void UpdateSensors();
-	
-	// Execute a turn decision
-	void ExecuteTurn(int Direction);  // -1 = left, 1 = right, 0 = straight
+	// Draw the three sensors (debug draw)
+	void DrawSensors();
 	
 	// Respawn the AI
 	void AIRespawn();
 	
+	// Survive/Trace decision making, shared with headless matches
+	FArmaSimBot Bot;
+	FRandomStream Random;
+	
 	// ========== AI State Tracking ==========
-	float LastThinkTime = 0.0f;
-	float NextThinkTime = 0.0f;
 	float DeathTime = 0.0f;
 	bool bWaitingToRespawn = false;
-	
-	// Trace state
-	int TraceSide = 1;  // Which side to trace (-1 left, 1 right)
-	
-	// Decision tracking
-	int PendingTurn = 0;
-	float TurnDecisionTime = 0.0f;
 };
 
@@ -3,5 +3,26 @@
 #include "ArmagetronUE5.h"
 #include "Modules/ModuleManager.h"
 
-IMPLEMENT_PRIMARY_GAME_MODULE( FDefaultGameModuleImpl, ArmagetronUE5, "ArmagetronUE5" );
+DEFINE_STAT(STAT_ArmaCollisionPhase);
+DEFINE_STAT(STAT_ArmaSimStep);
+DEFINE_STAT(STAT_ArmaRaycastWalls);
+DEFINE_STAT(STAT_ArmaRaycastWallsBatch);
+DEFINE_STAT(STAT_ArmaRaycastWallsCached);
+DEFINE_STAT(STAT_ArmaFindNearestSideWalls);
+DEFINE_STAT(STAT_ArmaUpdateWallEnd);
+DEFINE_STAT(STAT_ArmaUpdateWallAcceleration);
+DEFINE_STAT(STAT_ArmaUpdateCurrentWall);
+DEFINE_STAT(STAT_ArmaPublishSnapshot);
+
+DEFINE_STAT(STAT_ArmaRaysCast);
+DEFINE_STAT(STAT_ArmaRayHits);
+DEFINE_STAT(STAT_ArmaRayCacheHits);
+DEFINE_STAT(STAT_ArmaWallsTested);
+DEFINE_STAT(STAT_ArmaWallEndUpdates);
+DEFINE_STAT(STAT_ArmaSideWallQueries);
+DEFINE_STAT(STAT_ArmaForwardRaysSkipped);
+DEFINE_STAT(STAT_ArmaHistoryRaysOutOfWindow);
 
+UE_TRACE_CHANNEL_DEFINE(ArmaChannel);
+
+IMPLEMENT_PRIMARY_GAME_MODULE( FDefaultGameModuleImpl, ArmagetronUE5, "ArmagetronUE5" );
@@ -3,4 +3,35 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "Trace/Trace.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
 
+// "stat arma" - time and counts for the collision and wall hot paths
+DECLARE_STATS_GROUP(TEXT("Arma"), STATGROUP_Arma, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Collision Phase"), STAT_ArmaCollisionPhase, STATGROUP_Arma, ARMAGETRONUE5_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Sim Step"), STAT_ArmaSimStep, STATGROUP_Arma, ARMAGETRONUE5_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("RaycastWalls"), STAT_ArmaRaycastWalls, STATGROUP_Arma, ARMAGETRONUE5_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("RaycastWallsBatch"), STAT_ArmaRaycastWallsBatch, STATGROUP_Arma, ARMAGETRONUE5_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("RaycastWallsCached"), STAT_ArmaRaycastWallsCached, STATGROUP_Arma, ARMAGETRONUE5_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("FindNearestSideWalls"), STAT_ArmaFindNearestSideWalls, STATGROUP_Arma, ARMAGETRONUE5_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("UpdateWallEnd"), STAT_ArmaUpdateWallEnd, STATGROUP_Arma, ARMAGETRONUE5_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("UpdateWallAcceleration"), STAT_ArmaUpdateWallAcceleration, STATGROUP_Arma, ARMAGETRONUE5_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("UpdateCurrentWall"), STAT_ArmaUpdateCurrentWall, STATGROUP_Arma, ARMAGETRONUE5_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("PublishSnapshot"), STAT_ArmaPublishSnapshot, STATGROUP_Arma, ARMAGETRONUE5_API);
+
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Rays Cast"), STAT_ArmaRaysCast, STATGROUP_Arma, ARMAGETRONUE5_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Ray Hits"), STAT_ArmaRayHits, STATGROUP_Arma, ARMAGETRONUE5_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Ray Cache Hits"), STAT_ArmaRayCacheHits, STATGROUP_Arma, ARMAGETRONUE5_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Walls Tested"), STAT_ArmaWallsTested, STATGROUP_Arma, ARMAGETRONUE5_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Wall End Updates"), STAT_ArmaWallEndUpdates, STATGROUP_Arma, ARMAGETRONUE5_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Side Wall Queries"), STAT_ArmaSideWallQueries, STATGROUP_Arma, ARMAGETRONUE5_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Forward Rays Skipped"), STAT_ArmaForwardRaysSkipped, STATGROUP_Arma, ARMAGETRONUE5_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("History Rays Out Of Window"), STAT_ArmaHistoryRaysOutOfWindow, STATGROUP_Arma, ARMAGETRONUE5_API);
+
+// Insights channel for the zones above ("-trace=cpu,arma")
+UE_TRACE_CHANNEL_EXTERN(ArmaChannel, ARMAGETRONUE5_API);
+
+// CPU zone on the Arma channel, shown in Insights under the given name
+#define ARMA_TRACE_SCOPE(Name) TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL_STR(Name, ArmaChannel)
@@ -0,0 +1,450 @@
+// ArmaSimulateCommandlet.cpp - Headless bot matches for AI tuning and balance testing
+
+#include "ArmaSimulateCommandlet.h"
+#include "Core/ArmaTypes.h"
+#include "Sim/ArmaSimWorld.h"
+#include "Sim/ArmaSimBot.h"
+#include "Game/ArmaCollisionSubsystem.h"
+#include "Core/ArmaGrid.h"
+#include "Async/ParallelFor.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "UObject/StrongObjectPtr.h"
+#include <atomic>
+
+namespace
+{
+	// Same arena as AArmaTestGameMode
+	const float ArenaHalfSize = 5000.0f;
+	const float SpawnRadius = 3000.0f;
+
+	// Points for destroying another cycle (score_kill)
+	const int32 ScoreKill = 1;
+
+	struct FMatchConfig
+	{
+		FArmaGameSettings Settings;
+		FArmaSimCycleParams CycleParams;
+		FArmaSimBotParams BotParams;
+		int32 NumBots = 8;
+		float StepTime = 1.0f / 120.0f;
+		float MaxRoundTime = 600.0f;
+	};
+
+	enum class EMatchEnd : uint8
+	{
+		Rounds,
+		Time,
+		Score,
+	};
+
+	const TCHAR* LexToString(EMatchEnd End)
+	{
+		switch (End)
+		{
+		case EMatchEnd::Rounds:	return TEXT("Rounds");
+		case EMatchEnd::Time:	return TEXT("Time");
+		case EMatchEnd::Score:	return TEXT("Score");
+		default:				return TEXT("Unknown");
+		}
+	}
+
+	struct FMatchResult
+	{
+		int32 Seed = 0;
+		int32 Rounds = 0;
+		int32 DrawnRounds = 0;		// Nobody left, or still several after MaxRoundTime
+		double SimTime = 0.0;
+		EMatchEnd End = EMatchEnd::Rounds;
+		int32 Winner = INDEX_NONE;	// Highest score, INDEX_NONE on a tie
+		TArray<int32> Scores;
+		TArray<int32> Kills;
+		TArray<int32> Deaths;
+		TArray<int32> RoundWins;
+	};
+
+	// Where bot slot Slot of NumSlots starts a round: on a circle, heading along it
+	void GetSpawn(int32 Slot, int32 NumSlots, FVector2D& OutPosition, FVector2D& OutDirection)
+	{
+		const float Angle = 2.0f * PI * Slot / NumSlots;
+		float Sin, Cos;
+		FMath::SinCos(&Sin, &Cos, Angle);
+		OutPosition = FVector2D(Cos, Sin) * SpawnRadius;
+
+		// Cycles move along the axes: take the axis closest to the tangent
+		const FVector2D Tangent(-Sin, Cos);
+		OutDirection = FMath::Abs(Tangent.X) > FMath::Abs(Tangent.Y)
+			? FVector2D(FMath::Sign(Tangent.X), 0.0)
+			: FVector2D(0.0, FMath::Sign(Tangent.Y));
+	}
+
+	FMatchResult RunMatch(const FMatchConfig& Config, int32 Seed)
+	{
+		const FArmaGameSettings& Settings = Config.Settings;
+		const int32 NumBots = Config.NumBots;
+
+		FMatchResult Result;
+		Result.Seed = Seed;
+		Result.Scores.SetNumZeroed(NumBots);
+		Result.Kills.SetNumZeroed(NumBots);
+		Result.Deaths.SetNumZeroed(NumBots);
+		Result.RoundWins.SetNumZeroed(NumBots);
+
+		FRandomStream Random(Seed);
+		FArmaSimWallList Walls;
+		Walls.AddRim(ArenaHalfSize, ArenaHalfSize);
+		FArmaSimWorld World(Walls);
+
+		TArray<int32> Cycles;
+		TArray<int32> BotByCycle;
+		TArray<FArmaSimBot> Bots;
+		for (int32 Bot = 0; Bot < NumBots; Bot++)
+		{
+			const int32 Cycle = World.AddCycle(Config.CycleParams);
+			Cycles.Add(Cycle);
+			BotByCycle.SetNum(FMath::Max(BotByCycle.Num(), Cycle + 1));
+			BotByCycle[Cycle] = Bot;
+			Bots.AddDefaulted_GetRef().Params = Config.BotParams;
+		}
+
+		// LIMIT_TIME is in minutes of play
+		const double TimeLimit = Settings.LimitTime > 0 ? Settings.LimitTime * 60.0 : MAX_dbl;
+		const int32 LastStanding = NumBots > 1 ? 1 : 0;
+
+		TArray<int32> Slots;
+		for (int32 Bot = 0; Bot < NumBots; Bot++)
+		{
+			Slots.Add(Bot);
+		}
+
+		for (;;)
+		{
+			// ========== ROUND ==========
+			// Everyone respawns with a fresh trail, in a shuffled spawn slot
+			for (int32 i = Slots.Num() - 1; i > 0; i--)
+			{
+				Slots.Swap(i, Random.RandRange(0, i));
+			}
+			for (int32 Bot = 0; Bot < NumBots; Bot++)
+			{
+				FVector2D Position, Direction;
+				GetSpawn(Slots[Bot], NumBots, Position, Direction);
+				World.SpawnCycle(Cycles[Bot], Position, Direction);
+				Bots[Bot].Reset(World.GetTime());
+			}
+
+			const double RoundStart = World.GetTime();
+			int32 NumAlive = NumBots;
+			while (NumAlive > LastStanding && World.GetTime() - RoundStart < Config.MaxRoundTime)
+			{
+				for (int32 Bot = 0; Bot < NumBots; Bot++)
+				{
+					Bots[Bot].Update(World, Cycles[Bot], Random);
+				}
+				World.Step(Config.StepTime);
+
+				for (const FArmaSimEvent& Event : World.GetEvents())
+				{
+					if (Event.Type != FArmaSimEvent::EType::Died)
+					{
+						continue;
+					}
+					NumAlive--;
+					Result.Deaths[BotByCycle[Event.Cycle]]++;
+					if (Event.Killer != INDEX_NONE && Event.Killer != Event.Cycle)
+					{
+						const int32 Killer = BotByCycle[Event.Killer];
+						Result.Kills[Killer]++;
+						Result.Scores[Killer] += ScoreKill;
+					}
+				}
+				World.ClearEvents();
+			}
+			Result.Rounds++;
+
+			// The last one standing wins the round
+			int32 Survivor = INDEX_NONE;
+			if (NumAlive == 1)
+			{
+				for (int32 Bot = 0; Bot < NumBots; Bot++)
+				{
+					if (World.GetCycle(Cycles[Bot]).bAlive)
+					{
+						Survivor = Bot;
+					}
+				}
+			}
+			if (Survivor != INDEX_NONE && NumBots > 1)
+			{
+				Result.RoundWins[Survivor]++;
+				Result.Scores[Survivor] += Settings.ScoreWin;
+			}
+			else
+			{
+				Result.DrawnRounds++;
+			}
+
+			// ========== MATCH LIMITS ==========
+			// Checked between rounds, like gGame
+			int32 Best = MIN_int32;
+			int32 SecondBest = MIN_int32;
+			for (int32 Score : Result.Scores)
+			{
+				if (Score > Best)
+				{
+					SecondBest = Best;
+					Best = Score;
+				}
+				else if (Score > SecondBest)
+				{
+					SecondBest = Score;
+				}
+			}
+			const int32 Lead = NumBots > 1 ? Best - SecondBest : Best;
+
+			if (Settings.LimitScore > 0 && Best >= Settings.LimitScore && Lead >= Settings.LimitScoreMinLead)
+			{
+				Result.End = EMatchEnd::Score;
+				break;
+			}
+			if (Settings.LimitRounds > 0 && Result.Rounds >= Settings.LimitRounds)
+			{
+				Result.End = EMatchEnd::Rounds;
+				break;
+			}
+			if (World.GetTime() >= TimeLimit)
+			{
+				Result.End = EMatchEnd::Time;
+				break;
+			}
+		}
+
+		Result.SimTime = World.GetTime();
+
+		const int32 Best = FMath::Max(Result.Scores);
+		int32 NumBest = 0;
+		for (int32 Bot = 0; Bot < NumBots; Bot++)
+		{
+			if (Result.Scores[Bot] == Best)
+			{
+				Result.Winner = Bot;
+				NumBest++;
+			}
+		}
+		if (NumBest > 1)
+		{
+			Result.Winner = INDEX_NONE;
+		}
+		return Result;
+	}
+
+	// Build a grid like the game's - the rim, then many trail-like walls crossing each
+	// other and a few diagonals - and check its links after every insertion
+	bool RunGridCheck(int32 Seed, int32 NumWalls)
+	{
+		TStrongObjectPtr<UArmaGridSubsystem> Grid(NewObject<UArmaGridSubsystem>());
+		Grid->CreateGrid(ArenaHalfSize * 2.0f + 1000.0f);
+
+		FString Error;
+		auto Check = [&](const TCHAR* Step, int32 Index)
+		{
+			if (Grid->Validate(Error))
+			{
+				return true;
+			}
+			UE_LOG(LogTemp, Error, TEXT("ArmaSimulate: grid check failed after %s %d: %s"), Step, Index, *Error);
+			return false;
+		};
+
+		const FArmaCoord Corners[] = {
+			FArmaCoord(-ArenaHalfSize, -ArenaHalfSize),
+			FArmaCoord(ArenaHalfSize, -ArenaHalfSize),
+			FArmaCoord(ArenaHalfSize, ArenaHalfSize),
+			FArmaCoord(-ArenaHalfSize, ArenaHalfSize),
+		};
+		for (int32 i = 0; i < 4; i++)
+		{
+			if (Grid->InsertWall(Corners[i], Corners[(i + 1) % 4]) < 0 || !Check(TEXT("rim wall"), i))
+			{
+				return false;
+			}
+		}
+
+		FRandomStream Random(Seed);
+		for (int32 i = 0; i < NumWalls; i++)
+		{
+			const FArmaCoord Start(Random.FRandRange(-ArenaHalfSize, ArenaHalfSize), Random.FRandRange(-ArenaHalfSize, ArenaHalfSize));
+			FArmaCoord End(Random.FRandRange(-ArenaHalfSize, ArenaHalfSize), Random.FRandRange(-ArenaHalfSize, ArenaHalfSize));
+			// Mostly axis-aligned, like trails
+			if (i % 8 == 1)
+			{
+				End.X = Start.X;
+			}
+			else if (i % 8 != 0)
+			{
+				End.Y = Start.Y;
+			}
+			if (Grid->InsertWall(Start, End) < 0 || !Check(TEXT("wall"), i))
+			{
+				return false;
+			}
+		}
+
+		UE_LOG(LogTemp, Display, TEXT("ArmaSimulate: grid check passed (%d crossing walls)"), NumWalls);
+		return true;
+	}
+
+	FString MakeCsvHeader(int32 NumBots)
+	{
+		FString Header = TEXT("Match,Seed,Rounds,DrawnRounds,SimSeconds,End,Winner");
+		const TCHAR* Columns[] = { TEXT("Score"), TEXT("Kills"), TEXT("Deaths"), TEXT("Wins") };
+		for (const TCHAR* Column : Columns)
+		{
+			for (int32 Bot = 0; Bot < NumBots; Bot++)
+			{
+				Header += FString::Printf(TEXT(",%s%d"), Column, Bot);
+			}
+		}
+		return Header;
+	}
+
+	FString MakeCsvLine(int32 Match, const FMatchResult& Result)
+	{
+		FString Line = FString::Printf(TEXT("%d,%d,%d,%d,%.3f,%s,%d"),
+			Match, Result.Seed, Result.Rounds, Result.DrawnRounds, Result.SimTime, LexToString(Result.End), Result.Winner);
+		const TArray<int32>* Columns[] = { &Result.Scores, &Result.Kills, &Result.Deaths, &Result.RoundWins };
+		for (const TArray<int32>* Column : Columns)
+		{
+			for (int32 Value : *Column)
+			{
+				Line += FString::Printf(TEXT(",%d"), Value);
+			}
+		}
+		return Line;
+	}
+}
+
+UArmaSimulateCommandlet::UArmaSimulateCommandlet()
+{
+	// Nothing but the simulation is needed
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 UArmaSimulateCommandlet::Main(const FString& Params)
+{
+	const TCHAR* Cmd = *Params;
+
+	int32 NumMatches = 100;
+	int32 NumThreads = FTaskGraphInterface::Get().GetNumWorkerThreads() + 1;
+	int32 Seed = 0;
+	float StepRate = GetDefault<UArmaCollisionSubsystem>()->FixedStepRate;
+
+	FMatchConfig Config;
+	int32 BotIQ = Config.Settings.AI_IQ;
+
+	FParse::Value(Cmd, TEXT("matches="), NumMatches);
+	FParse::Value(Cmd, TEXT("bots="), Config.NumBots);
+	FParse::Value(Cmd, TEXT("threads="), NumThreads);
+	FParse::Value(Cmd, TEXT("seed="), Seed);
+	FParse::Value(Cmd, TEXT("iq="), BotIQ);
+	FParse::Value(Cmd, TEXT("steprate="), StepRate);
+	FParse::Value(Cmd, TEXT("roundtime="), Config.MaxRoundTime);
+	FParse::Value(Cmd, TEXT("rounds="), Config.Settings.LimitRounds);
+	FParse::Value(Cmd, TEXT("timelimit="), Config.Settings.LimitTime);
+	FParse::Value(Cmd, TEXT("scorelimit="), Config.Settings.LimitScore);
+
+	// -gridcheck only checks the collision grid's triangulation, no matches are played
+	if (FParse::Param(Cmd, TEXT("gridcheck")))
+	{
+		int32 NumGridWalls = 500;
+		FParse::Value(Cmd, TEXT("gridwalls="), NumGridWalls);
+		return RunGridCheck(Seed, NumGridWalls) ? 0 : 1;
+	}
+
+	FString OutPath = FPaths::ProjectSavedDir() / TEXT("ArmaSimulate") / (FDateTime::Now().ToString() + TEXT(".csv"));
+	FParse::Value(Cmd, TEXT("out="), OutPath);
+
+	if (NumMatches <= 0 || Config.NumBots <= 0 || StepRate <= 0.0f || Config.MaxRoundTime <= 0.0f)
+	{
+		UE_LOG(LogTemp, Error, TEXT("ArmaSimulate: -matches, -bots, -steprate and -roundtime must be positive"));
+		return 1;
+	}
+	if (Config.Settings.LimitRounds <= 0 && Config.Settings.LimitTime <= 0 && Config.Settings.LimitScore <= 0)
+	{
+		UE_LOG(LogTemp, Error, TEXT("ArmaSimulate: no round, time or score limit - matches would never end"));
+		return 1;
+	}
+
+	NumThreads = FMath::Clamp(NumThreads, 1, NumMatches);
+	Config.StepTime = 1.0f / StepRate;
+	Config.CycleParams.WallsStayUpDelay = Config.Settings.WallsStayUpDelay;
+	Config.BotParams.ApplyIQ(BotIQ);
+
+	UE_LOG(LogTemp, Display, TEXT("ArmaSimulate: %d matches, %d bots (IQ %d), %d threads, %.0f Hz, limits: %d rounds, %d min, %d points"),
+		NumMatches, Config.NumBots, BotIQ, NumThreads, StepRate,
+		Config.Settings.LimitRounds, Config.Settings.LimitTime, Config.Settings.LimitScore);
+
+	// ========== RUN ==========
+	// One task per thread, each pulling the next match until none are left
+	TArray<FMatchResult> Results;
+	Results.SetNum(NumMatches);
+	std::atomic<int32> NextMatch(0);
+	std::atomic<int32> NumDone(0);
+	const int32 ProgressStep = FMath::Max(1, NumMatches / 10);
+
+	const double StartTime = FPlatformTime::Seconds();
+	ParallelFor(NumThreads, [&](int32)
+	{
+		for (int32 Match = NextMatch++; Match < NumMatches; Match = NextMatch++)
+		{
+			Results[Match] = RunMatch(Config, Seed + Match);
+
+			const int32 Done = ++NumDone;
+			if (Done % ProgressStep == 0)
+			{
+				UE_LOG(LogTemp, Display, TEXT("ArmaSimulate: %d / %d matches"), Done, NumMatches);
+			}
+		}
+	}, NumThreads == 1 ? EParallelForFlags::ForceSingleThread : EParallelForFlags::Unbalanced);
+	const double WallSeconds = FPlatformTime::Seconds() - StartTime;
+
+	// ========== RESULTS ==========
+	TArray<FString> Lines;
+	Lines.Reserve(NumMatches + 1);
+	Lines.Add(MakeCsvHeader(Config.NumBots));
+
+	int64 TotalRounds = 0;
+	double TotalSimTime = 0.0;
+	TArray<int32> MatchWins;
+	MatchWins.SetNumZeroed(Config.NumBots);
+	for (int32 Match = 0; Match < NumMatches; Match++)
+	{
+		const FMatchResult& Result = Results[Match];
+		Lines.Add(MakeCsvLine(Match, Result));
+
+		TotalRounds += Result.Rounds;
+		TotalSimTime += Result.SimTime;
+		if (Result.Winner != INDEX_NONE)
+		{
+			MatchWins[Result.Winner]++;
+		}
+	}
+
+	if (!FFileHelper::SaveStringArrayToFile(Lines, *OutPath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("ArmaSimulate: could not write %s"), *OutPath);
+		return 1;
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("ArmaSimulate: %lld rounds, %.0f s simulated in %.1f s (%.0fx real time), results in %s"),
+		TotalRounds, TotalSimTime, WallSeconds, TotalSimTime / FMath::Max(WallSeconds, 0.001), *FPaths::ConvertRelativePathToFull(OutPath));
+	for (int32 Bot = 0; Bot < Config.NumBots; Bot++)
+	{
+		UE_LOG(LogTemp, Display, TEXT("ArmaSimulate: bot %d won %d matches"), Bot, MatchWins[Bot]);
+	}
+	return 0;
+}
@@ -0,0 +1,38 @@
+// ArmaSimulateCommandlet.h - Headless bot matches for AI tuning and balance testing
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "ArmaSimulateCommandlet.generated.h"
+
+/**
+ * UArmaSimulateCommandlet - Plays complete matches between bots, no world, no rendering
+ *
+ *   UnrealEditor-Cmd ArmagetronUE5.uproject -run=ArmaSimulate -matches=10000 -bots=8 -threads=N
+ *
+ * Each match steps its own FArmaSimWorld over an FArmaSimWallList as fast as it can, with
+ * FArmaSimBot driving every cycle, and matches run in parallel on up to -threads workers.
+ * A round ends when one cycle is left; a match ends by the FArmaGameSettings limits
+ * (LimitRounds, LimitTime, LimitScore with LimitScoreMinLead), checked between rounds.
+ * One CSV line per match is written to -out (default Saved/ArmaSimulate/<date>.csv).
+ *
+ * Other options: -seed= (match i plays seed + i, so any match can be replayed), -iq=,
+ * -steprate= (default: the collision subsystem's FixedStepRate), -roundtime= (seconds
+ * before a stalled round is called a draw), and -rounds=, -timelimit= (minutes),
+ * -scorelimit= to override the settings' limits.
+ *
+ * -gridcheck plays no matches: it inserts the rim and -gridwalls= (default 500) crossing
+ * walls into a UArmaGridSubsystem and validates every half-edge, face and point link
+ * after each insertion (UArmaGridSubsystem::Validate); exit code 1 on the first broken one.
+ */
+UCLASS()
+class ARMAGETRONUE5_API UArmaSimulateCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UArmaSimulateCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
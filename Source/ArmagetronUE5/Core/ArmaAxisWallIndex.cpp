@@ -0,0 +1,149 @@
+// ArmaAxisWallIndex.cpp - Sorted interval index implementation
+
+#include "ArmaAxisWallIndex.h"
+#include "Algo/BinarySearch.h"
+
+EArmaAxisAlignment FArmaAxisWallIndex::ClassifySegment(FVector2D Start, FVector2D End)
+{
+	const double DX = FMath::Abs(End.X - Start.X);
+	const double DY = FMath::Abs(End.Y - Start.Y);
+
+	if (DY <= AxisTolerance && DX > AxisTolerance)
+	{
+		return EArmaAxisAlignment::Horizontal;
+	}
+	if (DX <= AxisTolerance && DY > AxisTolerance)
+	{
+		return EArmaAxisAlignment::Vertical;
+	}
+
+	// Degenerate (zero-length) or diagonal
+	return EArmaAxisAlignment::None;
+}
+
+EArmaAxisAlignment FArmaAxisWallIndex::ClassifyRay(FVector2D Direction)
+{
+	// Direction is normalized, so compare the off-axis component directly
+	if (FMath::Abs(Direction.Y) < KINDA_SMALL_NUMBER && FMath::Abs(Direction.X) > 0.5)
+	{
+		return EArmaAxisAlignment::Horizontal;
+	}
+	if (FMath::Abs(Direction.X) < KINDA_SMALL_NUMBER && FMath::Abs(Direction.Y) > 0.5)
+	{
+		return EArmaAxisAlignment::Vertical;
+	}
+	return EArmaAxisAlignment::None;
+}
+
+FArmaAxisWallIndex::FEntry FArmaAxisWallIndex::MakeEntry(int32 Key, EArmaAxisAlignment Axis, FVector2D Start, FVector2D End)
+{
+	// Key the wall by its start: a growing wall keeps its start, so it stays in place
+	FEntry Entry;
+	Entry.Key = Key;
+	if (Axis == EArmaAxisAlignment::Horizontal)
+	{
+		Entry.Coord = Start.Y;
+		Entry.Min = FMath::Min(Start.X, End.X);
+		Entry.Max = FMath::Max(Start.X, End.X);
+	}
+	else
+	{
+		Entry.Coord = Start.X;
+		Entry.Min = FMath::Min(Start.Y, End.Y);
+		Entry.Max = FMath::Max(Start.Y, End.Y);
+	}
+	return Entry;
+}
+
+int32 FArmaAxisWallIndex::LowerBound(const TArray<FEntry>& List, float Value)
+{
+	return Algo::LowerBoundBy(List, Value, &FEntry::Coord);
+}
+
+int32 FArmaAxisWallIndex::FindEntry(const TArray<FEntry>& List, float Coord, int32 Key) const
+{
+	for (int32 i = LowerBound(List, Coord); i < List.Num() && List[i].Coord == Coord; i++)
+	{
+		if (List[i].Key == Key)
+		{
+			return i;
+		}
+	}
+	return INDEX_NONE;
+}
+
+bool FArmaAxisWallIndex::Insert(int32 Key, FVector2D Start, FVector2D End)
+{
+	if (KeyInfo.Contains(Key))
+	{
+		return Update(Key, Start, End);
+	}
+
+	const EArmaAxisAlignment Axis = ClassifySegment(Start, End);
+	if (Axis == EArmaAxisAlignment::None)
+	{
+		return false;
+	}
+
+	const FEntry Entry = MakeEntry(Key, Axis, Start, End);
+	TArray<FEntry>& List = GetList(Axis);
+	List.Insert(Entry, Algo::UpperBoundBy(List, Entry.Coord, &FEntry::Coord));
+
+	FKeyInfo& Info = KeyInfo.Add(Key);
+	Info.Axis = Axis;
+	Info.Coord = Entry.Coord;
+	return true;
+}
+
+bool FArmaAxisWallIndex::Update(int32 Key, FVector2D Start, FVector2D End)
+{
+	FKeyInfo* Info = KeyInfo.Find(Key);
+	if (!Info)
+	{
+		return Insert(Key, Start, End);
+	}
+
+	const EArmaAxisAlignment Axis = ClassifySegment(Start, End);
+	if (Axis == Info->Axis)
+	{
+		const FEntry Entry = MakeEntry(Key, Axis, Start, End);
+		if (Entry.Coord == Info->Coord)
+		{
+			// Growing wall: same line, only the interval changes - update in place
+			TArray<FEntry>& List = GetList(Axis);
+			const int32 Index = FindEntry(List, Info->Coord, Key);
+			if (Index != INDEX_NONE)
+			{
+				List[Index].Min = Entry.Min;
+				List[Index].Max = Entry.Max;
+				return true;
+			}
+		}
+	}
+
+	Remove(Key);
+	return Insert(Key, Start, End);
+}
+
+void FArmaAxisWallIndex::Remove(int32 Key)
+{
+	FKeyInfo Info;
+	if (!KeyInfo.RemoveAndCopyValue(Key, Info))
+	{
+		return;
+	}
+
+	TArray<FEntry>& List = GetList(Info.Axis);
+	const int32 Index = FindEntry(List, Info.Coord, Key);
+	if (Index != INDEX_NONE)
+	{
+		List.RemoveAt(Index, 1, EAllowShrinking::No);
+	}
+}
+
+void FArmaAxisWallIndex::Reset()
+{
+	HorizontalWalls.Reset();
+	VerticalWalls.Reset();
+	KeyInfo.Reset();
+}
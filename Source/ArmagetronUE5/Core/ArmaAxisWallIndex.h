@@ -0,0 +1,153 @@
+// ArmaAxisWallIndex.h - Sorted interval index for axis-aligned walls
+// With FArmaAxis::WindingNumber == 4 every cycle wall is horizontal or vertical,
+// so walls can be kept in two lists sorted by their constant coordinate
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Orientation of a segment or ray relative to the world axes
+ */
+enum class EArmaAxisAlignment : uint8
+{
+	None,			// General direction - use the generic path
+	Horizontal,		// Runs along X (constant Y)
+	Vertical,		// Runs along Y (constant X)
+};
+
+/**
+ * FArmaAxisWallIndex - Horizontal walls bucketed by Y, vertical walls by X
+ * Each list is a sorted vector of intervals, so an axis-aligned ray needs one
+ * binary search into the perpendicular list (walls it can cross, visited in
+ * order of distance) and one into the parallel list (walls it can run along).
+ */
+class ARMAGETRONUE5_API FArmaAxisWallIndex
+{
+public:
+	// Segments/rays are axis-aligned when the off-axis component is below this
+	static constexpr float AxisTolerance = 0.01f;
+
+	static EArmaAxisAlignment ClassifySegment(FVector2D Start, FVector2D End);
+	static EArmaAxisAlignment ClassifyRay(FVector2D Direction);
+
+	// Index a segment; returns false (and stores nothing) if it is not axis-aligned
+	bool Insert(int32 Key, FVector2D Start, FVector2D End);
+
+	// Re-index a segment; returns whether it is indexed afterwards
+	bool Update(int32 Key, FVector2D Start, FVector2D End);
+
+	void Remove(int32 Key);
+	void Reset();
+
+	bool Contains(int32 Key) const { return KeyInfo.Contains(Key); }
+	int32 Num() const { return KeyInfo.Num(); }
+
+	/**
+	 * Emit candidate walls for an axis-aligned ray (Direction normalized, ClassifyRay != None)
+	 * Visitor(int32 Key, float MinDistance) returns true to stop.
+	 * Parallel walls within ParallelTolerance of the ray line come first with MinDistance 0,
+	 * then perpendicular walls in increasing MinDistance (a lower bound of their hit distance).
+	 */
+	template<typename VisitorType>
+	void TraverseRay(FVector2D Origin, FVector2D Direction, float MaxDistance, float ParallelTolerance, VisitorType&& Visitor) const;
+
+private:
+	struct FEntry
+	{
+		float Coord = 0.0f;		// Constant coordinate (Y for horizontal, X for vertical)
+		float Min = 0.0f;		// Interval along the wall
+		float Max = 0.0f;
+		int32 Key = INDEX_NONE;
+	};
+
+	struct FKeyInfo
+	{
+		EArmaAxisAlignment Axis = EArmaAxisAlignment::None;
+		float Coord = 0.0f;
+	};
+
+	static FEntry MakeEntry(int32 Key, EArmaAxisAlignment Axis, FVector2D Start, FVector2D End);
+	TArray<FEntry>& GetList(EArmaAxisAlignment Axis) { return Axis == EArmaAxisAlignment::Horizontal ? HorizontalWalls : VerticalWalls; }
+	const TArray<FEntry>& GetList(EArmaAxisAlignment Axis) const { return Axis == EArmaAxisAlignment::Horizontal ? HorizontalWalls : VerticalWalls; }
+
+	// First entry with Coord >= Value
+	static int32 LowerBound(const TArray<FEntry>& List, float Value);
+	int32 FindEntry(const TArray<FEntry>& List, float Coord, int32 Key) const;
+
+	TArray<FEntry> HorizontalWalls;		// Sorted by Y
+	TArray<FEntry> VerticalWalls;		// Sorted by X
+	TMap<int32, FKeyInfo> KeyInfo;
+};
+
+//////////////////////////////////////////////////////////////////////////
+// Template implementations
+//////////////////////////////////////////////////////////////////////////
+
+template<typename VisitorType>
+void FArmaAxisWallIndex::TraverseRay(FVector2D Origin, FVector2D Direction, float MaxDistance, float ParallelTolerance, VisitorType&& Visitor) const
+{
+	const EArmaAxisAlignment RayAxis = ClassifyRay(Direction);
+	if (RayAxis == EArmaAxisAlignment::None)
+	{
+		return;
+	}
+
+	const bool bAlongX = RayAxis == EArmaAxisAlignment::Horizontal;
+	const float AxisOrigin = bAlongX ? Origin.X : Origin.Y;
+	const float Lateral = bAlongX ? Origin.Y : Origin.X;
+	const float AxisDir = bAlongX ? Direction.X : Direction.Y;
+	const float InvAxisDir = 1.0f / FMath::Abs(AxisDir);
+
+	// The ray drifts sideways by at most this much over its length
+	const float Slack = FMath::Abs(bAlongX ? Direction.Y : Direction.X) * FMath::Min(MaxDistance, 1.0e6f) + AxisTolerance;
+
+	// Parallel walls: same orientation as the ray, constant coordinate near the ray line
+	const TArray<FEntry>& Parallel = GetList(RayAxis);
+	for (int32 i = LowerBound(Parallel, Lateral - ParallelTolerance - Slack); i < Parallel.Num(); i++)
+	{
+		if (Parallel[i].Coord > Lateral + ParallelTolerance + Slack)
+		{
+			break;
+		}
+		if (Visitor(Parallel[i].Key, 0.0f))
+		{
+			return;
+		}
+	}
+
+	// Perpendicular walls: sorted by their crossing coordinate, visited outward from the origin
+	const TArray<FEntry>& Perpendicular = GetList(bAlongX ? EArmaAxisAlignment::Vertical : EArmaAxisAlignment::Horizontal);
+	if (AxisDir > 0.0f)
+	{
+		for (int32 i = LowerBound(Perpendicular, AxisOrigin - AxisTolerance); i < Perpendicular.Num(); i++)
+		{
+			const FEntry& Entry = Perpendicular[i];
+			const float MinDistance = (Entry.Coord - AxisOrigin - AxisTolerance) * InvAxisDir;
+			if (MinDistance >= MaxDistance)
+			{
+				break;
+			}
+			if (Lateral >= Entry.Min - Slack && Lateral <= Entry.Max + Slack && Visitor(Entry.Key, MinDistance))
+			{
+				return;
+			}
+		}
+	}
+	else
+	{
+		for (int32 i = LowerBound(Perpendicular, AxisOrigin + AxisTolerance) - 1; i >= 0; i--)
+		{
+			const FEntry& Entry = Perpendicular[i];
+			const float MinDistance = (AxisOrigin - Entry.Coord - AxisTolerance) * InvAxisDir;
+			if (MinDistance >= MaxDistance)
+			{
+				break;
+			}
+			if (Lateral >= Entry.Min - Slack && Lateral <= Entry.Max + Slack && Visitor(Entry.Key, MinDistance))
+			{
+				return;
+			}
+		}
+	}
+}
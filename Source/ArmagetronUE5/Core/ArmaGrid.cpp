@@ -12,6 +12,70 @@ float AArmaArena::SizeMultiplier = 1.0f;
 // UArmaGridSubsystem Implementation
 //////////////////////////////////////////////////////////////////////////
 
+namespace
+{
+	// Twice the signed area of ABC (> 0 = counter-clockwise), in doubles so large arenas stay exact enough
+	double Orient(const FArmaCoord& A, const FArmaCoord& B, const FArmaCoord& C)
+	{
+		return ((double)B.X - A.X) * ((double)C.Y - A.Y) - ((double)B.Y - A.Y) * ((double)C.X - A.X);
+	}
+
+	// Distance of C from the line through A and B
+	double DistanceFromLine(const FArmaCoord& A, const FArmaCoord& B, const FArmaCoord& C)
+	{
+		const double Length = FMath::Sqrt(((double)B.X - A.X) * ((double)B.X - A.X) + ((double)B.Y - A.Y) * ((double)B.Y - A.Y));
+		return Length > 0.0 ? FMath::Abs(Orient(A, B, C)) / Length : FMath::Sqrt(((double)C.X - A.X) * ((double)C.X - A.X) + ((double)C.Y - A.Y) * ((double)C.Y - A.Y));
+	}
+
+	// Is D strictly inside the circumcircle of the counter-clockwise triangle ABC?
+	// Cocircular points (common with grid-aligned walls) count as outside, so flips can't cycle.
+	bool InCircle(const FArmaCoord& A, const FArmaCoord& B, const FArmaCoord& C, const FArmaCoord& D)
+	{
+		const double ADX = (double)A.X - D.X, ADY = (double)A.Y - D.Y;
+		const double BDX = (double)B.X - D.X, BDY = (double)B.Y - D.Y;
+		const double CDX = (double)C.X - D.X, CDY = (double)C.Y - D.Y;
+		const double AD = ADX * ADX + ADY * ADY;
+		const double BD = BDX * BDX + BDY * BDY;
+		const double CD = CDX * CDX + CDY * CDY;
+		const double Det = AD * (BDX * CDY - CDX * BDY) + BD * (CDX * ADY - ADX * CDY) + CD * (ADX * BDY - BDX * ADY);
+		const double Scale = AD + BD + CD;
+		return Det > 1.0e-10 * Scale * Scale;
+	}
+
+	// Part of segment P1P2 inside the circle, as parameters 0 <= T0 <= T1 <= 1 along it
+	bool ClipSegmentToCircle(const FArmaCoord& P1, const FArmaCoord& P2, const FArmaCoord& Center, float Radius, double& OutT0, double& OutT1)
+	{
+		const double DX = (double)P2.X - P1.X, DY = (double)P2.Y - P1.Y;
+		const double FX = (double)P1.X - Center.X, FY = (double)P1.Y - Center.Y;
+		const double A = DX * DX + DY * DY;
+		const double C = FX * FX + FY * FY - (double)Radius * Radius;
+		if (A <= 0.0)
+		{
+			OutT0 = OutT1 = 0.0;
+			return C <= 0.0;
+		}
+
+		const double HalfB = FX * DX + FY * DY;
+		const double Discriminant = HalfB * HalfB - A * C;
+		if (Discriminant < 0.0)
+			return false;
+
+		const double Root = FMath::Sqrt(Discriminant);
+		OutT0 = FMath::Max((-HalfB - Root) / A, 0.0);
+		OutT1 = FMath::Min((-HalfB + Root) / A, 1.0);
+		return OutT0 <= OutT1;
+	}
+
+	// Where the line AB crosses the line CD (callers make sure they do)
+	FArmaCoord Intersect(const FArmaCoord& A, const FArmaCoord& B, const FArmaCoord& C, const FArmaCoord& D)
+	{
+		const double OA = Orient(C, D, A);
+		const double OB = Orient(C, D, B);
+		const double T = OA / (OA - OB);
+		return FArmaCoord(A.X + (float)(((double)B.X - A.X) * T), A.Y + (float)(((double)B.Y - A.Y) * T));
+	}
+}
+
 UArmaGridSubsystem::UArmaGridSubsystem()
 	: GridSize(ArmaPhysics::DefaultArenaSize)
 {
@@ -34,9 +98,9 @@ void UArmaGridSubsystem::CreateGrid(float Size)
 	ClearGrid();
 	GridSize = Size;
 
-	// Create the initial triangulated grid covering the arena
-	// This is a simplified version - original uses Delaunay triangulation
-	
+	// Start from the arena square split into two triangles; everything else is
+	// inserted incrementally (InsertPoint / DrawLine)
+
 	// Create corner points
 	float HalfSize = Size * 0.5f;
 	int32 P0 = AddPoint(FArmaCoord(-HalfSize, -HalfSize));
@@ -58,20 +122,35 @@ void UArmaGridSubsystem::CreateGrid(float Size)
 	ConnectEdges(E01, E12);
 	ConnectEdges(E12, Edges[E02].TwinID);
 	ConnectEdges(Edges[E02].TwinID, E01);
-	int32 F0 = AddFace(E01);
+	AddFace(E01);
 
 	// Face 2: P0-P2-P3
 	ConnectEdges(E02, E23);
 	ConnectEdges(E23, E30);
 	ConnectEdges(E30, E02);
-	int32 F1 = AddFace(E02);
+	AddFace(E02);
+
+	// Outer boundary: the perimeter twins form a clockwise ring with no face (FaceID -1)
+	ConnectEdges(Edges[E01].TwinID, Edges[E30].TwinID);
+	ConnectEdges(Edges[E30].TwinID, Edges[E23].TwinID);
+	ConnectEdges(Edges[E23].TwinID, Edges[E12].TwinID);
+	ConnectEdges(Edges[E12].TwinID, Edges[E01].TwinID);
 }
 
 void UArmaGridSubsystem::ClearGrid()
 {
-	Points.Empty();
-	Edges.Empty();
-	Faces.Empty();
+	// Keep the allocations - the next round's grid will need about as much
+	Points.Reset();
+	Edges.Reset();
+	Faces.Reset();
+	FreePoints.Reset();
+	FreeEdgePairs.Reset();
+	FreeFaces.Reset();
+	WallTable.Reset();
+	WallIDs.Reset();
+	WallKeys.Reset();
+	WallEdges.Reset();
+	FreeWallIDs.Reset();
 }
 
 int32 UArmaGridSubsystem::FindSurroundingFace(const FArmaCoord& Coord, int32 StartFaceID) const
@@ -81,56 +160,77 @@ int32 UArmaGridSubsystem::FindSurroundingFace(const FArmaCoord& Coord, int32 Sta
 		return -1;
 
 	int32 CurrentFace = (StartFaceID >= 0 && StartFaceID < Faces.Num()) ? StartFaceID : 0;
-
-	// Walk through faces to find containing face
-	// This is a simplified version of the original's walking algorithm
-	const int32 MaxIterations = Faces.Num() * 2;
-	for (int32 i = 0; i < MaxIterations; i++)
+	while (Faces[CurrentFace].EdgeID < 0)
 	{
-		if (IsPointInFace(Coord, CurrentFace))
-			return CurrentFace;
+		// Removed face (e.g. a hint from before a wall was taken out)
+		CurrentFace = (CurrentFace + 1) % Faces.Num();
+	}
+	int32 CameFromEdge = -1;
 
-		// Find which edge to cross
+	// Visibility walk (like eGrid::FindSurroundingFace): cross the edge the point lies
+	// beyond until no such edge is left. Constrained triangulations can make the walk
+	// circle, so it is capped and falls back to testing every face.
+	const int32 MaxSteps = FMath::Max(64, Faces.Num());
+	for (int32 Step = 0; Step < MaxSteps; Step++)
+	{
 		const FArmaGridFace& Face = Faces[CurrentFace];
 		int32 EdgeID = Face.EdgeID;
 		int32 FirstEdge = EdgeID;
-		
-		bool FoundCrossing = false;
+
+		// Leave through the edge the point is furthest beyond (not the one we came in by)
+		int32 ExitEdge = -1;
+		double ExitDistance = 0.0;
 		do
 		{
 			const FArmaGridHalfEdge& Edge = Edges[EdgeID];
-			const FArmaGridPoint& P1 = Points[Edge.PointID];
-			const FArmaGridHalfEdge& NextEdge = Edges[Edge.NextID];
-			const FArmaGridPoint& P2 = Points[NextEdge.PointID];
-
-			// Check if point is on the outside of this edge
-			FArmaCoord EdgeVec = P2.Position - P1.Position;
-			FArmaCoord ToPoint = Coord - P1.Position;
-			
-			if (EdgeVec.Cross(ToPoint) < 0)
+			if (EdgeID != CameFromEdge)
 			{
-				// Cross this edge to adjacent face
-				int32 TwinID = Edge.TwinID;
-				if (TwinID >= 0 && Edges[TwinID].FaceID >= 0)
+				const FArmaCoord& P1 = Points[Edge.PointID].Position;
+				const FArmaCoord& P2 = Points[GetDest(EdgeID)].Position;
+				const double Outside = -Orient(P1, P2, Coord);
+				if (Outside > ExitDistance)
 				{
-					CurrentFace = Edges[TwinID].FaceID;
-					FoundCrossing = true;
-					break;
+					ExitDistance = Outside;
+					ExitEdge = EdgeID;
 				}
 			}
-
 			EdgeID = Edge.NextID;
 		}
-		while (EdgeID != FirstEdge);
+		while (EdgeID != FirstEdge && EdgeID >= 0);
 
-		if (!FoundCrossing)
+		if (ExitEdge < 0)
 		{
-			// Couldn't find crossing, return current best guess
 			return CurrentFace;
 		}
+
+		const int32 TwinID = Edges[ExitEdge].TwinID;
+		if (TwinID < 0 || Edges[TwinID].FaceID < 0)
+		{
+			// Walked off the grid - the point is outside the arena
+			return -1;
+		}
+		CurrentFace = Edges[TwinID].FaceID;
+		CameFromEdge = TwinID;
 	}
 
-	return CurrentFace;
+	for (int32 FaceID = 0; FaceID < Faces.Num(); FaceID++)
+	{
+		if (IsPointInFace(Coord, FaceID))
+		{
+			return FaceID;
+		}
+	}
+	return -1;
+}
+
+int32 UArmaGridSubsystem::FindSurroundingFaceFromHint(const FArmaCoord& Coord, int32& FaceHint) const
+{
+	const int32 FaceID = FindSurroundingFace(Coord, FaceHint);
+	if (FaceID >= 0)
+	{
+		FaceHint = FaceID;
+	}
+	return FaceID;
 }
 
 int32 UArmaGridSubsystem::DrawLine(int32 StartPointID, const FArmaCoord& End, AArmaWall* Wall)
@@ -138,68 +238,465 @@ int32 UArmaGridSubsystem::DrawLine(int32 StartPointID, const FArmaCoord& End, AA
 	if (!Points.IsValidIndex(StartPointID))
 		return -1;
 
-	// Insert end point
-	int32 EndPointID = InsertPoint(End);
-	if (EndPointID < 0)
-		return -1;
-
-	// Create edge between start and end
-	int32 NewEdgeID = AddEdgePair(StartPointID, EndPointID);
-
-	// Associate wall with edge
-	if (Wall && Edges.IsValidIndex(NewEdgeID))
+	// Insert end point, starting the search next to the start point
+	int32 HintFace = -1;
+	TArray<int32, TInlineAllocator<16>> StartEdges;
+	GetOutgoingEdges(StartPointID, StartEdges);
+	for (int32 EdgeID : StartEdges)
 	{
-		Edges[NewEdgeID].Wall = Wall;
-		if (Edges[NewEdgeID].TwinID >= 0)
+		if (Edges[EdgeID].FaceID >= 0)
 		{
-			Edges[Edges[NewEdgeID].TwinID].Wall = Wall;
+			HintFace = Edges[EdgeID].FaceID;
+			break;
 		}
 	}
+	int32 EndPointID = InsertPoint(End, HintFace);
+	if (EndPointID < 0)
+		return -1;
 
-	// TODO: Full implementation would split existing edges and update face connectivity
-	// This simplified version just adds the edge without proper triangulation
+	// Force the segment into the triangulation and mark it as a wall
+	if (EndPointID != StartPointID)
+	{
+		InsertConstraint(StartPointID, EndPointID, Wall);
+	}
 
 	return EndPointID;
 }
 
+int32 UArmaGridSubsystem::InsertWall(const FArmaCoord& Start, const FArmaCoord& End, AArmaWall* Wall)
+{
+	const int32 StartPointID = InsertPoint(Start);
+	if (StartPointID < 0)
+		return -1;
+
+	return DrawLine(StartPointID, End, Wall);
+}
+
 int32 UArmaGridSubsystem::InsertPoint(const FArmaCoord& Coord, int32 GuessFaceID)
 {
 	// Find containing face
 	int32 FaceID = FindSurroundingFace(Coord, GuessFaceID);
-	
-	// Add the point
+	if (FaceID < 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("ArmaGrid: Point (%.1f, %.1f) is outside the grid"), Coord.X, Coord.Y);
+		return -1;
+	}
+
+	// Reuse a point we already have at (almost) the same spot
+	int32 EdgeID = Faces[FaceID].EdgeID;
+	for (int32 i = 0; i < 3; i++)
+	{
+		const int32 PointID = Edges[EdgeID].PointID;
+		if ((Points[PointID].Position - Coord).NormSquared() <= PointMergeDistance * PointMergeDistance)
+		{
+			return PointID;
+		}
+		EdgeID = Edges[EdgeID].NextID;
+	}
+
+	// Add the point, splitting the edge it lies on or else the face it lies in
 	int32 NewPointID = AddPoint(Coord);
+	TArray<int32, TInlineAllocator<8>> LinkEdges;
+	const int32 OnEdge = FindEdgeForPoint(Coord, FaceID);
+	if (OnEdge >= 0)
+	{
+		SplitEdge(OnEdge, NewPointID, LinkEdges);
+	}
+	else
+	{
+		SplitFace(FaceID, NewPointID, LinkEdges);
+	}
 
-	// TODO: Full implementation would split face into triangles around new point
-	// This is a simplified version
+	// Lawson flips restore the (constrained) Delaunay property around the new point
+	TArray<int32> Pending(LinkEdges);
+	LegalizeEdges(Pending);
 
 	return NewPointID;
 }
 
-void UArmaGridSubsystem::ProcessWallsInRange(const FArmaCoord& Pos, float Range, TFunctionRef<void(AArmaWall*)> Processor)
+void UArmaGridSubsystem::InsertConstraint(int32 StartPointID, int32 EndPointID, AArmaWall* Wall)
 {
-	float RangeSq = Range * Range;
-
-	for (const FArmaGridHalfEdge& Edge : Edges)
+	TArray<int32> Touched;
+	TArray<int32, TInlineAllocator<16>> OutEdges;
+	const int32 WallID = Wall ? GetWallID(Wall) : -1;
+	int32 Current = StartPointID;
+
+	// Walk from the start towards the end. Each step either follows an edge lying on the
+	// segment, flips away an unconstrained edge crossing it, or - where the crossing edge is
+	// another wall (or can't be flipped) - splits that edge at the crossing.
+	const int32 MaxSteps = 4 * Edges.Num() + 16;
+	for (int32 Step = 0; Step < MaxSteps && Current != EndPointID; Step++)
 	{
-		if (Edge.Wall.IsValid())
+		const FArmaCoord A = Points[Current].Position;
+		const FArmaCoord B = Points[EndPointID].Position;
+		const double SegmentLengthSq = (B - A).NormSquared();
+
+		bool bProgressed = false;
+		GetOutgoingEdges(Current, OutEdges);
+		for (int32 EdgeID : OutEdges)
 		{
-			// Check if edge is within range (simplified - checks midpoint)
-			if (Edge.PointID >= 0 && Edge.TwinID >= 0)
+			const int32 C = GetDest(EdgeID);
+			const FArmaCoord PC = Points[C].Position;
+
+			// The edge runs along the segment: it becomes (part of) the wall
+			if (C == EndPointID || (DistanceFromLine(A, B, PC) <= PointMergeDistance
+				&& (PC - A).Dot(B - A) > 0.0f && (PC - A).NormSquared() < SegmentLengthSq))
+			{
+				MarkWallEdge(EdgeID, WallID);
+				Current = C;
+				bProgressed = true;
+				break;
+			}
+
+			// Otherwise find the triangle at Current whose wedge the segment leaves through
+			if (Edges[EdgeID].FaceID < 0)
+				continue;
+
+			const int32 Opposite = Edges[EdgeID].NextID;
+			const FArmaCoord PD = Points[GetDest(Opposite)].Position;
+			if (Orient(A, PC, B) <= 0.0 || Orient(A, B, PD) <= 0.0)
+				continue;
+
+			const int32 OppositeTwin = Edges[Opposite].TwinID;
+			bool bFlipped = false;
+			if (!IsConstrained(Opposite) && Edges[OppositeTwin].FaceID >= 0)
 			{
-				const FArmaGridHalfEdge& Twin = Edges[Edge.TwinID];
-				if (Points.IsValidIndex(Edge.PointID) && Points.IsValidIndex(Twin.PointID))
+				bFlipped = FlipEdge(Opposite);
+				if (bFlipped)
 				{
-					FArmaCoord P1 = Points[Edge.PointID].Position;
-					FArmaCoord P2 = Points[Twin.PointID].Position;
-					FArmaCoord Mid = (P1 + P2) * 0.5f;
-					
-					if ((Mid - Pos).NormSquared() < RangeSq)
-					{
-						Processor(Edge.Wall.Get());
-					}
+					// The flipped edge and its quad are rechecked once the wall is in
+					Touched.Add(Opposite);
+					Touched.Add(Edges[Opposite].NextID);
+					Touched.Add(Edges[Opposite].PrevID);
+					Touched.Add(Edges[OppositeTwin].NextID);
+					Touched.Add(Edges[OppositeTwin].PrevID);
 				}
 			}
+			if (!bFlipped)
+			{
+				const int32 CrossPoint = AddPoint(Intersect(A, B, PC, PD));
+				TArray<int32, TInlineAllocator<8>> LinkEdges;
+				SplitEdge(Opposite, CrossPoint, LinkEdges);
+				Touched.Append(LinkEdges);
+			}
+			bProgressed = true;
+			break;
+		}
+
+		if (!bProgressed)
+		{
+			UE_LOG(LogTemp, Error, TEXT("ArmaGrid: Could not insert wall from point %d to %d"), StartPointID, EndPointID);
+			break;
+		}
+	}
+
+	LegalizeEdges(Touched);
+}
+
+void UArmaGridSubsystem::RemoveWall(AArmaWall* Wall)
+{
+	// Release the wall's edges; the points only it needed go too, so a long game's
+	// grid stays the size of its current walls
+	TArray<int32, TInlineAllocator<16>> RemovedIDs;
+	if (Wall)
+	{
+		const int32* Found = WallIDs.Find(TObjectKey<AArmaWall>(Wall));
+		if (!Found)
+			return;
+		RemovedIDs.Add(*Found);
+	}
+	else
+	{
+		for (int32 ID = 0; ID < WallTable.Num(); ID++)
+		{
+			if (WallKeys[ID] != TObjectKey<AArmaWall>() && !IsValid(WallTable[ID]))
+			{
+				RemovedIDs.Add(ID);
+			}
+		}
+	}
+
+	// Only the wall's own edge list is visited; entries another wall took over since are skipped
+	TArray<int32> Pending;
+	TArray<int32, TInlineAllocator<64>> Candidates;
+	for (int32 WallID : RemovedIDs)
+	{
+		for (int32 EdgeID : WallEdges[WallID])
+		{
+			FArmaGridHalfEdge& Edge = Edges[EdgeID];
+			if (Edge.PointID < 0 || !Edge.bConstrained || Edge.WallID != WallID)
+				continue;
+
+			FArmaGridHalfEdge& Twin = Edges[Edge.TwinID];
+			Edge.WallID = -1;
+			Twin.WallID = -1;
+			Edge.bConstrained = false;
+			Twin.bConstrained = false;
+			Pending.Add(EdgeID);
+			Candidates.AddUnique(Edge.PointID);
+			Candidates.AddUnique(Twin.PointID);
+		}
+	}
+
+	for (int32 PointID : Candidates)
+	{
+		RemovePoint(PointID, Pending);
+	}
+
+	// Hand the table slots back
+	for (int32 WallID : RemovedIDs)
+	{
+		ReleaseWallID(WallID);
+	}
+
+	// Removal leaves freed IDs in Pending; only live, unconstrained edges get flipped
+	Pending.RemoveAllSwap([this](int32 EdgeID) { return Edges[EdgeID].PointID < 0; }, EAllowShrinking::No);
+	LegalizeEdges(Pending);
+}
+
+bool UArmaGridSubsystem::NeedsCompaction() const
+{
+	const int32 NumFree = FreePoints.Num() + FreeEdgePairs.Num() * 2 + FreeFaces.Num();
+	const int32 NumTotal = Points.Num() + Edges.Num() + Faces.Num();
+	return NumFree > 256 && NumFree * 4 > NumTotal;
+}
+
+bool UArmaGridSubsystem::Validate(FString& OutError) const
+{
+	for (const FArmaGridPoint& Point : Points)
+	{
+		if (Point.ID < 0)
+			continue;
+		if (!Edges.IsValidIndex(Point.EdgeID) || Edges[Point.EdgeID].PointID != Point.ID)
+		{
+			OutError = FString::Printf(TEXT("point %d: edge %d doesn't start at it"), Point.ID, Point.EdgeID);
+			return false;
+		}
+	}
+
+	for (const FArmaGridHalfEdge& Edge : Edges)
+	{
+		if (Edge.PointID < 0)
+			continue;
+
+		const int32 ID = Edge.ID;
+		if (!Points.IsValidIndex(Edge.PointID) || Points[Edge.PointID].ID < 0)
+		{
+			OutError = FString::Printf(TEXT("edge %d: origin %d is not a live point"), ID, Edge.PointID);
+			return false;
+		}
+		if (Edge.TwinID != (ID ^ 1) || Edges[Edge.TwinID].TwinID != ID || Edges[Edge.TwinID].PointID < 0)
+		{
+			OutError = FString::Printf(TEXT("edge %d: twin %d doesn't pair back"), ID, Edge.TwinID);
+			return false;
+		}
+		if (Edges[Edge.TwinID].WallID != Edge.WallID || Edges[Edge.TwinID].bConstrained != Edge.bConstrained)
+		{
+			OutError = FString::Printf(TEXT("edge %d: twin %d carries another wall"), ID, Edge.TwinID);
+			return false;
+		}
+		if (!Edges.IsValidIndex(Edge.NextID) || !Edges.IsValidIndex(Edge.PrevID)
+			|| Edges[Edge.NextID].PrevID != ID || Edges[Edge.PrevID].NextID != ID)
+		{
+			OutError = FString::Printf(TEXT("edge %d: next %d / prev %d don't link back"), ID, Edge.NextID, Edge.PrevID);
+			return false;
+		}
+		if (Edges[Edge.NextID].PointID != GetDest(ID))
+		{
+			OutError = FString::Printf(TEXT("edge %d: next %d doesn't start where it ends"), ID, Edge.NextID);
+			return false;
+		}
+		if (Edges[Edge.NextID].FaceID != Edge.FaceID)
+		{
+			OutError = FString::Printf(TEXT("edge %d: next %d borders another face"), ID, Edge.NextID);
+			return false;
+		}
+	}
+
+	for (const FArmaGridFace& Face : Faces)
+	{
+		if (Face.EdgeID < 0)
+			continue;
+
+		const int32 E0 = Face.EdgeID;
+		if (!Edges.IsValidIndex(E0) || Edges[E0].FaceID != Face.ID)
+		{
+			OutError = FString::Printf(TEXT("face %d: edge %d doesn't border it"), Face.ID, E0);
+			return false;
+		}
+		const int32 E1 = Edges[E0].NextID;
+		const int32 E2 = Edges[E1].NextID;
+		if (Edges[E2].NextID != E0)
+		{
+			OutError = FString::Printf(TEXT("face %d: not a triangle"), Face.ID);
+			return false;
+		}
+		if (Orient(Points[Edges[E0].PointID].Position, Points[Edges[E1].PointID].Position, Points[Edges[E2].PointID].Position) <= 0.0)
+		{
+			OutError = FString::Printf(TEXT("face %d: not counter-clockwise"), Face.ID);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void UArmaGridSubsystem::Compact()
+{
+	if (FreePoints.Num() == 0 && FreeEdgePairs.Num() == 0 && FreeFaces.Num() == 0)
+		return;
+
+	// New ID of every live entry, keeping their order; removed ones map to -1
+	auto BuildRemap = [](int32 Num, auto&& IsLive, TArray<int32>& OutRemap)
+	{
+		OutRemap.SetNumUninitialized(Num);
+		int32 NumLive = 0;
+		for (int32 i = 0; i < Num; i++)
+		{
+			OutRemap[i] = IsLive(i) ? NumLive++ : -1;
+		}
+		return NumLive;
+	};
+
+	TArray<int32> PointRemap;
+	TArray<int32> EdgeRemap;
+	TArray<int32> FaceRemap;
+	const int32 NumPoints = BuildRemap(Points.Num(), [this](int32 i) { return Points[i].ID >= 0; }, PointRemap);
+	const int32 NumEdges = BuildRemap(Edges.Num(), [this](int32 i) { return Edges[i].PointID >= 0; }, EdgeRemap);
+	const int32 NumFaces = BuildRemap(Faces.Num(), [this](int32 i) { return Faces[i].EdgeID >= 0; }, FaceRemap);
+
+	auto Remap = [](const TArray<int32>& Table, int32 ID) { return ID >= 0 ? Table[ID] : -1; };
+
+	for (int32 i = 0; i < Points.Num(); i++)
+	{
+		if (PointRemap[i] < 0)
+			continue;
+		FArmaGridPoint& Point = Points[PointRemap[i]];
+		Point = Points[i];
+		Point.ID = PointRemap[i];
+		Point.EdgeID = Remap(EdgeRemap, Point.EdgeID);
+	}
+	for (int32 i = 0; i < Edges.Num(); i++)
+	{
+		if (EdgeRemap[i] < 0)
+			continue;
+		FArmaGridHalfEdge& Edge = Edges[EdgeRemap[i]];
+		Edge = Edges[i];
+		Edge.ID = EdgeRemap[i];
+		Edge.PointID = Remap(PointRemap, Edge.PointID);
+		Edge.TwinID = Remap(EdgeRemap, Edge.TwinID);
+		Edge.NextID = Remap(EdgeRemap, Edge.NextID);
+		Edge.PrevID = Remap(EdgeRemap, Edge.PrevID);
+		Edge.FaceID = Remap(FaceRemap, Edge.FaceID);
+	}
+	for (int32 i = 0; i < Faces.Num(); i++)
+	{
+		if (FaceRemap[i] < 0)
+			continue;
+		FArmaGridFace& Face = Faces[FaceRemap[i]];
+		Face = Faces[i];
+		Face.ID = FaceRemap[i];
+		Face.EdgeID = Remap(EdgeRemap, Face.EdgeID);
+	}
+
+	for (TArray<int32>& WallEdgeList : WallEdges)
+	{
+		for (int32& EdgeID : WallEdgeList)
+		{
+			EdgeID = EdgeRemap[EdgeID];
+		}
+		WallEdgeList.RemoveAllSwap([](int32 EdgeID) { return EdgeID < 0; }, EAllowShrinking::No);
+	}
+
+	Points.SetNum(NumPoints, EAllowShrinking::Yes);
+	Edges.SetNum(NumEdges, EAllowShrinking::Yes);
+	Faces.SetNum(NumFaces, EAllowShrinking::Yes);
+	FreePoints.Empty();
+	FreeEdgePairs.Empty();
+	FreeFaces.Empty();
+}
+
+void UArmaGridSubsystem::ProcessWallsInRange(const FArmaCoord& Pos, float Range, TFunctionRef<void(AArmaWall* Wall, float BeginDist, float EndDist)> Processor)
+{
+	int32 StartFace = FindSurroundingFace(Pos);
+	if (StartFace < 0 || Range <= 0.0f)
+		return;
+
+	struct FWallInRange
+	{
+		int32 WallID;
+		float BeginDist;
+		float EndDist;
+	};
+	TArray<FWallInRange, TInlineAllocator<16>> Found;
+
+	// Flood the faces the circle overlaps: a face is only entered through an edge that
+	// crosses the circle, so the walk stays local however large the grid is
+	TBitArray<> FaceVisited(false, Faces.Num());
+	TBitArray<> EdgeTested(false, Edges.Num() / 2);
+	TArray<int32, TInlineAllocator<32>> Stack;
+	Stack.Add(StartFace);
+	FaceVisited[StartFace] = true;
+
+	while (Stack.Num() > 0)
+	{
+		const int32 FaceID = Stack.Pop(EAllowShrinking::No);
+		int32 EdgeID = Faces[FaceID].EdgeID;
+		for (int32 i = 0; i < 3; i++, EdgeID = Edges[EdgeID].NextID)
+		{
+			if (EdgeTested[EdgeID / 2])
+				continue;
+			EdgeTested[EdgeID / 2] = true;
+
+			const FArmaCoord& P1 = Points[Edges[EdgeID].PointID].Position;
+			const FArmaCoord& P2 = Points[GetDest(EdgeID)].Position;
+			double T0, T1;
+			if (!ClipSegmentToCircle(P1, P2, Pos, Range, T0, T1))
+				continue;
+
+			const int32 TwinFace = Edges[Edges[EdgeID].TwinID].FaceID;
+			if (TwinFace >= 0 && !FaceVisited[TwinFace])
+			{
+				FaceVisited[TwinFace] = true;
+				Stack.Add(TwinFace);
+			}
+
+			AArmaWall* Wall = GetEdgeWall(EdgeID);
+			if (!Wall)
+				continue;
+
+			// Where the clipped piece lies along the wall, in the wall's own distances
+			const FArmaCoord WallBegin = Wall->GetBeginPoint();
+			const FArmaCoord WallAlong = Wall->GetEndPoint() - WallBegin;
+			const float WallLengthSq = WallAlong.NormSquared();
+			auto ToWallDist = [&](double T)
+			{
+				const FArmaCoord Point = P1 + (P2 - P1) * (float)T;
+				const float Alpha = WallLengthSq > 0.0f ? (Point - WallBegin).Dot(WallAlong) / WallLengthSq : 0.0f;
+				return Wall->GetPosAtAlpha(Alpha);
+			};
+			const float DistA = ToWallDist(T0);
+			const float DistB = ToWallDist(T1);
+
+			// A wall is straight and the circle convex, so its pieces merge into one interval
+			const int32 WallID = Edges[EdgeID].WallID;
+			FWallInRange* Entry = Found.FindByPredicate([WallID](const FWallInRange& Other) { return Other.WallID == WallID; });
+			if (!Entry)
+			{
+				Entry = &Found.Add_GetRef({ WallID, MAX_FLT, -MAX_FLT });
+			}
+			Entry->BeginDist = FMath::Min(Entry->BeginDist, FMath::Min(DistA, DistB));
+			Entry->EndDist = FMath::Max(Entry->EndDist, FMath::Max(DistA, DistB));
+		}
+	}
+
+	// Report after the walk, so the processor may change the walls (e.g. blow holes)
+	for (const FWallInRange& Entry : Found)
+	{
+		AArmaWall* Wall = WallTable[Entry.WallID];
+		if (IsValid(Wall))
+		{
+			Processor(Wall, Entry.BeginDist, Entry.EndDist);
 		}
 	}
 }
@@ -252,70 +749,120 @@ bool UArmaGridSubsystem::IsPointInFace(const FArmaCoord& Point, int32 FaceID) co
 }
 
 bool UArmaGridSubsystem::RayCast(const FArmaCoord& Start, const FArmaCoord& End, FArmaCoord& HitPoint, AArmaWall*& HitWall) const
+{
+	int32 FaceHint = -1;
+	return RayCast(Start, End, HitPoint, HitWall, FaceHint);
+}
+
+bool UArmaGridSubsystem::RayCast(const FArmaCoord& Start, const FArmaCoord& End, FArmaCoord& HitPoint, AArmaWall*& HitWall, int32& FaceHint) const
 {
 	HitWall = nullptr;
-	float BestT = FLT_MAX;
-	bool bHit = false;
 
-	FArmaCoord RayDir = End - Start;
-	float RayLength = RayDir.Norm();
-	if (RayLength < KINDA_SMALL_NUMBER)
+	if ((End - Start).NormSquared() < KINDA_SMALL_NUMBER * KINDA_SMALL_NUMBER)
 		return false;
 
-	FArmaCoord RayDirNorm = RayDir / RayLength;
+	int32 FaceID = FindSurroundingFaceFromHint(Start, FaceHint);
+	if (FaceID < 0)
+		return false;
 
-	for (const FArmaGridHalfEdge& Edge : Edges)
+	// A ray starting on a vertex (a cycle on the end of its own wall) leaves through that vertex's fan
+	int32 PivotPointID = -1;
+	int32 EdgeID = Faces[FaceID].EdgeID;
+	for (int32 i = 0; i < 3; i++)
 	{
-		if (!Edge.Wall.IsValid())
-			continue;
-
-		if (Edge.PointID < 0 || Edge.TwinID < 0)
-			continue;
-
-		const FArmaGridHalfEdge& Twin = Edges[Edge.TwinID];
-		if (!Points.IsValidIndex(Edge.PointID) || !Points.IsValidIndex(Twin.PointID))
-			continue;
-
-		FArmaCoord P1 = Points[Edge.PointID].Position;
-		FArmaCoord P2 = Points[Twin.PointID].Position;
+		const int32 PointID = Edges[EdgeID].PointID;
+		if ((Points[PointID].Position - Start).NormSquared() <= PointMergeDistance * PointMergeDistance)
+		{
+			PivotPointID = PointID;
+			FaceID = FindFaceTowards(PointID, End);
+			break;
+		}
+		EdgeID = Edges[EdgeID].NextID;
+	}
 
-		// Ray-segment intersection
-		FArmaCoord SegDir = P2 - P1;
-		float Cross = RayDirNorm.Cross(SegDir);
+	// Walk from face to face along the ray. Each step leaves through the edge whose tail
+	// is right of (or on) the ray and whose head is left of (or on) it; if End isn't beyond
+	// that edge the ray ends in this face. Where the ray runs exactly through a vertex the
+	// walk jumps to the face on the far side of it, skipping the edges around the vertex.
+	int32 EntryEdge = -1;
+	const int32 MaxSteps = Faces.Num() + 16;
+	for (int32 Step = 0; Step < MaxSteps && FaceID >= 0; Step++)
+	{
+		int32 ExitEdge = -1;
+		EdgeID = Faces[FaceID].EdgeID;
+		for (int32 i = 0; i < 3; i++)
+		{
+			const FArmaGridHalfEdge& Edge = Edges[EdgeID];
+			const int32 Dest = GetDest(EdgeID);
+			if (EdgeID != EntryEdge && Edge.PointID != PivotPointID && Dest != PivotPointID
+				&& Orient(Start, End, Points[Edge.PointID].Position) <= 0.0
+				&& Orient(Start, End, Points[Dest].Position) >= 0.0)
+			{
+				ExitEdge = EdgeID;
+				break;
+			}
+			EdgeID = Edge.NextID;
+		}
 
-		if (FMath::Abs(Cross) < KINDA_SMALL_NUMBER)
-			continue;  // Parallel
+		if (ExitEdge < 0)
+			break;
 
-		FArmaCoord StartToP1 = P1 - Start;
-		float T = StartToP1.Cross(SegDir) / Cross;
-		float U = StartToP1.Cross(RayDirNorm) / Cross;
+		const int32 Tail = Edges[ExitEdge].PointID;
+		const int32 Head = GetDest(ExitEdge);
+		const FArmaCoord& P1 = Points[Tail].Position;
+		const FArmaCoord& P2 = Points[Head].Position;
+		if (Orient(P1, P2, End) >= 0.0)
+		{
+			// The ray ends inside this face
+			return false;
+		}
 
-		if (T >= 0 && T <= RayLength && U >= 0 && U <= 1.0f)
+		const int32 OnRay = Orient(Start, End, P1) == 0.0 ? Tail : (Orient(Start, End, P2) == 0.0 ? Head : -1);
+		if (OnRay >= 0)
 		{
-			if (T < BestT)
+			if (WallCrossesRayAt(OnRay, Start, End, HitWall))
 			{
-				BestT = T;
-				HitPoint = Start + RayDirNorm * T;
-				HitWall = Edge.Wall.Get();
-				bHit = true;
+				HitPoint = Points[OnRay].Position;
+				return true;
 			}
+			PivotPointID = OnRay;
+			FaceID = FindFaceTowards(OnRay, End);
+			EntryEdge = -1;
+			continue;
+		}
+
+		if (AArmaWall* Wall = GetEdgeWall(ExitEdge))
+		{
+			HitPoint = Intersect(Start, End, P1, P2);
+			HitWall = Wall;
+			return true;
+		}
+
+		EntryEdge = Edges[ExitEdge].TwinID;
+		FaceID = Edges[EntryEdge].FaceID;
+		if (FaceID < 0)
+		{
+			// Left the arena without hitting anything
+			return false;
 		}
 	}
 
-	return bHit;
+	// Degenerate geometry the walk couldn't get past
+	return RayCastAllEdges(Start, End, HitPoint, HitWall);
 }
 
 int32 UArmaGridSubsystem::AddPoint(const FArmaCoord& Coord)
 {
-	int32 NewID = Points.Num();
-	FArmaGridPoint NewPoint(NewID, Coord);
-	Points.Add(NewPoint);
+	// Reuse a removed point's slot before growing
+	int32 NewID = FreePoints.Num() > 0 ? FreePoints.Pop(EAllowShrinking::No) : Points.AddDefaulted();
+	Points[NewID] = FArmaGridPoint(NewID, Coord);
 	return NewID;
 }
 
 int32 UArmaGridSubsystem::AddEdgePair(int32 Point1ID, int32 Point2ID)
 {
-	int32 Edge1ID = Edges.Num();
+	// Twins always occupy an even/odd pair of slots, so they are freed and reused together
+	int32 Edge1ID = FreeEdgePairs.Num() > 0 ? FreeEdgePairs.Pop(EAllowShrinking::No) : Edges.AddDefaulted(2);
 	int32 Edge2ID = Edge1ID + 1;
 
 	FArmaGridHalfEdge Edge1;
@@ -328,57 +875,417 @@ int32 UArmaGridSubsystem::AddEdgePair(int32 Point1ID, int32 Point2ID)
 	Edge2.PointID = Point2ID;
 	Edge2.TwinID = Edge1ID;
 
-	Edges.Add(Edge1);
-	Edges.Add(Edge2);
+	Edges[Edge1ID] = Edge1;
+	Edges[Edge2ID] = Edge2;
 
-	// Add edges to point lists
-	if (Points.IsValidIndex(Point1ID))
-		Points[Point1ID].EdgeIDs.Add(Edge1ID);
-	if (Points.IsValidIndex(Point2ID))
-		Points[Point2ID].EdgeIDs.Add(Edge2ID);
+	// A point only needs one outgoing edge; the rest of its fan is found by rotation
+	if (Points.IsValidIndex(Point1ID) && Points[Point1ID].EdgeID < 0)
+		Points[Point1ID].EdgeID = Edge1ID;
+	if (Points.IsValidIndex(Point2ID) && Points[Point2ID].EdgeID < 0)
+		Points[Point2ID].EdgeID = Edge2ID;
 
 	return Edge1ID;
 }
 
 int32 UArmaGridSubsystem::AddFace(int32 EdgeID)
 {
-	int32 NewID = Faces.Num();
-	FArmaGridFace NewFace;
-	NewFace.ID = NewID;
-	NewFace.EdgeID = EdgeID;
+	int32 NewID = NewFaceID();
+	Faces[NewID].EdgeID = EdgeID;
 
-	// Calculate center
-	TArray<FArmaCoord> FacePoints;
+	// Claim the edge loop and cache the center
 	int32 CurrentEdge = EdgeID;
 	int32 FirstEdge = EdgeID;
 	do
 	{
-		if (Edges.IsValidIndex(CurrentEdge) && Points.IsValidIndex(Edges[CurrentEdge].PointID))
-		{
-			FacePoints.Add(Points[Edges[CurrentEdge].PointID].Position);
-			Edges[CurrentEdge].FaceID = NewID;
-			CurrentEdge = Edges[CurrentEdge].NextID;
-		}
-		else
+		if (!Edges.IsValidIndex(CurrentEdge))
 			break;
+		Edges[CurrentEdge].FaceID = NewID;
+		CurrentEdge = Edges[CurrentEdge].NextID;
 	}
 	while (CurrentEdge != FirstEdge && CurrentEdge >= 0);
 
-	if (FacePoints.Num() > 0)
+	UpdateFaceCenter(NewID);
+	return NewID;
+}
+
+void UArmaGridSubsystem::UpdateFaceCenter(int32 FaceID)
+{
+	FArmaGridFace& Face = Faces[FaceID];
+	FArmaCoord Sum = FArmaCoord::Zero;
+	int32 Count = 0;
+	int32 CurrentEdge = Face.EdgeID;
+	do
 	{
-		FArmaCoord Sum = FArmaCoord::Zero;
-		for (const FArmaCoord& P : FacePoints)
-			Sum += P;
-		NewFace.Center = Sum / FacePoints.Num();
+		if (!Edges.IsValidIndex(CurrentEdge) || !Points.IsValidIndex(Edges[CurrentEdge].PointID))
+			break;
+		Sum += Points[Edges[CurrentEdge].PointID].Position;
+		Count++;
+		CurrentEdge = Edges[CurrentEdge].NextID;
 	}
+	while (CurrentEdge != Face.EdgeID && CurrentEdge >= 0);
 
-	Faces.Add(NewFace);
+	if (Count > 0)
+	{
+		Face.Center = Sum / Count;
+	}
+}
+
+void UArmaGridSubsystem::LinkTriangle(int32 FaceID, int32 Edge0, int32 Edge1, int32 Edge2)
+{
+	ConnectEdges(Edge0, Edge1);
+	ConnectEdges(Edge1, Edge2);
+	ConnectEdges(Edge2, Edge0);
+	Edges[Edge0].FaceID = FaceID;
+	Edges[Edge1].FaceID = FaceID;
+	Edges[Edge2].FaceID = FaceID;
+	Faces[FaceID].EdgeID = Edge0;
+	UpdateFaceCenter(FaceID);
+}
+
+int32 UArmaGridSubsystem::NewFaceID()
+{
+	int32 NewID = FreeFaces.Num() > 0 ? FreeFaces.Pop(EAllowShrinking::No) : Faces.AddDefaulted();
+	Faces[NewID] = FArmaGridFace();
+	Faces[NewID].ID = NewID;
 	return NewID;
 }
 
-void UArmaGridSubsystem::SplitEdge(int32 EdgeID, int32 NewPointID)
+void UArmaGridSubsystem::GetOutgoingEdges(int32 PointID, TArray<int32, TInlineAllocator<16>>& OutEdges) const
+{
+	OutEdges.Reset();
+	const int32 FirstEdge = Points[PointID].EdgeID;
+	if (FirstEdge < 0)
+		return;
+
+	// Rotate around the point: the edge before an outgoing edge comes back in, its twin goes out again
+	int32 EdgeID = FirstEdge;
+	do
+	{
+		OutEdges.Add(EdgeID);
+		EdgeID = Edges[Edges[EdgeID].PrevID].TwinID;
+	}
+	while (EdgeID != FirstEdge && EdgeID >= 0 && OutEdges.Num() < Edges.Num());
+}
+
+int32 UArmaGridSubsystem::GetDest(int32 EdgeID) const
+{
+	return Edges[Edges[EdgeID].TwinID].PointID;
+}
+
+void UArmaGridSubsystem::SetEdgeOrigin(int32 EdgeID, int32 PointID)
+{
+	// Called before the edge is relinked, so the old origin's fan is still intact to pick a replacement from
+	FArmaGridHalfEdge& Edge = Edges[EdgeID];
+	if (Points.IsValidIndex(Edge.PointID) && Points[Edge.PointID].EdgeID == EdgeID)
+	{
+		const int32 NextOutgoing = Edges[Edge.PrevID].TwinID;
+		Points[Edge.PointID].EdgeID = NextOutgoing != EdgeID ? NextOutgoing : -1;
+	}
+	Edge.PointID = PointID;
+	if (Points[PointID].EdgeID < 0)
+	{
+		Points[PointID].EdgeID = EdgeID;
+	}
+}
+
+void UArmaGridSubsystem::SplitFace(int32 FaceID, int32 NewPointID, TArray<int32, TInlineAllocator<8>>& OutLinkEdges)
 {
-	// TODO: Implement full edge splitting
+	// Triangle A->B->C around the new point P becomes ABP, BCP, CAP
+	const int32 EdgeAB = Faces[FaceID].EdgeID;
+	const int32 EdgeBC = Edges[EdgeAB].NextID;
+	const int32 EdgeCA = Edges[EdgeBC].NextID;
+	const int32 A = Edges[EdgeAB].PointID;
+	const int32 B = Edges[EdgeBC].PointID;
+	const int32 C = Edges[EdgeCA].PointID;
+
+	const int32 EdgeAP = AddEdgePair(A, NewPointID);
+	const int32 EdgeBP = AddEdgePair(B, NewPointID);
+	const int32 EdgeCP = AddEdgePair(C, NewPointID);
+
+	const int32 FaceBCP = NewFaceID();
+	const int32 FaceCAP = NewFaceID();
+	LinkTriangle(FaceID, EdgeAB, EdgeBP, Edges[EdgeAP].TwinID);
+	LinkTriangle(FaceBCP, EdgeBC, EdgeCP, Edges[EdgeBP].TwinID);
+	LinkTriangle(FaceCAP, EdgeCA, EdgeAP, Edges[EdgeCP].TwinID);
+
+	OutLinkEdges.Add(EdgeAB);
+	OutLinkEdges.Add(EdgeBC);
+	OutLinkEdges.Add(EdgeCA);
+}
+
+void UArmaGridSubsystem::SplitEdge(int32 EdgeID, int32 NewPointID, TArray<int32, TInlineAllocator<8>>& OutLinkEdges)
+{
+	// Edge A->B (twin B->A) is cut at P: EdgeID keeps A->P, its twin becomes P->A,
+	// and a new pair P->B / B->P takes the other half. Walls stay on both halves.
+	const int32 TwinID = Edges[EdgeID].TwinID;
+	const int32 A = Edges[EdgeID].PointID;
+	const int32 B = Edges[TwinID].PointID;
+
+	const int32 EdgePB = AddEdgePair(NewPointID, B);
+	const int32 EdgeBP = Edges[EdgePB].TwinID;
+	SetEdgeOrigin(TwinID, NewPointID);
+	Edges[EdgePB].WallID = Edges[EdgeID].WallID;
+	Edges[EdgeBP].WallID = Edges[EdgeID].WallID;
+	Edges[EdgePB].bConstrained = Edges[EdgeID].bConstrained;
+	Edges[EdgeBP].bConstrained = Edges[EdgeID].bConstrained;
+	if (Edges[EdgeID].WallID >= 0)
+	{
+		WallEdges[Edges[EdgeID].WallID].Add(EdgePB);
+	}
+
+	// A->B side: triangle A->B->C becomes A->P->C and P->B->C, or the outer ring gains P->B
+	const int32 FaceAB = Edges[EdgeID].FaceID;
+	if (FaceAB >= 0)
+	{
+		const int32 EdgeBC = Edges[EdgeID].NextID;
+		const int32 EdgeCA = Edges[EdgeBC].NextID;
+		const int32 C = Edges[EdgeCA].PointID;
+		const int32 EdgeCP = AddEdgePair(C, NewPointID);
+
+		LinkTriangle(FaceAB, EdgeID, Edges[EdgeCP].TwinID, EdgeCA);
+		LinkTriangle(NewFaceID(), EdgePB, EdgeBC, EdgeCP);
+		OutLinkEdges.Add(EdgeBC);
+		OutLinkEdges.Add(EdgeCA);
+	}
+	else
+	{
+		const int32 OldNext = Edges[EdgeID].NextID;
+		ConnectEdges(EdgeID, EdgePB);
+		ConnectEdges(EdgePB, OldNext);
+	}
+
+	// B->A side (now P->A): triangle B->A->D becomes P->A->D and B->P->D, or the outer ring gains B->P
+	const int32 FaceBA = Edges[TwinID].FaceID;
+	if (FaceBA >= 0)
+	{
+		const int32 EdgeAD = Edges[TwinID].NextID;
+		const int32 EdgeDB = Edges[EdgeAD].NextID;
+		const int32 D = Edges[EdgeDB].PointID;
+		const int32 EdgeDP = AddEdgePair(D, NewPointID);
+
+		LinkTriangle(FaceBA, TwinID, EdgeAD, EdgeDP);
+		LinkTriangle(NewFaceID(), EdgeBP, Edges[EdgeDP].TwinID, EdgeDB);
+		OutLinkEdges.Add(EdgeAD);
+		OutLinkEdges.Add(EdgeDB);
+	}
+	else
+	{
+		const int32 OldPrev = Edges[TwinID].PrevID;
+		ConnectEdges(OldPrev, EdgeBP);
+		ConnectEdges(EdgeBP, TwinID);
+	}
+}
+
+bool UArmaGridSubsystem::FlipEdge(int32 EdgeID, bool bAllowFlatOrigin)
+{
+	// Edge A->B between triangles A->B->C and B->A->D is replaced by C->D,
+	// giving C->A->D and D->B->C. Only valid if ADBC is strictly convex - or, when A
+	// is about to be removed anyway, if A lies on C->D.
+	const int32 TwinID = Edges[EdgeID].TwinID;
+	const int32 FaceABC = Edges[EdgeID].FaceID;
+	const int32 FaceBAD = Edges[TwinID].FaceID;
+	if (FaceABC < 0 || FaceBAD < 0)
+		return false;
+
+	const int32 EdgeBC = Edges[EdgeID].NextID;
+	const int32 EdgeCA = Edges[EdgeBC].NextID;
+	const int32 EdgeAD = Edges[TwinID].NextID;
+	const int32 EdgeDB = Edges[EdgeAD].NextID;
+	const int32 A = Edges[EdgeID].PointID;
+	const int32 B = Edges[TwinID].PointID;
+	const int32 C = Edges[EdgeCA].PointID;
+	const int32 D = Edges[EdgeDB].PointID;
+
+	const FArmaCoord& PA = Points[A].Position;
+	const FArmaCoord& PB = Points[B].Position;
+	const FArmaCoord& PC = Points[C].Position;
+	const FArmaCoord& PD = Points[D].Position;
+	const double OrientA = Orient(PC, PD, PA);
+	if ((bAllowFlatOrigin ? OrientA > 0.0 : OrientA >= 0.0) || Orient(PC, PD, PB) <= 0.0)
+		return false;
+
+	SetEdgeOrigin(EdgeID, C);
+	SetEdgeOrigin(TwinID, D);
+	LinkTriangle(FaceABC, EdgeCA, EdgeAD, TwinID);
+	LinkTriangle(FaceBAD, EdgeDB, EdgeBC, EdgeID);
+	return true;
+}
+
+void UArmaGridSubsystem::LegalizeEdges(TArray<int32>& Pending)
+{
+	// Lawson's algorithm: flip every unconstrained edge whose opposite corner lies inside
+	// the neighbouring circumcircle, then recheck the four edges around the flip
+	const int32 MaxFlips = 4 * Edges.Num() + 64;
+	int32 NumFlips = 0;
+	while (Pending.Num() > 0 && NumFlips < MaxFlips)
+	{
+		const int32 EdgeID = Pending.Pop(EAllowShrinking::No);
+		if (IsConstrained(EdgeID))
+			continue;
+
+		const int32 TwinID = Edges[EdgeID].TwinID;
+		if (Edges[EdgeID].FaceID < 0 || Edges[TwinID].FaceID < 0)
+			continue;
+
+		const int32 EdgeBC = Edges[EdgeID].NextID;
+		const int32 EdgeCA = Edges[EdgeBC].NextID;
+		const int32 EdgeAD = Edges[TwinID].NextID;
+		const int32 EdgeDB = Edges[EdgeAD].NextID;
+		const FArmaCoord& PA = Points[Edges[EdgeID].PointID].Position;
+		const FArmaCoord& PB = Points[Edges[TwinID].PointID].Position;
+		const FArmaCoord& PC = Points[Edges[EdgeCA].PointID].Position;
+		const FArmaCoord& PD = Points[Edges[EdgeDB].PointID].Position;
+
+		if (InCircle(PA, PB, PC, PD) && FlipEdge(EdgeID))
+		{
+			NumFlips++;
+			Pending.Add(EdgeBC);
+			Pending.Add(EdgeCA);
+			Pending.Add(EdgeAD);
+			Pending.Add(EdgeDB);
+		}
+	}
+}
+
+void UArmaGridSubsystem::MarkWallEdge(int32 EdgeID, int32 WallID)
+{
+	FArmaGridHalfEdge& Edge = Edges[EdgeID];
+	FArmaGridHalfEdge& Twin = Edges[Edge.TwinID];
+	Edge.WallID = WallID;
+	Twin.WallID = WallID;
+	Edge.bConstrained = true;
+	Twin.bConstrained = true;
+	if (WallID >= 0)
+	{
+		WallEdges[WallID].Add(EdgeID & ~1);
+	}
+}
+
+bool UArmaGridSubsystem::IsConstrained(int32 EdgeID) const
+{
+	return Edges[EdgeID].bConstrained;
+}
+
+int32 UArmaGridSubsystem::GetWallID(AArmaWall* Wall)
+{
+	if (const int32* Existing = WallIDs.Find(TObjectKey<AArmaWall>(Wall)))
+	{
+		return *Existing;
+	}
+
+	int32 WallID = FreeWallIDs.Num() > 0 ? FreeWallIDs.Pop(EAllowShrinking::No) : WallTable.AddDefaulted();
+	if (WallID >= WallKeys.Num())
+	{
+		WallKeys.SetNum(WallID + 1);
+		WallEdges.SetNum(WallID + 1);
+	}
+	WallTable[WallID] = Wall;
+	WallKeys[WallID] = TObjectKey<AArmaWall>(Wall);
+	WallIDs.Add(WallKeys[WallID], WallID);
+	return WallID;
+}
+
+AArmaWall* UArmaGridSubsystem::GetEdgeWall(int32 EdgeID) const
+{
+	// Destroyed walls are nulled in the table by the garbage collector
+	const int32 WallID = Edges[EdgeID].WallID;
+	AArmaWall* Wall = WallTable.IsValidIndex(WallID) ? WallTable[WallID] : nullptr;
+	return IsValid(Wall) ? Wall : nullptr;
+}
+
+void UArmaGridSubsystem::ReleaseWallID(int32 WallID)
+{
+	// The key outlives the actor, so a destroyed wall's entry is still found by its slot
+	WallIDs.Remove(WallKeys[WallID]);
+	WallKeys[WallID] = TObjectKey<AArmaWall>();
+	WallEdges[WallID].Reset();
+	WallTable[WallID] = nullptr;
+	FreeWallIDs.Add(WallID);
+}
+
+bool UArmaGridSubsystem::RemovePoint(int32 PointID, TArray<int32>& Pending)
+{
+	// Only interior points that no wall uses any more
+	TArray<int32, TInlineAllocator<16>> Spokes;
+	GetOutgoingEdges(PointID, Spokes);
+	for (int32 Spoke : Spokes)
+	{
+		if (IsConstrained(Spoke) || Edges[Spoke].FaceID < 0 || Edges[Edges[Spoke].TwinID].FaceID < 0)
+			return false;
+	}
+
+	// The polygon around the point will be retriangulated
+	for (int32 Spoke : Spokes)
+	{
+		Pending.Add(Edges[Spoke].NextID);
+	}
+
+	// Flip spokes away until three are left. The polygon around the point is star-shaped,
+	// so some spoke can always be flipped - though where the point sits on a line between
+	// two neighbours (an old wall crossing) that flip leaves a flat triangle at the point,
+	// which is fine as the point is about to go.
+	while (Spokes.Num() > 3)
+	{
+		bool bFlipped = false;
+		for (int32 Pass = 0; Pass < 2 && !bFlipped; Pass++)
+		{
+			for (int32 Spoke : Spokes)
+			{
+				if (FlipEdge(Spoke, Pass > 0))
+				{
+					Pending.Add(Spoke);
+					bFlipped = true;
+					break;
+				}
+			}
+		}
+		if (!bFlipped)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("ArmaGrid: Could not remove point %d"), PointID);
+			return false;
+		}
+		GetOutgoingEdges(PointID, Spokes);
+	}
+	if (Spokes.Num() != 3)
+		return false;
+
+	// Three triangles around the point merge into the one spanned by its neighbours
+	const int32 Link0 = Edges[Spokes[0]].NextID;
+	const int32 Link1 = Edges[Spokes[1]].NextID;
+	const int32 Link2 = Edges[Spokes[2]].NextID;
+	const int32 KeptFace = Edges[Spokes[0]].FaceID;
+	FreeFace(Edges[Spokes[1]].FaceID);
+	FreeFace(Edges[Spokes[2]].FaceID);
+	for (int32 Spoke : Spokes)
+	{
+		FreeEdgePair(Spoke);
+	}
+	LinkTriangle(KeptFace, Link0, Link1, Link2);
+	Points[Edges[Link0].PointID].EdgeID = Link0;
+	Points[Edges[Link1].PointID].EdgeID = Link1;
+	Points[Edges[Link2].PointID].EdgeID = Link2;
+
+	Points[PointID] = FArmaGridPoint();
+	FreePoints.Add(PointID);
+	return true;
+}
+
+void UArmaGridSubsystem::FreeEdgePair(int32 EdgeID)
+{
+	const int32 PairID = EdgeID & ~1;
+	for (int32 HalfID = PairID; HalfID <= PairID + 1; HalfID++)
+	{
+		FArmaGridHalfEdge& Edge = Edges[HalfID];
+		Edge = FArmaGridHalfEdge();
+		Edge.ID = HalfID;
+	}
+	FreeEdgePairs.Add(PairID);
+}
+
+void UArmaGridSubsystem::FreeFace(int32 FaceID)
+{
+	Faces[FaceID] = FArmaGridFace();
+	FreeFaces.Add(FaceID);
 }
 
 void UArmaGridSubsystem::ConnectEdges(int32 Edge1ID, int32 Edge2ID)
@@ -392,9 +1299,135 @@ void UArmaGridSubsystem::ConnectEdges(int32 Edge1ID, int32 Edge2ID)
 
 int32 UArmaGridSubsystem::FindEdgeForPoint(const FArmaCoord& Point, int32 FaceID) const
 {
-	// TODO: Implement finding which edge a point lies on
+	// The edge of the face the point lies on (within PointMergeDistance), or -1 if it is inside
+	if (!Faces.IsValidIndex(FaceID))
+		return -1;
+
+	int32 EdgeID = Faces[FaceID].EdgeID;
+	const int32 FirstEdge = EdgeID;
+	do
+	{
+		const FArmaCoord& P1 = Points[Edges[EdgeID].PointID].Position;
+		const FArmaCoord& P2 = Points[GetDest(EdgeID)].Position;
+		const FArmaCoord Along = P2 - P1;
+		const float T = (Point - P1).Dot(Along);
+		if (T > 0.0f && T < Along.NormSquared() && DistanceFromLine(P1, P2, Point) <= PointMergeDistance)
+		{
+			return EdgeID;
+		}
+		EdgeID = Edges[EdgeID].NextID;
+	}
+	while (EdgeID != FirstEdge && EdgeID >= 0);
+
+	return -1;
+}
+
+int32 UArmaGridSubsystem::FindFaceTowards(int32 PointID, const FArmaCoord& Towards) const
+{
+	// The face whose corner at the point contains the direction towards Towards
+	const FArmaCoord& Origin = Points[PointID].Position;
+	TArray<int32, TInlineAllocator<16>> OutEdges;
+	GetOutgoingEdges(PointID, OutEdges);
+	for (int32 OutEdge : OutEdges)
+	{
+		if (Edges[OutEdge].FaceID < 0)
+			continue;
+
+		const FArmaCoord& Right = Points[GetDest(OutEdge)].Position;
+		const FArmaCoord& Left = Points[GetDest(Edges[OutEdge].NextID)].Position;
+		if (Orient(Origin, Right, Towards) >= 0.0 && Orient(Origin, Towards, Left) >= 0.0)
+		{
+			return Edges[OutEdge].FaceID;
+		}
+	}
 	return -1;
 }
+
+bool UArmaGridSubsystem::WallCrossesRayAt(int32 PointID, const FArmaCoord& Start, const FArmaCoord& End, AArmaWall*& OutWall) const
+{
+	// The walls meeting at the point block the ray only if they reach both sides of it;
+	// a wall merely ending on the ray, or running along it, lets it pass
+	AArmaWall* LeftWall = nullptr;
+	AArmaWall* RightWall = nullptr;
+	TArray<int32, TInlineAllocator<16>> OutEdges;
+	GetOutgoingEdges(PointID, OutEdges);
+	for (int32 OutEdge : OutEdges)
+	{
+		AArmaWall* Wall = GetEdgeWall(OutEdge);
+		if (!Wall)
+			continue;
+
+		const double Side = Orient(Start, End, Points[GetDest(OutEdge)].Position);
+		if (Side > 0.0)
+		{
+			LeftWall = Wall;
+		}
+		else if (Side < 0.0)
+		{
+			RightWall = Wall;
+		}
+	}
+
+	OutWall = (LeftWall && RightWall) ? LeftWall : nullptr;
+	return OutWall != nullptr;
+}
+
+bool UArmaGridSubsystem::RayCastAllEdges(const FArmaCoord& Start, const FArmaCoord& End, FArmaCoord& HitPoint, AArmaWall*& HitWall) const
+{
+	HitWall = nullptr;
+	float BestT = FLT_MAX;
+	bool bHit = false;
+
+	FArmaCoord RayDir = End - Start;
+	float RayLength = RayDir.Norm();
+	if (RayLength < KINDA_SMALL_NUMBER)
+		return false;
+
+	FArmaCoord RayDirNorm = RayDir / RayLength;
+
+	for (const FArmaGridHalfEdge& Edge : Edges)
+	{
+		// Both halves carry the wall - test each edge once
+		AArmaWall* Wall = GetEdgeWall(Edge.ID);
+		if (!Wall || Edge.ID > Edge.TwinID)
+			continue;
+
+		if (Edge.PointID < 0 || Edge.TwinID < 0)
+			continue;
+
+		const FArmaGridHalfEdge& Twin = Edges[Edge.TwinID];
+		if (!Points.IsValidIndex(Edge.PointID) || !Points.IsValidIndex(Twin.PointID))
+			continue;
+
+		FArmaCoord P1 = Points[Edge.PointID].Position;
+		FArmaCoord P2 = Points[Twin.PointID].Position;
+
+		// Ray-segment intersection
+		FArmaCoord SegDir = P2 - P1;
+		float Cross = RayDirNorm.Cross(SegDir);
+
+		if (FMath::Abs(Cross) < KINDA_SMALL_NUMBER)
+			continue;  // Parallel
+
+		FArmaCoord StartToP1 = P1 - Start;
+		float T = StartToP1.Cross(SegDir) / Cross;
+		float U = StartToP1.Cross(RayDirNorm) / Cross;
+
+		if (T >= 0 && T <= RayLength && U >= 0 && U <= 1.0f)
+		{
+			if (T < BestT)
+			{
+				BestT = T;
+				HitPoint = Start + RayDirNorm * T;
+				HitWall = Wall;
+				bHit = true;
+			}
+		}
+	}
+
+	return bHit;
+}
+
 //////////////////////////////////////////////////////////////////////////
 // AArmaArena Implementation
 //////////////////////////////////////////////////////////////////////////
@@ -542,5 +1575,3 @@ void FArmaSpawnPoint::UpdateDanger(const UWorld* World)
 		}
 	}
 }
-
-
@@ -6,6 +6,7 @@
 #include "CoreMinimal.h"
 #include "ArmaTypes.h"
 #include "Components/ActorComponent.h"
+#include "UObject/ObjectKey.h"
 #include "ArmaGrid.generated.h"
 
 // Forward declarations
@@ -16,57 +17,41 @@ class UArmaGridSubsystem;
 /**
  * FArmaGridPoint - Port of ePoint from original
  * A point in the grid mesh
+ *
+ * The grid's topology (points, half-edges, faces) is plain C++ data: it holds no
+ * object references, so the garbage collector never has to walk it however large
+ * the grid grows. Walls are referenced by ID through the subsystem's wall table.
  */
-USTRUCT(BlueprintType)
 struct ARMAGETRONUE5_API FArmaGridPoint
 {
-	GENERATED_BODY()
-
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Grid")
 	int32 ID;
-
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Grid")
 	FArmaCoord Position;
 
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Grid")
-	TArray<int32> EdgeIDs;  // IDs of half-edges emanating from this point
+	// One half-edge emanating from this point; the others are reached by rotating
+	// through twins, so points need no adjacency list of their own
+	int32 EdgeID;
 
-	FArmaGridPoint() : ID(-1) {}
-	FArmaGridPoint(int32 InID, const FArmaCoord& InPos) : ID(InID), Position(InPos) {}
+	FArmaGridPoint() : ID(-1), EdgeID(-1) {}
+	FArmaGridPoint(int32 InID, const FArmaCoord& InPos) : ID(InID), Position(InPos), EdgeID(-1) {}
 };
 
 /**
  * FArmaGridHalfEdge - Port of eHalfEdge from original
  * A directed edge in the grid mesh (each edge has two half-edges)
  */
-USTRUCT(BlueprintType)
 struct ARMAGETRONUE5_API FArmaGridHalfEdge
 {
-	GENERATED_BODY()
-
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Grid")
 	int32 ID;
-
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Grid")
 	int32 PointID;  // Point this edge emanates from
-
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Grid")
 	int32 TwinID;  // The opposite half-edge
-
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Grid")
 	int32 NextID;  // Next edge in face (counter-clockwise)
-
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Grid")
 	int32 PrevID;  // Previous edge in face
-
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Grid")
 	int32 FaceID;  // Face this edge borders
-
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Grid")
-	TWeakObjectPtr<AArmaWall> Wall;  // Wall on this edge (if any)
+	int32 WallID;  // Wall on this edge (index into the grid's wall table, -1 if none)
+	bool bConstrained;  // Drawn by DrawLine - never flipped, even after its wall is gone
 
 	FArmaGridHalfEdge()
-		: ID(-1), PointID(-1), TwinID(-1), NextID(-1), PrevID(-1), FaceID(-1)
+		: ID(-1), PointID(-1), TwinID(-1), NextID(-1), PrevID(-1), FaceID(-1), WallID(-1), bConstrained(false)
 	{}
 };
 
@@ -74,19 +59,12 @@ struct ARMAGETRONUE5_API FArmaGridHalfEdge
  * FArmaGridFace - Port of eFace from original
  * A triangular face in the grid mesh
  */
-USTRUCT(BlueprintType)
 struct ARMAGETRONUE5_API FArmaGridFace
 {
-	GENERATED_BODY()
-
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Grid")
 	int32 ID;
-
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Grid")
 	int32 EdgeID;  // One of the edges bounding this face
 
 	// Cached data for quick checks
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Grid")
 	FArmaCoord Center;
 
 	FArmaGridFace() : ID(-1), EdgeID(-1) {}
@@ -172,6 +150,16 @@ struct ARMAGETRONUE5_API FArmaAxis
 /**
  * UArmaGridSubsystem - Port of eGrid
  * Manages the game grid, collision detection, and spatial queries
+ *
+ * The grid is a constrained Delaunay triangulation of the arena, built incrementally:
+ * InsertPoint splits the face (or edge) under the new point and restores the Delaunay
+ * property with edge flips; DrawLine forces a wall segment in as a chain of constrained
+ * edges, splitting any wall it crosses at the crossing point. Perimeter half-edges
+ * form an outer ring with FaceID -1.
+ *
+ * RemoveWall takes a wall out again, along with the points only it needed. Removed
+ * points, edge pairs and faces go on free lists and are reused by later insertions;
+ * Compact closes the remaining holes and renumbers everything.
  */
 UCLASS()
 class ARMAGETRONUE5_API UArmaGridSubsystem : public UWorldSubsystem
@@ -193,18 +181,46 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Grid")
 	void ClearGrid();
 
+	// Has CreateGrid run (and ClearGrid not since)?
+	bool HasGrid() const { return Faces.Num() > 0; }
+
 	// Port of FindSurroundingFace - find which face contains a point
 	UFUNCTION(BlueprintCallable, Category = "Grid")
 	int32 FindSurroundingFace(const FArmaCoord& Coord, int32 StartFaceID = -1) const;
 
-	// Port of DrawLine - insert a wall into the grid
+	// Same, starting from (and updating) a caller-held hint such as a cycle's last face.
+	// A hint to a freed face, or past the end after Compact, moves on to a live face; any
+	// other stale hint (e.g. renumbered by Compact) is simply walked from, further away.
+	int32 FindSurroundingFaceFromHint(const FArmaCoord& Coord, int32& FaceHint) const;
+
+	// Port of DrawLine - insert a wall from an existing point to End; returns End's point (-1 if outside the grid)
 	UFUNCTION(BlueprintCallable, Category = "Grid")
 	int32 DrawLine(int32 StartPointID, const FArmaCoord& End, AArmaWall* Wall = nullptr);
 
-	// Insert a new point into the grid
+	// Insert a new point into the grid; returns the existing point if one is within PointMergeDistance
 	UFUNCTION(BlueprintCallable, Category = "Grid")
 	int32 InsertPoint(const FArmaCoord& Coord, int32 GuessFaceID = -1);
 
+	// Insert a whole wall: its start point, then DrawLine to End. Without a Wall the segment
+	// is still constrained (rim and static walls), but ray casts and blasts don't report it.
+	// Returns End's point, -1 if either end is outside the grid
+	int32 InsertWall(const FArmaCoord& Start, const FArmaCoord& End, AArmaWall* Wall = nullptr);
+
+	// Remove a wall's edges and the points no other wall needs; nullptr removes every wall that was destroyed
+	void RemoveWall(AArmaWall* Wall);
+
+	// Renumber points, edges and faces densely. Invalidates every ID held outside the grid
+	// (face hints recover, point IDs don't), so call it between rounds or when nothing holds any.
+	UFUNCTION(BlueprintCallable, Category = "Grid")
+	void Compact();
+
+	// Are enough entries free that compacting is worth it?
+	bool NeedsCompaction() const;
+
+	// Check every twin, next/prev, face and point link (and that faces are counter-clockwise
+	// triangles); on the first broken one, describe it in OutError and return false
+	bool Validate(FString& OutError) const;
+
 	// Get grid winding number (number of valid directions)
 	UFUNCTION(BlueprintCallable, Category = "Grid")
 	int32 GetWindingNumber() const { return Axis.WindingNumber; }
@@ -221,8 +237,10 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Grid")
 	int32 Turn(int32 CurrentWinding, int32 Direction) const { return Axis.Turn(CurrentWinding, Direction); }
 
-	// Process walls in range (for explosions)
-	void ProcessWallsInRange(const FArmaCoord& Pos, float Range, TFunctionRef<void(AArmaWall*)> Processor);
+	// Process walls in range (for explosions): every wall that passes within Range of Pos,
+	// once, with the stretch of it inside the circle as distances along the wall - the
+	// interval AArmaWall::BlowHole takes
+	void ProcessWallsInRange(const FArmaCoord& Pos, float Range, TFunctionRef<void(AArmaWall* Wall, float BeginDist, float EndDist)> Processor);
 
 	// Accessors
 	const FArmaAxis& GetAxis() const { return Axis; }
@@ -233,34 +251,89 @@ public:
 	// Check if point is inside a face
 	bool IsPointInFace(const FArmaCoord& Point, int32 FaceID) const;
 
-	// Ray cast against grid edges
+	// Ray cast against grid edges: walks the faces along the ray and stops at the first
+	// edge carrying a valid wall. Walls through Start itself, running along the ray, or
+	// only touching it with an end point aren't hit.
 	bool RayCast(const FArmaCoord& Start, const FArmaCoord& End, FArmaCoord& HitPoint, AArmaWall*& HitWall) const;
+	bool RayCast(const FArmaCoord& Start, const FArmaCoord& End, FArmaCoord& HitPoint, AArmaWall*& HitWall, int32& FaceHint) const;
 
 protected:
 	UPROPERTY()
 	FArmaAxis Axis;
 
-	UPROPERTY()
 	TArray<FArmaGridPoint> Points;
-
-	UPROPERTY()
 	TArray<FArmaGridHalfEdge> Edges;
+	TArray<FArmaGridFace> Faces;
 
+	// Wall actors on grid edges, by WallID - the only part of the grid the garbage
+	// collector sees, so its cost follows the number of walls, not the grid's size
 	UPROPERTY()
-	TArray<FArmaGridFace> Faces;
+	TArray<AArmaWall*> WallTable;
+
+	TMap<TObjectKey<AArmaWall>, int32> WallIDs;
+	TArray<TObjectKey<AArmaWall>> WallKeys;		// WallID -> its WallIDs key; null for free slots
+	TArray<TArray<int32>> WallEdges;			// WallID -> the edge pairs (even IDs) marked with it; may hold stale ones
+	TArray<int32> FreeWallIDs;
 
 	UPROPERTY()
 	float GridSize;
 
+	// Removed entries waiting for reuse; edge pairs by their even ID
+	TArray<int32> FreePoints;
+	TArray<int32> FreeEdgePairs;
+	TArray<int32> FreeFaces;
+
+	// Points closer than this are treated as the same point
+	static constexpr float PointMergeDistance = 0.01f;
+
 	// Internal helpers
 	int32 AddPoint(const FArmaCoord& Coord);
 	int32 AddEdgePair(int32 Point1ID, int32 Point2ID);
 	int32 AddFace(int32 EdgeID);
-	void SplitEdge(int32 EdgeID, int32 NewPointID);
+	int32 NewFaceID();
+	void UpdateFaceCenter(int32 FaceID);
 	void ConnectEdges(int32 Edge1ID, int32 Edge2ID);
+	int32 GetDest(int32 EdgeID) const;
+	void SetEdgeOrigin(int32 EdgeID, int32 PointID);
+	void GetOutgoingEdges(int32 PointID, TArray<int32, TInlineAllocator<16>>& OutEdges) const;
+
+	// Remove an interior point no wall uses, retriangulating around it; edges to recheck go to Pending
+	bool RemovePoint(int32 PointID, TArray<int32>& Pending);
+	void FreeEdgePair(int32 EdgeID);
+	void FreeFace(int32 FaceID);
+
+	// Make Edge0 -> Edge1 -> Edge2 the loop of FaceID
+	void LinkTriangle(int32 FaceID, int32 Edge0, int32 Edge1, int32 Edge2);
+
+	// Topology changes; the edges whose Delaunay property may now be violated go to OutLinkEdges
+	void SplitFace(int32 FaceID, int32 NewPointID, TArray<int32, TInlineAllocator<8>>& OutLinkEdges);
+	void SplitEdge(int32 EdgeID, int32 NewPointID, TArray<int32, TInlineAllocator<8>>& OutLinkEdges);
+	bool FlipEdge(int32 EdgeID, bool bAllowFlatOrigin = false);
+
+	// Flip unconstrained edges until none violates the Delaunay property
+	void LegalizeEdges(TArray<int32>& Pending);
+
+	// Force the segment between two points into the grid as constrained edges carrying Wall
+	void InsertConstraint(int32 StartPointID, int32 EndPointID, AArmaWall* Wall);
+	void MarkWallEdge(int32 EdgeID, int32 WallID);
+	bool IsConstrained(int32 EdgeID) const;
+
+	// Wall table: ID of a wall (added on first use), the live wall on an edge, and releasing an ID
+	int32 GetWallID(AArmaWall* Wall);
+	AArmaWall* GetEdgeWall(int32 EdgeID) const;
+	void ReleaseWallID(int32 WallID);
 
 	// Find which edge a point lies on (for insertion)
 	int32 FindEdgeForPoint(const FArmaCoord& Point, int32 FaceID) const;
+
+	// Face around a point whose corner contains the direction towards Towards (-1 if outside the grid)
+	int32 FindFaceTowards(int32 PointID, const FArmaCoord& Towards) const;
+
+	// Do the walls meeting at a point on the ray block it (reach both sides of it)?
+	bool WallCrossesRayAt(int32 PointID, const FArmaCoord& Start, const FArmaCoord& End, AArmaWall*& OutWall) const;
+
+	// Test every wall edge once; fallback if a face walk gets lost
+	bool RayCastAllEdges(const FArmaCoord& Start, const FArmaCoord& End, FArmaCoord& HitPoint, AArmaWall*& HitWall) const;
 };
 
 /**
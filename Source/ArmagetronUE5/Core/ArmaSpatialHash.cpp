@@ -0,0 +1,157 @@
+// ArmaSpatialHash.cpp - Uniform grid hash implementation
+
+#include "ArmaSpatialHash.h"
+
+FArmaSpatialHash::FArmaSpatialHash(float InCellSize, float InPadding)
+	: CellSize(FMath::Max(InCellSize, 1.0f))
+	, InvCellSize(1.0f / FMath::Max(InCellSize, 1.0f))
+	, Padding(FMath::Max(InPadding, 0.0f))
+{
+}
+
+FIntPoint FArmaSpatialHash::GetCell(FVector2D Point) const
+{
+	return FIntPoint(
+		FMath::FloorToInt32(Point.X * InvCellSize),
+		FMath::FloorToInt32(Point.Y * InvCellSize));
+}
+
+uint32 FArmaSpatialHash::GetCellStamp(FIntPoint Cell) const
+{
+	const uint32* Stamp = CellStamps.Find(Cell);
+	return Stamp ? *Stamp : 0;
+}
+
+TConstArrayView<int32> FArmaSpatialHash::GetCellKeys(FIntPoint Cell) const
+{
+	const TArray<int32>* Bucket = Cells.Find(Cell);
+	return Bucket ? TConstArrayView<int32>(*Bucket) : TConstArrayView<int32>();
+}
+
+void FArmaSpatialHash::BumpCellStamps(const FCellRange& Range)
+{
+	for (int32 Y = Range.Min.Y; Y <= Range.Max.Y; Y++)
+	{
+		for (int32 X = Range.Min.X; X <= Range.Max.X; X++)
+		{
+			BumpCellStamp(FIntPoint(X, Y));
+		}
+	}
+}
+
+FArmaSpatialHash::FCellRange FArmaSpatialHash::ComputeRange(FVector2D Start, FVector2D End) const
+{
+	const FVector2D Min(FMath::Min(Start.X, End.X) - Padding, FMath::Min(Start.Y, End.Y) - Padding);
+	const FVector2D Max(FMath::Max(Start.X, End.X) + Padding, FMath::Max(Start.Y, End.Y) + Padding);
+
+	FCellRange Range;
+	Range.Min = GetCell(Min);
+	Range.Max = GetCell(Max);
+	return Range;
+}
+
+void FArmaSpatialHash::AddToCells(int32 Key, const FCellRange& Range, const FCellRange* Skip)
+{
+	for (int32 Y = Range.Min.Y; Y <= Range.Max.Y; Y++)
+	{
+		for (int32 X = Range.Min.X; X <= Range.Max.X; X++)
+		{
+			const FIntPoint Cell(X, Y);
+			if (Skip && Skip->Contains(Cell))
+			{
+				continue;
+			}
+			Cells.FindOrAdd(Cell).Add(Key);
+			BumpCellStamp(Cell);
+		}
+	}
+
+	if (!bHasBounds)
+	{
+		OccupiedBounds = Range;
+		bHasBounds = true;
+	}
+	else
+	{
+		OccupiedBounds.Min = FIntPoint(FMath::Min(OccupiedBounds.Min.X, Range.Min.X), FMath::Min(OccupiedBounds.Min.Y, Range.Min.Y));
+		OccupiedBounds.Max = FIntPoint(FMath::Max(OccupiedBounds.Max.X, Range.Max.X), FMath::Max(OccupiedBounds.Max.Y, Range.Max.Y));
+	}
+}
+
+void FArmaSpatialHash::RemoveFromCells(int32 Key, const FCellRange& Range, const FCellRange* Skip)
+{
+	for (int32 Y = Range.Min.Y; Y <= Range.Max.Y; Y++)
+	{
+		for (int32 X = Range.Min.X; X <= Range.Max.X; X++)
+		{
+			const FIntPoint Cell(X, Y);
+			if (Skip && Skip->Contains(Cell))
+			{
+				continue;
+			}
+			if (TArray<int32>* Bucket = Cells.Find(Cell))
+			{
+				Bucket->RemoveSingleSwap(Key, EAllowShrinking::No);
+				if (Bucket->Num() == 0)
+				{
+					Cells.Remove(Cell);
+				}
+				BumpCellStamp(Cell);
+			}
+		}
+	}
+}
+
+void FArmaSpatialHash::Insert(int32 Key, FVector2D Start, FVector2D End)
+{
+	if (KeyRanges.Contains(Key))
+	{
+		Update(Key, Start, End);
+		return;
+	}
+
+	const FCellRange Range = ComputeRange(Start, End);
+	AddToCells(Key, Range, nullptr);
+	KeyRanges.Add(Key, Range);
+}
+
+void FArmaSpatialHash::Update(int32 Key, FVector2D Start, FVector2D End)
+{
+	FCellRange* OldRange = KeyRanges.Find(Key);
+	if (!OldRange)
+	{
+		Insert(Key, Start, End);
+		return;
+	}
+
+	// The segment moved inside the cells it keeps, too
+	const FCellRange NewRange = ComputeRange(Start, End);
+	BumpCellStamps(NewRange);
+	if (NewRange == *OldRange)
+	{
+		// Growing walls stay inside the same cells most frames
+		return;
+	}
+
+	RemoveFromCells(Key, *OldRange, &NewRange);
+	AddToCells(Key, NewRange, OldRange);
+	*OldRange = NewRange;
+}
+
+void FArmaSpatialHash::Remove(int32 Key)
+{
+	FCellRange Range;
+	if (KeyRanges.RemoveAndCopyValue(Key, Range))
+	{
+		RemoveFromCells(Key, Range, nullptr);
+	}
+}
+
+void FArmaSpatialHash::Reset()
+{
+	// StampCounter keeps counting, so stamps taken before the reset never match again
+	Cells.Reset();
+	KeyRanges.Reset();
+	CellStamps.Reset();
+	bHasBounds = false;
+}
@@ -0,0 +1,216 @@
+// ArmaSpatialHash.h - Uniform grid hash for 2D wall segments
+// Buckets segments by the grid cells their bounding box touches so ray
+// queries only look at walls near the ray (the role eGrid plays in the original)
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * FArmaSpatialHash - Uniform grid of buckets over the XY plane
+ * Keys are opaque ints chosen by the owner (the wall registry uses wall IDs).
+ * Every key is stored in each cell its padded bounding box overlaps, so a ray
+ * that passes within Padding of a segment is guaranteed to visit one of its cells.
+ */
+class ARMAGETRONUE5_API FArmaSpatialHash
+{
+public:
+	explicit FArmaSpatialHash(float InCellSize = 500.0f, float InPadding = 5.0f);
+
+	// Insert a new segment under Key
+	void Insert(int32 Key, FVector2D Start, FVector2D End);
+
+	// Move an existing segment; only cells entering or leaving its footprint are touched
+	void Update(int32 Key, FVector2D Start, FVector2D End);
+
+	// Remove a segment from every cell it occupies
+	void Remove(int32 Key);
+
+	// Drop all cells and keys
+	void Reset();
+
+	bool Contains(int32 Key) const { return KeyRanges.Contains(Key); }
+	float GetCellSize() const { return CellSize; }
+	FIntPoint GetCell(FVector2D Point) const;
+
+	/**
+	 * Change stamp of a cell: bumped whenever a key is added to, moved within or removed
+	 * from the cell. Stamps come from one counter that survives Reset, so an unchanged
+	 * stamp means nothing in the cell changed. 0 = never touched.
+	 */
+	uint32 GetCellStamp(FIntPoint Cell) const;
+
+	// Keys stored in a cell (empty if none)
+	TConstArrayView<int32> GetCellKeys(FIntPoint Cell) const;
+
+	/**
+	 * Walk every cell crossed by a ray in order, occupied or not (Amanatides & Woo DDA)
+	 * Visitor(FIntPoint Cell, float CellExitDistance) returns true to stop.
+	 * Direction must be normalized.
+	 */
+	template<typename VisitorType>
+	void WalkRayCells(FVector2D Origin, FVector2D Direction, float MaxDistance, VisitorType&& Visitor) const;
+
+	/**
+	 * Walk the cells crossed by a ray in order (Amanatides & Woo DDA)
+	 * Visitor(TConstArrayView<int32> Keys, float CellExitDistance) returns true to stop.
+	 * Keys may repeat across cells - callers dedupe if the test is expensive.
+	 * Direction must be normalized.
+	 */
+	template<typename VisitorType>
+	void TraverseRay(FVector2D Origin, FVector2D Direction, float MaxDistance, VisitorType&& Visitor) const;
+
+	/**
+	 * Visit the keys of every cell overlapping Box
+	 * Visitor(TConstArrayView<int32> Keys) - keys may repeat across cells
+	 */
+	template<typename VisitorType>
+	void QueryBox(const FBox2D& Box, VisitorType&& Visitor) const;
+
+private:
+	// Inclusive cell rectangle covered by a key
+	struct FCellRange
+	{
+		FIntPoint Min;
+		FIntPoint Max;
+
+		bool operator==(const FCellRange& Other) const { return Min == Other.Min && Max == Other.Max; }
+		bool Contains(const FIntPoint& Cell) const
+		{
+			return Cell.X >= Min.X && Cell.X <= Max.X && Cell.Y >= Min.Y && Cell.Y <= Max.Y;
+		}
+	};
+
+	FCellRange ComputeRange(FVector2D Start, FVector2D End) const;
+	void AddToCells(int32 Key, const FCellRange& Range, const FCellRange* Skip);
+	void RemoveFromCells(int32 Key, const FCellRange& Range, const FCellRange* Skip);
+	void BumpCellStamp(FIntPoint Cell) { CellStamps.FindOrAdd(Cell) = ++StampCounter; }
+	void BumpCellStamps(const FCellRange& Range);
+
+	float CellSize;
+	float InvCellSize;
+	float Padding;
+
+	TMap<FIntPoint, TArray<int32>> Cells;
+	TMap<int32, FCellRange> KeyRanges;
+
+	// Per-cell change stamps (kept for emptied cells too)
+	TMap<FIntPoint, uint32> CellStamps;
+	uint32 StampCounter = 0;
+
+	// Cell bounds ever occupied - rays stop once they leave them for good
+	FCellRange OccupiedBounds;
+	bool bHasBounds = false;
+};
+
+//////////////////////////////////////////////////////////////////////////
+// Template implementations
+//////////////////////////////////////////////////////////////////////////
+
+template<typename VisitorType>
+void FArmaSpatialHash::WalkRayCells(FVector2D Origin, FVector2D Direction, float MaxDistance, VisitorType&& Visitor) const
+{
+	if (MaxDistance <= 0.0f)
+	{
+		return;
+	}
+
+	FIntPoint Cell = GetCell(Origin);
+	const int32 StepX = Direction.X > 0.0 ? 1 : (Direction.X < 0.0 ? -1 : 0);
+	const int32 StepY = Direction.Y > 0.0 ? 1 : (Direction.Y < 0.0 ? -1 : 0);
+
+	// Distance along the ray to the next vertical / horizontal cell border
+	float NextX = MAX_FLT;
+	float NextY = MAX_FLT;
+	float DeltaX = MAX_FLT;
+	float DeltaY = MAX_FLT;
+	if (StepX != 0)
+	{
+		const double Border = (StepX > 0 ? Cell.X + 1 : Cell.X) * (double)CellSize;
+		NextX = (float)((Border - Origin.X) / Direction.X);
+		DeltaX = CellSize / FMath::Abs((float)Direction.X);
+	}
+	if (StepY != 0)
+	{
+		const double Border = (StepY > 0 ? Cell.Y + 1 : Cell.Y) * (double)CellSize;
+		NextY = (float)((Border - Origin.Y) / Direction.Y);
+		DeltaY = CellSize / FMath::Abs((float)Direction.Y);
+	}
+
+	for (;;)
+	{
+		const float ExitDistance = FMath::Min(NextX, NextY);
+		if (Visitor(Cell, ExitDistance))
+		{
+			return;
+		}
+
+		if (ExitDistance >= MaxDistance)
+		{
+			return;
+		}
+
+		if (NextX < NextY)
+		{
+			Cell.X += StepX;
+			NextX += DeltaX;
+		}
+		else
+		{
+			Cell.Y += StepY;
+			NextY += DeltaY;
+		}
+	}
+}
+
+template<typename VisitorType>
+void FArmaSpatialHash::TraverseRay(FVector2D Origin, FVector2D Direction, float MaxDistance, VisitorType&& Visitor) const
+{
+	if (!bHasBounds)
+	{
+		return;
+	}
+
+	const int32 StepX = Direction.X > 0.0 ? 1 : (Direction.X < 0.0 ? -1 : 0);
+	const int32 StepY = Direction.Y > 0.0 ? 1 : (Direction.Y < 0.0 ? -1 : 0);
+
+	WalkRayCells(Origin, Direction, MaxDistance, [&](FIntPoint Cell, float ExitDistance)
+	{
+		// A ray heading away from every occupied cell can never hit anything
+		if ((Cell.X > OccupiedBounds.Max.X && StepX >= 0) || (Cell.X < OccupiedBounds.Min.X && StepX <= 0) ||
+			(Cell.Y > OccupiedBounds.Max.Y && StepY >= 0) || (Cell.Y < OccupiedBounds.Min.Y && StepY <= 0))
+		{
+			return true;
+		}
+
+		const TArray<int32>* Bucket = Cells.Find(Cell);
+		return Visitor(Bucket ? TConstArrayView<int32>(*Bucket) : TConstArrayView<int32>(), ExitDistance);
+	});
+}
+
+template<typename VisitorType>
+void FArmaSpatialHash::QueryBox(const FBox2D& Box, VisitorType&& Visitor) const
+{
+	if (!bHasBounds)
+	{
+		return;
+	}
+
+	const FIntPoint MinCell = GetCell(Box.Min);
+	const FIntPoint MaxCell = GetCell(Box.Max);
+	const int32 X0 = FMath::Max(MinCell.X, OccupiedBounds.Min.X);
+	const int32 Y0 = FMath::Max(MinCell.Y, OccupiedBounds.Min.Y);
+	const int32 X1 = FMath::Min(MaxCell.X, OccupiedBounds.Max.X);
+	const int32 Y1 = FMath::Min(MaxCell.Y, OccupiedBounds.Max.Y);
+
+	for (int32 Y = Y0; Y <= Y1; Y++)
+	{
+		for (int32 X = X0; X <= X1; X++)
+		{
+			if (const TArray<int32>* Bucket = Cells.Find(FIntPoint(X, Y)))
+			{
+				Visitor(TConstArrayView<int32>(*Bucket));
+			}
+		}
+	}
+}
@@ -0,0 +1,142 @@
+// ArmaTimingWheel.h - Hierarchical timing wheel for deadlines in game time
+// Scheduling is O(1) and advancing the clock only touches the entries that are due
+// (plus the occasional cascade of a coarser slot), however many are pending
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * TArmaTimingWheel - Four levels of 64 slots, each level 64x coarser than the one below
+ * Level 0 covers the next 64 ticks one tick per slot; when the clock wraps a level,
+ * the next coarser slot is cascaded down. Deadlines beyond the top level's range
+ * park in its furthest slot and are re-filed as the clock approaches them.
+ *
+ * There is no cancel: the owner checks a popped payload against its own state and
+ * ignores stale ones (lazy cancellation), so rescheduling is just another Schedule.
+ */
+template<typename PayloadType>
+class TArmaTimingWheel
+{
+public:
+	explicit TArmaTimingWheel(double InTickSeconds = 1.0 / 64.0)
+		: TickSeconds(InTickSeconds)
+	{}
+
+	// Fire Payload once the clock reaches Time (seconds); past deadlines fire on the next Advance
+	void Schedule(double Time, const PayloadType& Payload)
+	{
+		const uint64 DueTick = FMath::Max(ToTick(Time), CurrentTick + 1);
+		Insert(FEntry{ DueTick, Payload });
+		NumEntries++;
+	}
+
+	// Move the clock to Time, calling OnDue(Payload) for every entry that came due, in tick order
+	template<typename CallbackType>
+	void Advance(double Time, CallbackType&& OnDue)
+	{
+		const uint64 TargetTick = Time <= 0.0 ? 0 : (uint64)FMath::FloorToDouble(Time / TickSeconds);
+		while (CurrentTick < TargetTick)
+		{
+			if (NumEntries == 0)
+			{
+				CurrentTick = TargetTick;
+				return;
+			}
+			CurrentTick++;
+
+			// Wrapped a level: pull the matching coarser slot down, coarsest first
+			for (int32 Level = NumLevels - 1; Level > 0; Level--)
+			{
+				if ((CurrentTick & ((uint64(1) << (LevelBits * Level)) - 1)) == 0)
+				{
+					Cascade(Level, SlotIndex(CurrentTick, Level));
+				}
+			}
+
+			TArray<FEntry>& Due = Slots[0][SlotIndex(CurrentTick, 0)];
+			if (Due.Num() > 0)
+			{
+				TArray<FEntry> Fired = MoveTemp(Due);
+				Due.Reset();
+				NumEntries -= Fired.Num();
+				for (const FEntry& Entry : Fired)
+				{
+					OnDue(Entry.Payload);
+				}
+			}
+		}
+	}
+
+	void Reset()
+	{
+		for (int32 Level = 0; Level < NumLevels; Level++)
+		{
+			for (TArray<FEntry>& Slot : Slots[Level])
+			{
+				Slot.Reset();
+			}
+		}
+		NumEntries = 0;
+	}
+
+	int32 Num() const { return NumEntries; }
+
+private:
+	static constexpr int32 LevelBits = 6;
+	static constexpr int32 SlotsPerLevel = 1 << LevelBits;
+	static constexpr int32 NumLevels = 4;
+
+	struct FEntry
+	{
+		uint64 DueTick;
+		PayloadType Payload;
+	};
+
+	// First tick at or after Time, so nothing fires early
+	uint64 ToTick(double Time) const
+	{
+		return Time <= 0.0 ? 0 : (uint64)FMath::CeilToDouble(Time / TickSeconds);
+	}
+
+	static int32 SlotIndex(uint64 Tick, int32 Level)
+	{
+		return (int32)((Tick >> (LevelBits * Level)) & (SlotsPerLevel - 1));
+	}
+
+	// File an entry in the finest level whose range covers its deadline
+	void Insert(FEntry&& Entry)
+	{
+		const uint64 Delta = Entry.DueTick - CurrentTick;
+		for (int32 Level = 0; Level < NumLevels - 1; Level++)
+		{
+			if (Delta < (uint64(1) << (LevelBits * (Level + 1))))
+			{
+				Slots[Level][SlotIndex(Entry.DueTick, Level)].Add(MoveTemp(Entry));
+				return;
+			}
+		}
+
+		// Top level; anything further out waits in the last slot before the current one
+		const uint64 Range = uint64(1) << (LevelBits * NumLevels);
+		const uint64 FileTick = Delta < Range ? Entry.DueTick : CurrentTick + Range - (uint64(1) << (LevelBits * (NumLevels - 1)));
+		Slots[NumLevels - 1][SlotIndex(FileTick, NumLevels - 1)].Add(MoveTemp(Entry));
+	}
+
+	// Re-file a coarse slot's entries against the current clock
+	void Cascade(int32 Level, int32 Index)
+	{
+		TArray<FEntry> Entries = MoveTemp(Slots[Level][Index]);
+		Slots[Level][Index].Reset();
+		for (FEntry& Entry : Entries)
+		{
+			// An entry due this very tick lands in level 0's current slot, which is processed next
+			Insert(MoveTemp(Entry));
+		}
+	}
+
+	TArray<FEntry> Slots[NumLevels][SlotsPerLevel];
+	uint64 CurrentTick = 0;
+	double TickSeconds;
+	int32 NumEntries = 0;
+};
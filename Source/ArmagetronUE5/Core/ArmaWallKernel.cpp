@@ -0,0 +1,344 @@
+// ArmaWallKernel.cpp - SoA wall store and 4-wide ray kernel
+
+#include "ArmaWallKernel.h"
+#include "Math/VectorRegister.h"
+#include "ArmagetronUE5.h"
+
+//////////////////////////////////////////////////////////////////////////
+// FArmaWallHotStore
+//////////////////////////////////////////////////////////////////////////
+
+void FArmaWallHotStore::WriteLane(int32 Index, float SX, float SY, float EX, float EY, float TO, float CT)
+{
+	StartX[Index] = SX;
+	StartY[Index] = SY;
+	EndX[Index] = EX;
+	EndY[Index] = EY;
+	TypeOwner[Index] = TO;
+	CreationTime[Index] = CT;
+}
+
+int32 FArmaWallHotStore::Add(FVector2D Start, FVector2D End, bool bRim, int32 OwnerTag, float InCreationTime)
+{
+	if (NumWalls == StartX.Num())
+	{
+		// Grow by a whole lane of zero-length padding walls
+		StartX.AddZeroed(LaneWidth);
+		StartY.AddZeroed(LaneWidth);
+		EndX.AddZeroed(LaneWidth);
+		EndY.AddZeroed(LaneWidth);
+		TypeOwner.AddZeroed(LaneWidth);
+		CreationTime.AddZeroed(LaneWidth);
+	}
+
+	const int32 Index = NumWalls++;
+	WriteLane(Index, Start.X, Start.Y, End.X, End.Y, PackTypeOwner(bRim, OwnerTag), InCreationTime);
+	return Index;
+}
+
+void FArmaWallHotStore::SetStart(int32 Index, FVector2D Start)
+{
+	StartX[Index] = Start.X;
+	StartY[Index] = Start.Y;
+}
+
+void FArmaWallHotStore::SetEnd(int32 Index, FVector2D End)
+{
+	EndX[Index] = End.X;
+	EndY[Index] = End.Y;
+}
+
+void FArmaWallHotStore::RemoveAtSwap(int32 Index)
+{
+	const int32 Last = --NumWalls;
+	if (Index != Last)
+	{
+		WriteLane(Index, StartX[Last], StartY[Last], EndX[Last], EndY[Last], TypeOwner[Last], CreationTime[Last]);
+	}
+
+	// The vacated lane becomes padding again
+	WriteLane(Last, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f);
+}
+
+void FArmaWallHotStore::Reset()
+{
+	StartX.Reset();
+	StartY.Reset();
+	EndX.Reset();
+	EndY.Reset();
+	TypeOwner.Reset();
+	CreationTime.Reset();
+	NumWalls = 0;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// ArmaWallKernel
+//////////////////////////////////////////////////////////////////////////
+
+namespace ArmaWallKernel
+{
+	FRay MakeRay(FVector2D Origin, FVector2D NormDir, float MaxDistance,
+		int32 IgnoreOwnerTag, float CurrentTime, float GraceTime, float ParallelTolerance)
+	{
+		FRay Ray;
+		Ray.OriginX = Origin.X;
+		Ray.OriginY = Origin.Y;
+		Ray.DirX = NormDir.X;
+		Ray.DirY = NormDir.Y;
+		Ray.MaxDistance = MaxDistance;
+		if (IgnoreOwnerTag >= 0)
+		{
+			// Both wall types of that owner: OwnerTag*2 (cycle) and OwnerTag*2+1 (rim)
+			Ray.IgnoreLo = FArmaWallHotStore::PackTypeOwner(false, IgnoreOwnerTag);
+			Ray.IgnoreHi = FArmaWallHotStore::PackTypeOwner(true, IgnoreOwnerTag);
+		}
+		Ray.GraceCutoff = CurrentTime - GraceTime;
+		Ray.ParallelTolerance = ParallelTolerance;
+		return Ray;
+	}
+
+	/**
+	 * Test four walls at once
+	 * Returns the lane mask of walls hit closer than Best, and their hit distances in OutDist
+	 */
+	static FORCEINLINE int32 TestLanes(
+		const VectorRegister4Float& SX, const VectorRegister4Float& SY,
+		const VectorRegister4Float& EX, const VectorRegister4Float& EY,
+		const VectorRegister4Float& TO, const VectorRegister4Float& CT,
+		const FRay& Ray, float Best, VectorRegister4Float& OutDist)
+	{
+		const VectorRegister4Float Zero = VectorZero();
+		const VectorRegister4Float One = VectorOne();
+		const VectorRegister4Float MinT = VectorSetFloat1(0.001f);
+		const VectorRegister4Float ParallelEps = VectorSetFloat1(0.0001f);
+		const VectorRegister4Float Dx = VectorSetFloat1(Ray.DirX);
+		const VectorRegister4Float Dy = VectorSetFloat1(Ray.DirY);
+		const VectorRegister4Float Limit = VectorSetFloat1(FMath::Min(Ray.MaxDistance, Best));
+
+		const VectorRegister4Float SegX = VectorSubtract(EX, SX);
+		const VectorRegister4Float SegY = VectorSubtract(EY, SY);
+		const VectorRegister4Float ToStartX = VectorSubtract(SX, VectorSetFloat1(Ray.OriginX));
+		const VectorRegister4Float ToStartY = VectorSubtract(SY, VectorSetFloat1(Ray.OriginY));
+
+		// Walls shorter than 1 unit never block
+		const VectorRegister4Float LenSq = VectorMultiplyAdd(SegX, SegX, VectorMultiply(SegY, SegY));
+		VectorRegister4Float Candidate = VectorCompareGE(LenSq, One);
+
+		// Own walls inside the grace time are skipped
+		const VectorRegister4Float OwnMask = VectorBitwiseAnd(
+			VectorCompareGE(TO, VectorSetFloat1(Ray.IgnoreLo)),
+			VectorCompareLE(TO, VectorSetFloat1(Ray.IgnoreHi)));
+		const VectorRegister4Float GraceMask = VectorBitwiseAnd(OwnMask, VectorCompareGT(CT, VectorSetFloat1(Ray.GraceCutoff)));
+		Candidate = VectorSelect(GraceMask, Zero, Candidate);
+
+		// Ray: Origin + t * Dir, segment: Start + u * Seg
+		const VectorRegister4Float Cross = VectorSubtract(VectorMultiply(Dx, SegY), VectorMultiply(Dy, SegX));
+		const VectorRegister4Float Parallel = VectorCompareLT(VectorAbs(Cross), ParallelEps);
+		const VectorRegister4Float SafeCross = VectorSelect(Parallel, One, Cross);
+
+		const VectorRegister4Float TNum = VectorSubtract(VectorMultiply(ToStartX, SegY), VectorMultiply(ToStartY, SegX));
+		const VectorRegister4Float UNum = VectorSubtract(VectorMultiply(ToStartX, Dy), VectorMultiply(ToStartY, Dx));
+		const VectorRegister4Float T = VectorDivide(TNum, SafeCross);
+		const VectorRegister4Float U = VectorDivide(UNum, SafeCross);
+
+		const VectorRegister4Float CrossHit = VectorBitwiseAnd(
+			VectorBitwiseAnd(VectorCompareGT(T, MinT), VectorCompareLT(T, Limit)),
+			VectorBitwiseAnd(VectorCompareGE(U, Zero), VectorCompareLE(U, One)));
+
+		// Parallel: UNum is the perpendicular offset of the wall start, hit at the start if it is ahead
+		const VectorRegister4Float AlongDist = VectorMultiplyAdd(ToStartX, Dx, VectorMultiply(ToStartY, Dy));
+		const VectorRegister4Float ParallelHit = VectorBitwiseAnd(
+			VectorCompareLT(VectorAbs(UNum), VectorSetFloat1(Ray.ParallelTolerance)),
+			VectorBitwiseAnd(VectorCompareGT(AlongDist, MinT), VectorCompareLT(AlongDist, Limit)));
+
+		const VectorRegister4Float Hit = VectorBitwiseAnd(Candidate, VectorSelect(Parallel, ParallelHit, CrossHit));
+		OutDist = VectorSelect(Parallel, AlongDist, T);
+		return VectorMaskBits(Hit);
+	}
+
+	// Pick the closest lane out of a hit mask
+	static FORCEINLINE void ResolveLanes(int32 Mask, const VectorRegister4Float& Dist, const int32* LaneIndices,
+		float& InOutBest, int32& InOutBestIndex)
+	{
+		float Distances[4];
+		VectorStore(Dist, Distances);
+		for (int32 Lane = 0; Lane < 4; Lane++)
+		{
+			if ((Mask & (1 << Lane)) && Distances[Lane] < InOutBest)
+			{
+				InOutBest = Distances[Lane];
+				InOutBestIndex = LaneIndices[Lane];
+			}
+		}
+	}
+
+	// One group of four walls loaded into registers
+	struct FLaneGroup
+	{
+		VectorRegister4Float SX, SY, EX, EY, TO, CT;
+		int32 Indices[4];
+		int32 ValidMask;	// Lanes that belong to the requested range
+	};
+
+	static FORCEINLINE void LoadContiguous(const FArmaWallHotStore& Store, int32 First, int32 Begin, int32 End, FLaneGroup& Group)
+	{
+		Group.SX = VectorLoad(&Store.StartX[First]);
+		Group.SY = VectorLoad(&Store.StartY[First]);
+		Group.EX = VectorLoad(&Store.EndX[First]);
+		Group.EY = VectorLoad(&Store.EndY[First]);
+		Group.TO = VectorLoad(&Store.TypeOwner[First]);
+		Group.CT = VectorLoad(&Store.CreationTime[First]);
+		Group.ValidMask = 0;
+		for (int32 Lane = 0; Lane < 4; Lane++)
+		{
+			Group.Indices[Lane] = First + Lane;
+			if (First + Lane >= Begin && First + Lane < End)
+			{
+				Group.ValidMask |= 1 << Lane;
+			}
+		}
+	}
+
+	static FORCEINLINE void LoadGathered(const FArmaWallHotStore& Store, const int32* Indices, int32 NumLanes, FLaneGroup& Group)
+	{
+		// Missing lanes stay zero-length and can never hit
+		alignas(16) float SX[4] = {}, SY[4] = {}, EX[4] = {}, EY[4] = {}, TO[4] = {}, CT[4] = {};
+		Group.ValidMask = 0;
+		for (int32 Lane = 0; Lane < 4; Lane++)
+		{
+			Group.Indices[Lane] = INDEX_NONE;
+			if (Lane < NumLanes)
+			{
+				const int32 Index = Indices[Lane];
+				Group.Indices[Lane] = Index;
+				Group.ValidMask |= 1 << Lane;
+				SX[Lane] = Store.StartX[Index];
+				SY[Lane] = Store.StartY[Index];
+				EX[Lane] = Store.EndX[Index];
+				EY[Lane] = Store.EndY[Index];
+				TO[Lane] = Store.TypeOwner[Index];
+				CT[Lane] = Store.CreationTime[Index];
+			}
+		}
+		Group.SX = VectorLoadAligned(SX);
+		Group.SY = VectorLoadAligned(SY);
+		Group.EX = VectorLoadAligned(EX);
+		Group.EY = VectorLoadAligned(EY);
+		Group.TO = VectorLoadAligned(TO);
+		Group.CT = VectorLoadAligned(CT);
+	}
+
+	static FORCEINLINE void TestGroup(const FLaneGroup& Group, TConstArrayView<FRay> Rays,
+		TArrayView<float> InOutBest, TArrayView<int32> InOutBestIndex)
+	{
+		for (int32 RayIndex = 0; RayIndex < Rays.Num(); RayIndex++)
+		{
+			VectorRegister4Float Dist;
+			const int32 Mask = TestLanes(Group.SX, Group.SY, Group.EX, Group.EY, Group.TO, Group.CT,
+				Rays[RayIndex], InOutBest[RayIndex], Dist) & Group.ValidMask;
+			if (Mask)
+			{
+				ResolveLanes(Mask, Dist, Group.Indices, InOutBest[RayIndex], InOutBestIndex[RayIndex]);
+			}
+		}
+	}
+
+	void TestRangeMulti(const FArmaWallHotStore& Store, int32 Begin, int32 End, TConstArrayView<FRay> Rays,
+		TArrayView<float> InOutBest, TArrayView<int32> InOutBestIndex)
+	{
+		INC_DWORD_STAT_BY(STAT_ArmaWallsTested, FMath::Max(End - Begin, 0) * Rays.Num());
+
+		// Start on a lane boundary; lanes outside [Begin, End) are masked off
+		FLaneGroup Group;
+		for (int32 First = Begin & ~(FArmaWallHotStore::LaneWidth - 1); First < End; First += FArmaWallHotStore::LaneWidth)
+		{
+			LoadContiguous(Store, First, Begin, End, Group);
+			TestGroup(Group, Rays, InOutBest, InOutBestIndex);
+		}
+	}
+
+	void TestGatheredMulti(const FArmaWallHotStore& Store, const int32* Indices, int32 Count, TConstArrayView<FRay> Rays,
+		TArrayView<float> InOutBest, TArrayView<int32> InOutBestIndex)
+	{
+		INC_DWORD_STAT_BY(STAT_ArmaWallsTested, Count * Rays.Num());
+
+		FLaneGroup Group;
+		for (int32 Base = 0; Base < Count; Base += FArmaWallHotStore::LaneWidth)
+		{
+			LoadGathered(Store, Indices + Base, FMath::Min(FArmaWallHotStore::LaneWidth, Count - Base), Group);
+			TestGroup(Group, Rays, InOutBest, InOutBestIndex);
+		}
+	}
+
+	void TestRange(const FArmaWallHotStore& Store, int32 Begin, int32 End, const FRay& Ray,
+		float& InOutBest, int32& InOutBestIndex)
+	{
+		TestRangeMulti(Store, Begin, End, MakeArrayView(&Ray, 1), MakeArrayView(&InOutBest, 1), MakeArrayView(&InOutBestIndex, 1));
+	}
+
+	void TestGathered(const FArmaWallHotStore& Store, const int32* Indices, int32 Count, const FRay& Ray,
+		float& InOutBest, int32& InOutBestIndex)
+	{
+		TestGatheredMulti(Store, Indices, Count, MakeArrayView(&Ray, 1), MakeArrayView(&InOutBest, 1), MakeArrayView(&InOutBestIndex, 1));
+	}
+
+	float DistanceInSideCone(FVector2D A, FVector2D B, float Slope)
+	{
+		// Clip t in [0,1] against the two half-planes Lateral * Slope -/+ Forward >= 0
+		double T0 = 0.0;
+		double T1 = 1.0;
+		for (const double Sign : { 1.0, -1.0 })
+		{
+			const double GA = A.Y * Slope - Sign * A.X;
+			const double GB = B.Y * Slope - Sign * B.X;
+			if (GA < 0.0 && GB < 0.0)
+			{
+				return MAX_FLT;
+			}
+			if (GA < 0.0)
+			{
+				T0 = FMath::Max(T0, GA / (GA - GB));
+			}
+			else if (GB < 0.0)
+			{
+				T1 = FMath::Min(T1, GA / (GA - GB));
+			}
+		}
+		if (T0 > T1)
+		{
+			return MAX_FLT;
+		}
+
+		// Closest point of the clipped piece to the origin
+		const FVector2D Seg = B - A;
+		const double LenSq = Seg.SizeSquared();
+		const double T = LenSq > UE_SMALL_NUMBER ? FMath::Clamp(-FVector2D::DotProduct(A, Seg) / LenSq, T0, T1) : T0;
+		return (A + Seg * T).Size();
+	}
+
+	bool ClipSegmentToCircle(FVector2D A, FVector2D B, FVector2D Center, float Radius, double& OutT0, double& OutT1)
+	{
+		// |A + (B - A) t - Center|^2 = Radius^2, solved for t and clamped to the segment
+		const FVector2D Seg = B - A;
+		const FVector2D Rel = A - Center;
+		const double QA = Seg.SizeSquared();
+		const double QC = Rel.SizeSquared() - (double)Radius * Radius;
+		if (QA <= 0.0)
+		{
+			OutT0 = OutT1 = 0.0;
+			return QC <= 0.0;
+		}
+
+		const double HalfB = FVector2D::DotProduct(Rel, Seg);
+		const double Discriminant = HalfB * HalfB - QA * QC;
+		if (Discriminant < 0.0)
+		{
+			return false;
+		}
+
+		const double Root = FMath::Sqrt(Discriminant);
+		OutT0 = FMath::Max((-HalfB - Root) / QA, 0.0);
+		OutT1 = FMath::Min((-HalfB + Root) / QA, 1.0);
+		return OutT0 <= OutT1;
+	}
+}
@@ -0,0 +1,137 @@
+// ArmaWallKernel.h - Structure-of-arrays wall storage and vectorized ray tests
+// The hot store keeps only what a ray test reads (16 bytes of geometry plus
+// owner/type/time); everything else stays in the registry's cold table
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * FArmaWallHotStore - SoA float copy of wall geometry, indexed like the registry's dense array
+ * Arrays are padded to a multiple of 4 with zero-length walls so the kernel can
+ * always load whole lanes without a scalar tail.
+ *
+ * TypeOwner packs the wall type and owner into one float lane:
+ *   OwnerTag * 2 + (bRim ? 1 : 0), OwnerTag 0 = no owner (exact up to 2^23 owners)
+ */
+class ARMAGETRONUE5_API FArmaWallHotStore
+{
+public:
+	static constexpr int32 LaneWidth = 4;
+
+	int32 Add(FVector2D Start, FVector2D End, bool bRim, int32 OwnerTag, float CreationTime);
+	void SetStart(int32 Index, FVector2D Start);
+	void SetEnd(int32 Index, FVector2D End);
+
+	// Swap-remove, mirroring TArray::RemoveAtSwap on the cold table
+	void RemoveAtSwap(int32 Index);
+	void Reset();
+
+	int32 Num() const { return NumWalls; }
+
+	static float PackTypeOwner(bool bRim, int32 OwnerTag) { return (float)(OwnerTag * 2 + (bRim ? 1 : 0)); }
+
+	TArray<float> StartX;
+	TArray<float> StartY;
+	TArray<float> EndX;
+	TArray<float> EndY;
+	TArray<float> TypeOwner;
+	TArray<float> CreationTime;
+
+private:
+	void WriteLane(int32 Index, float SX, float SY, float EX, float EY, float TO, float CT);
+
+	int32 NumWalls = 0;
+};
+
+/**
+ * Vectorized ray-vs-wall tests over the hot store
+ * Semantics match the registry's scalar rules: walls shorter than 1 unit are ignored,
+ * own walls younger than the grace time are ignored, a ray running within
+ * ParallelTolerance of a parallel wall hits that wall's start point.
+ */
+namespace ArmaWallKernel
+{
+	struct FRay
+	{
+		float OriginX = 0.0f;
+		float OriginY = 0.0f;
+		float DirX = 1.0f;			// Normalized
+		float DirY = 0.0f;
+		float MaxDistance = MAX_FLT;
+		float IgnoreLo = -2.0f;		// TypeOwner range of walls subject to the grace time
+		float IgnoreHi = -1.0f;
+		float GraceCutoff = 0.0f;	// Walls in the ignore range created after this are skipped
+		float ParallelTolerance = 5.0f;
+	};
+
+	// OwnerTag < 0 means "no owner to ignore"
+	ARMAGETRONUE5_API FRay MakeRay(FVector2D Origin, FVector2D NormDir, float MaxDistance,
+		int32 IgnoreOwnerTag, float CurrentTime, float GraceTime, float ParallelTolerance);
+
+	// Test walls [Begin, End) of the store, keeping the closest hit below InOutBest
+	ARMAGETRONUE5_API void TestRange(const FArmaWallHotStore& Store, int32 Begin, int32 End, const FRay& Ray,
+		float& InOutBest, int32& InOutBestIndex);
+
+	// Test an arbitrary list of dense indices (gathered from a spatial index)
+	ARMAGETRONUE5_API void TestGathered(const FArmaWallHotStore& Store, const int32* Indices, int32 Count, const FRay& Ray,
+		float& InOutBest, int32& InOutBestIndex);
+
+	/**
+	 * Multi-ray variants: walls are the outer loop, rays the inner loop, so each
+	 * group of four walls is loaded once and tested against every ray.
+	 * InOutBest/InOutBestIndex hold one entry per ray.
+	 */
+	ARMAGETRONUE5_API void TestRangeMulti(const FArmaWallHotStore& Store, int32 Begin, int32 End, TConstArrayView<FRay> Rays,
+		TArrayView<float> InOutBest, TArrayView<int32> InOutBestIndex);
+
+	ARMAGETRONUE5_API void TestGatheredMulti(const FArmaWallHotStore& Store, const int32* Indices, int32 Count, TConstArrayView<FRay> Rays,
+		TArrayView<float> InOutBest, TArrayView<int32> InOutBestIndex);
+
+	// Side cone of the wall acceleration query: cos of the angle from the perpendicular
+	constexpr float SideConeCos = 0.3f;
+
+	/**
+	 * Distance from the origin to the part of segment A->B inside the cone
+	 * { Lateral * Slope >= |Forward| }, with A/B given as (Forward, Lateral) coordinates.
+	 * Returns MAX_FLT if no part of the segment is inside.
+	 */
+	ARMAGETRONUE5_API float DistanceInSideCone(FVector2D A, FVector2D B, float Slope);
+
+	// Stretch of segment A->B inside the circle, as 0 <= OutT0 <= OutT1 <= 1 along it (explosions);
+	// false if the segment misses the circle
+	ARMAGETRONUE5_API bool ClipSegmentToCircle(FVector2D A, FVector2D B, FVector2D Center, float Radius, double& OutT0, double& OutT1);
+
+	// Collects candidate walls from an index and tests them a lane group at a time
+	struct FCandidateBatch
+	{
+		const FArmaWallHotStore& Store;
+		const FRay& Ray;
+		float Best = MAX_FLT;
+		int32 BestIndex = INDEX_NONE;
+		int32 Pending[FArmaWallHotStore::LaneWidth];
+		int32 NumPending = 0;
+
+		FCandidateBatch(const FArmaWallHotStore& InStore, const FRay& InRay)
+			: Store(InStore), Ray(InRay)
+		{}
+
+		void Add(int32 Index)
+		{
+			Pending[NumPending++] = Index;
+			if (NumPending == FArmaWallHotStore::LaneWidth)
+			{
+				Flush();
+			}
+		}
+
+		void Flush()
+		{
+			if (NumPending > 0)
+			{
+				TestGathered(Store, Pending, NumPending, Ray, Best, BestIndex);
+				NumPending = 0;
+			}
+		}
+	};
+}
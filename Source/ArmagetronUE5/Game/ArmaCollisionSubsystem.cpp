@@ -0,0 +1,269 @@
+// ArmaCollisionSubsystem.cpp - World-level collision phase implementation
+
+#include "ArmaCollisionSubsystem.h"
+#include "ArmaCyclePawn.h"
+#include "ArmagetronUE5.h"
+#include "Engine/World.h"
+#include "GameFramework/WorldSettings.h"
+#include "Misc/App.h"
+
+UArmaCollisionSubsystem* UArmaCollisionSubsystem::Get(UWorld* World)
+{
+	if (!World) return nullptr;
+	return World->GetSubsystem<UArmaCollisionSubsystem>();
+}
+
+double UArmaCollisionSubsystem::GetSimTime(const UWorld* World)
+{
+	if (!World) return 0.0;
+
+	const UArmaCollisionSubsystem* Collision = World->GetSubsystem<UArmaCollisionSubsystem>();
+	if (Collision && Collision->bFixedStep && Collision->bHasBegunPlay)
+	{
+		return Collision->StepStartTime + Collision->StepCount * (double)Collision->GetStepTime();
+	}
+	return World->GetTimeSeconds();
+}
+
+double UArmaCollisionSubsystem::GetInputTime(const UWorld* World, double PlatformTime)
+{
+	if (!World) return 0.0;
+
+	double FrameTime = World->GetTimeSeconds();
+	const UArmaCollisionSubsystem* Collision = World->GetSubsystem<UArmaCollisionSubsystem>();
+	if (Collision && Collision->bFixedStep && Collision->bHasBegunPlay)
+	{
+		FrameTime = GetSimTime(World) + Collision->StepAccumulator;
+	}
+
+	// Offset from the frame's start in world seconds, so time dilation applies to it too
+	const AWorldSettings* Settings = World->GetWorldSettings(false, false);
+	const double Dilation = Settings ? Settings->GetEffectiveTimeDilation() : 1.0;
+	const double InputTime = FrameTime + (PlatformTime - FApp::GetCurrentTime()) * Dilation;
+	return FMath::Max(InputTime, GetSimTime(World));
+}
+
+bool UArmaCollisionSubsystem::IsFixedStep(const UWorld* World)
+{
+	const UArmaCollisionSubsystem* Collision = World ? World->GetSubsystem<UArmaCollisionSubsystem>() : nullptr;
+	return Collision && Collision->bFixedStep && Collision->bHasBegunPlay;
+}
+
+void UArmaCollisionSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	FixedStepRate = FMath::Max(FixedStepRate, 10.0f);
+	MaxStepsPerFrame = FMath::Max(MaxStepsPerFrame, 1);
+
+	SimWalls = MakeUnique<FArmaRegistrySimWalls>(GetWorld());
+	SimWorld = MakeUnique<FArmaSimWorld>(*SimWalls);
+
+	PreActorTickHandle = FWorldDelegates::OnWorldPreActorTick.AddUObject(this, &UArmaCollisionSubsystem::OnPreActorTick);
+}
+
+void UArmaCollisionSubsystem::Deinitialize()
+{
+	FWorldDelegates::OnWorldPreActorTick.Remove(PreActorTickHandle);
+	OnSimStep.Clear();
+
+	SimWorld.Reset();
+	SimWalls.Reset();
+
+	Super::Deinitialize();
+}
+
+void UArmaCollisionSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	bHasBegunPlay = true;
+	StepStartTime = InWorld.GetTimeSeconds();
+	StepCount = 0;
+	StepAccumulator = 0.0f;
+}
+
+void UArmaCollisionSubsystem::SetFixedStep(bool bEnable, float StepRate)
+{
+	// Rebase the clock so switching modes never moves simulation time backwards
+	StepStartTime = GetSimTime(GetWorld());
+	StepCount = 0;
+	StepAccumulator = 0.0f;
+
+	bFixedStep = bEnable;
+	FixedStepRate = FMath::Max(StepRate, 10.0f);
+
+	UE_LOG(LogTemp, Log, TEXT("ArmaCollisionSubsystem: Fixed step %s (%.0f Hz)"), bFixedStep ? TEXT("on") : TEXT("off"), FixedStepRate);
+}
+
+void UArmaCollisionSubsystem::StepSimulation(int32 NumSteps)
+{
+	if (!IsFixedStep(GetWorld()))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("ArmaCollisionSubsystem: StepSimulation needs fixed-step mode"));
+		return;
+	}
+
+	for (int32 i = 0; i < NumSteps; i++)
+	{
+		RunStep();
+	}
+}
+
+void UArmaCollisionSubsystem::OnPreActorTick(UWorld* InWorld, ELevelTick TickType, float DeltaTime)
+{
+	if (InWorld != GetWorld() || TickType == LEVELTICK_TimeOnly || InWorld->IsPaused() || !IsFixedStep(InWorld))
+	{
+		return;
+	}
+
+	const float StepTime = GetStepTime();
+	StepAccumulator += DeltaTime;
+
+	int32 Steps = 0;
+	while (StepAccumulator >= StepTime && Steps < MaxStepsPerFrame)
+	{
+		StepAccumulator -= StepTime;
+		RunStep();
+		Steps++;
+	}
+
+	// Too far behind after a hitch - drop the rest instead of stalling the next frames too
+	if (StepAccumulator >= StepTime)
+	{
+		StepAccumulator = FMath::Fmod(StepAccumulator, StepTime);
+	}
+}
+
+void UArmaCollisionSubsystem::RunStep()
+{
+	// The clock reads the end of the step while it runs, as world time does during a frame
+	StepCount++;
+
+	OnSimStep.Broadcast(GetStepTime());
+	RunCollisionPhase(GetStepTime());
+}
+
+TStatId UArmaCollisionSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UArmaCollisionSubsystem, STATGROUP_Tickables);
+}
+
+int32 UArmaCollisionSubsystem::AddCycle(AArmaCyclePawn* Pawn, const FArmaSimCycleParams& Params, FVector2D Position, FVector2D Direction)
+{
+	if (!SimWorld || !Pawn)
+	{
+		return INDEX_NONE;
+	}
+
+	const int32 Cycle = SimWorld->AddCycle(Params);
+	SimWalls->SetOwner(Cycle, Pawn);
+	SpawnCycle(Cycle, Position, Direction);
+	return Cycle;
+}
+
+void UArmaCollisionSubsystem::RemoveCycle(int32 Cycle)
+{
+	if (!SimWorld || !SimWorld->IsValidCycle(Cycle))
+	{
+		return;
+	}
+
+	SimWorld->RemoveCycle(Cycle);
+	SimWalls->SetOwner(Cycle, nullptr);
+}
+
+void UArmaCollisionSubsystem::SpawnCycle(int32 Cycle, FVector2D Position, FVector2D Direction)
+{
+	if (!SimWorld || !SimWorld->IsValidCycle(Cycle))
+	{
+		return;
+	}
+
+	// Between steps the simulation clock may trail the world's
+	SimWorld->SetTime(GetSimTime(GetWorld()));
+	SimWorld->SpawnCycle(Cycle, Position, Direction);
+}
+
+void UArmaCollisionSubsystem::KillCycle(int32 Cycle)
+{
+	if (!SimWorld || !SimWorld->IsValidCycle(Cycle))
+	{
+		return;
+	}
+
+	SimWorld->SetTime(GetSimTime(GetWorld()));
+	SimWorld->Kill(Cycle);
+	DispatchSimEvents();
+}
+
+void UArmaCollisionSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	// In fixed-step mode every step ran its own collision phase before actors ticked
+	if (IsFixedStep(GetWorld()))
+	{
+		return;
+	}
+
+	RunCollisionPhase(DeltaTime);
+}
+
+void UArmaCollisionSubsystem::RunCollisionPhase(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ArmaCollisionPhase);
+	ARMA_TRACE_SCOPE("Arma.CollisionPhase");
+
+	// Walls whose stay-up time ran out are gone before anyone is tested against them
+	UArmaWallRegistry* Registry = UArmaWallRegistry::Get(GetWorld());
+	if (!Registry)
+	{
+		UE_LOG(LogTemp, Error, TEXT("ArmaCollisionSubsystem: No wall registry!"));
+	}
+	else if (SimWalls)
+	{
+		SimWalls->RemoveExpiredWalls();
+	}
+
+	if (SimWorld)
+	{
+		// The step ends on the simulation clock, which has already moved on by DeltaTime
+		SimWorld->SetTime(GetSimTime(GetWorld()) - DeltaTime);
+		SimWorld->Step(DeltaTime);
+
+		DispatchSimEvents();
+
+		// Pawns mirror their cycle for Blueprints, HUD and AI
+		for (int32 Cycle = 0; Cycle < SimWorld->GetNumCycles(); Cycle++)
+		{
+			AArmaCyclePawn* Pawn = SimWorld->IsValidCycle(Cycle) ? SimWalls->GetOwner(Cycle) : nullptr;
+			if (Pawn)
+			{
+				Pawn->SyncFromSim();
+			}
+		}
+	}
+
+	// The step's walls are final now - publish them for next frame's worker tasks
+	if (Registry)
+	{
+		Registry->PublishSnapshot();
+		Registry->TrimHistory();
+	}
+}
+
+void UArmaCollisionSubsystem::DispatchSimEvents()
+{
+	// Pawns may respawn or kill from their handlers, so work on a copy
+	TArray<FArmaSimEvent> Events(SimWorld->GetEvents());
+	SimWorld->ClearEvents();
+
+	for (const FArmaSimEvent& Event : Events)
+	{
+		if (AArmaCyclePawn* Pawn = SimWalls->GetOwner(Event.Cycle))
+		{
+			Pawn->HandleSimEvent(Event);
+		}
+	}
+}
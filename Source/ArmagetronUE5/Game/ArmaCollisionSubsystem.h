@@ -0,0 +1,125 @@
+// ArmaCollisionSubsystem.h - World-level collision phase for all cycles
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ArmaWallRegistry.h"
+#include "ArmaRegistrySimWalls.h"
+#include "Sim/ArmaSimWorld.h"
+#include "ArmaCollisionSubsystem.generated.h"
+
+class AArmaCyclePawn;
+
+// One whole simulation step of the given length
+DECLARE_MULTICAST_DELEGATE_OneParam(FArmaSimStepDelegate, float /*StepTime*/);
+
+/**
+ * UArmaCollisionSubsystem - Steps the cycle simulation for the world
+ * Cycle rules live in an FArmaSimWorld owned here, colliding against the wall registry
+ * through FArmaRegistrySimWalls. Pawns add their cycle at BeginPlay, send it turns and
+ * present what it computed; the simulation steps after every pawn has had its input
+ * hook, so every cycle is tested against the same wall state and resolved in a stable
+ * order. After each step its events (deaths, sparks) go to the pawns, every pawn pulls
+ * its mirrored state, and the registry publishes its wall snapshot.
+ *
+ * With bFixedStep the subsystem also owns the simulation clock: render time is gathered
+ * in an accumulator and, before any actor ticks, the simulation advances in whole steps of
+ * 1 / FixedStepRate. Each step broadcasts OnSimStep (AI thinks and turns), then steps the
+ * simulation and expires walls, so outcomes don't depend on the frame rate and actors' own
+ * Tick only presents the result. StepSimulation runs steps directly, faster than real time.
+ * Without bFixedStep the simulation steps once per frame with the render DeltaTime, after
+ * actors tick.
+ */
+UCLASS(config = Game)
+class ARMAGETRONUE5_API UArmaCollisionSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UArmaCollisionSubsystem* Get(UWorld* World);
+
+	// Simulation time: world time, or whole fixed steps since begin play in fixed-step mode
+	static double GetSimTime(const UWorld* World);
+
+	// Simulation time of input received at PlatformTime (FPlatformTime::Seconds()). The
+	// frame's world time stands for FApp::GetCurrentTime(); input is placed that far from
+	// it on the simulation clock, which in fixed-step mode runs ahead of world time by the
+	// render time not yet stepped. Never earlier than the current simulation time
+	static double GetInputTime(const UWorld* World, double PlatformTime);
+
+	// Whether per-step input goes through OnSimStep instead of actor Tick
+	static bool IsFixedStep(const UWorld* World);
+
+	// Add a pawn's cycle to the simulation and spawn it; returns its cycle index
+	int32 AddCycle(AArmaCyclePawn* Pawn, const FArmaSimCycleParams& Params, FVector2D Position, FVector2D Direction);
+
+	// Remove a cycle and its walls
+	void RemoveCycle(int32 Cycle);
+
+	// Put a cycle back alive at Position with a fresh trail
+	void SpawnCycle(int32 Cycle, FVector2D Position, FVector2D Direction);
+
+	// Kill a cycle now; its pawn presents the death right away
+	void KillCycle(int32 Cycle);
+
+	FArmaSimWorld* GetSimWorld() const { return SimWorld.Get(); }
+
+	// Switch fixed-step mode; the simulation clock carries on from where it is
+	UFUNCTION(BlueprintCallable, Category = "Simulation")
+	void SetFixedStep(bool bEnable, float StepRate = 120.0f);
+
+	// Advance the simulation by whole steps right now, independent of render time
+	void StepSimulation(int32 NumSteps);
+
+	float GetStepTime() const { return 1.0f / FixedStepRate; }
+	int64 GetStepCount() const { return StepCount; }
+
+	// Broadcast once per fixed step, before the simulation steps
+	FArmaSimStepDelegate OnSimStep;
+
+	// Advance the simulation in whole steps instead of once per rendered frame
+	UPROPERTY(Config)
+	bool bFixedStep = false;
+
+	// Steps per second in fixed-step mode
+	UPROPERTY(Config)
+	float FixedStepRate = 120.0f;
+
+	// Most steps run in one frame; a longer hitch is dropped rather than caught up
+	UPROPERTY(Config)
+	int32 MaxStepsPerFrame = 8;
+
+	// USubsystem interface
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	// FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+private:
+	// Gather render time and run the whole steps it covers, before actors tick
+	void OnPreActorTick(UWorld* InWorld, ELevelTick TickType, float DeltaTime);
+
+	// One fixed step: let everyone think, then run the collision phase
+	void RunStep();
+
+	// Expire walls, step the simulation by DeltaTime, present it and publish the wall snapshot
+	void RunCollisionPhase(float DeltaTime);
+
+	// Hand the simulation's events to the pawns
+	void DispatchSimEvents();
+
+	TUniquePtr<FArmaRegistrySimWalls> SimWalls;
+	TUniquePtr<FArmaSimWorld> SimWorld;
+
+	// Simulation clock: StepStartTime + StepCount whole steps, so it never drifts
+	double StepStartTime = 0.0;
+	int64 StepCount = 0;
+	float StepAccumulator = 0.0f;
+	bool bHasBegunPlay = false;
+
+	FDelegateHandle PreActorTickHandle;
+};
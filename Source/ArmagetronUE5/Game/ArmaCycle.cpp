@@ -3,6 +3,7 @@
 #include "ArmaCycle.h"
 #include "ArmaCycleMovement.h"
 #include "ArmaWall.h"
+#include "ArmaCollisionSubsystem.h"
 #include "Core/ArmaGrid.h"
 #include "Components/StaticMeshComponent.h"
 #include "NiagaraComponent.h"
@@ -34,7 +35,7 @@ FCycleMemoryEntry* FCycleMemory::Remember(AArmaCycle* Cycle)
 	// Create new entry
 	FCycleMemoryEntry NewEntry;
 	NewEntry.Cycle = Cycle;
-	NewEntry.Time = Cycle->GetWorld()->GetTimeSeconds();
+	NewEntry.Time = UArmaCollisionSubsystem::GetSimTime(Cycle->GetWorld());
 	Entries.Add(NewEntry);
 	
 	return &Entries.Last();
@@ -151,7 +152,7 @@ void AArmaCycle::BeginPlay()
 {
 	Super::BeginPlay();
 
-	SpawnTime = GetWorld()->GetTimeSeconds();
+	SpawnTime = UArmaCollisionSubsystem::GetSimTime(GetWorld());
 	LastTimeAnim = SpawnTime;
 
 	// Bind to movement component events
@@ -309,7 +310,7 @@ void AArmaCycle::UpdateWallBuilding(float DeltaTime)
 
 	// Update wall end position
 	FVector CurrentPos = GetActorLocation();
-	CurrentWall->UpdateEnd(FArmaCoord(CurrentPos.X, CurrentPos.Y), GetWorld()->GetTimeSeconds());
+	CurrentWall->UpdateEnd(FArmaCoord(CurrentPos.X, CurrentPos.Y), UArmaCollisionSubsystem::GetSimTime(GetWorld()));
 
 	// Check if we should drop wall on turn
 	if (bDropWallRequested)
@@ -378,7 +379,7 @@ void AArmaCycle::KillWithReason(const FString& Reason)
 
 	if (CycleMovement)
 	{
-		CycleMovement->Die(GetWorld()->GetTimeSeconds());
+		CycleMovement->Die(UArmaCollisionSubsystem::GetSimTime(GetWorld()));
 	}
 
 	// Drop wall
@@ -390,6 +391,16 @@ void AArmaCycle::KillWithReason(const FString& Reason)
 	// Spawn explosion
 	// TODO: Spawn explosion actor/particles
 
+	// The blast holes every wall within ExplosionRadius (like gExplosion)
+	if (UArmaGridSubsystem* Grid = GetWorld()->GetSubsystem<UArmaGridSubsystem>())
+	{
+		const FVector Location = GetActorLocation();
+		Grid->ProcessWallsInRange(FArmaCoord(Location.X, Location.Y), ExplosionRadius, [this](AArmaWall* Wall, float BeginDist, float EndDist)
+		{
+			Wall->BlowHole(BeginDist, EndDist, this);
+		});
+	}
+
 	// Broadcast death event
 	OnDeath.Broadcast(Reason);
 }
@@ -437,7 +448,7 @@ bool AArmaCycle::IsVulnerable() const
 		return false;
 
 	// Grace period after spawn
-	float TimeSinceSpawn = GetWorld()->GetTimeSeconds() - SpawnTime;
+	float TimeSinceSpawn = UArmaCollisionSubsystem::GetSimTime(GetWorld()) - SpawnTime;
 	if (TimeSinceSpawn < 0.5f)
 		return false;
 
@@ -3,6 +3,7 @@
 #include "ArmaCycleMovement.h"
 #include "ArmaCycle.h"
 #include "ArmaWall.h"
+#include "ArmaCollisionSubsystem.h"
 #include "Core/ArmaGrid.h"
 #include "Kismet/GameplayStatics.h"
 
@@ -52,6 +53,7 @@ UArmaCycleMovementComponent::UArmaCycleMovementComponent()
 	bRefreshSpaceAhead = true;
 	CachedMaxSpaceAhead = 1000.0f;
 	MaxSpaceMaxCast = 1000.0f;
+	GridFaceHint = -1;
 
 	Gap[0] = Gap[1] = 0.0f;
 	bKeepLookingForGap[0] = bKeepLookingForGap[1] = false;
@@ -73,6 +75,12 @@ void UArmaCycleMovementComponent::BeginPlay()
 
 	InitializeMovement();
 
+	// Fixed-step mode drives the simulation through the collision subsystem
+	if (UArmaCollisionSubsystem* Collision = UArmaCollisionSubsystem::Get(GetWorld()))
+	{
+		SimStepHandle = Collision->OnSimStep.AddUObject(this, &UArmaCycleMovementComponent::SimulateStep);
+	}
+
 	// Get grid subsystem
 	GridSubsystem = GetWorld()->GetSubsystem<UArmaGridSubsystem>();
 
@@ -80,6 +88,16 @@ void UArmaCycleMovementComponent::BeginPlay()
 	OwnerCycle = Cast<AArmaCycle>(GetOwner());
 }
 
+void UArmaCycleMovementComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UArmaCollisionSubsystem* Collision = UArmaCollisionSubsystem::Get(GetWorld()))
+	{
+		Collision->OnSimStep.Remove(SimStepHandle);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
 void UArmaCycleMovementComponent::InitializeMovement()
 {
 	if (AActor* Owner = GetOwner())
@@ -105,10 +123,19 @@ void UArmaCycleMovementComponent::TickComponent(float DeltaTime, ELevelTick Tick
 {
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
+	// In fixed-step mode the collision subsystem calls SimulateStep before actors tick
+	if (!UArmaCollisionSubsystem::IsFixedStep(GetWorld()))
+	{
+		SimulateStep(DeltaTime);
+	}
+}
+
+void UArmaCycleMovementComponent::SimulateStep(float DeltaTime)
+{
 	if (!IsAlive())
 		return;
 
-	float CurrentTime = GetWorld()->GetTimeSeconds();
+	float CurrentTime = UArmaCollisionSubsystem::GetSimTime(GetWorld());
 	
 	// Execute pending turns
 	while (PendingTurns.Num() > 0 && CanMakeTurn(PendingTurns[0]))
@@ -233,7 +260,7 @@ void UArmaCycleMovementComponent::ApplyAcceleration(float DeltaTime)
 		Rubber += RubberUsage * DeltaTime;
 		if (Rubber >= 1.0f && RubberDepleteTime <= 0.0f)
 		{
-			RubberDepleteTime = GetWorld()->GetTimeSeconds();
+			RubberDepleteTime = UArmaCollisionSubsystem::GetSimTime(GetWorld());
 		}
 	}
 }
@@ -251,7 +278,7 @@ float UArmaCycleMovementComponent::GetMaximalSpeed()
 
 bool UArmaCycleMovementComponent::CanMakeTurn(int32 Direction) const
 {
-	return CanMakeTurnAtTime(GetWorld()->GetTimeSeconds(), Direction);
+	return CanMakeTurnAtTime(UArmaCollisionSubsystem::GetSimTime(GetWorld()), Direction);
 }
 
 bool UArmaCycleMovementComponent::CanMakeTurnAtTime(float Time, int32 Direction) const
@@ -333,7 +360,7 @@ bool UArmaCycleMovementComponent::DoTurn(int32 Direction)
 		LastTurnPos = FArmaCoord(Loc.X, Loc.Y);
 	}
 
-	float CurrentTime = GetWorld()->GetTimeSeconds();
+	float CurrentTime = UArmaCollisionSubsystem::GetSimTime(GetWorld());
 	if (Direction > 0)
 		LastTurnTimeLeft = CurrentTime;
 	else
@@ -373,29 +400,32 @@ float UArmaCycleMovementComponent::GetMaxSpaceAhead(float MaxReport) const
 		return FMath::Min(CachedMaxSpaceAhead, MaxReport);
 	}
 
-	// Perform raycast to find distance to nearest wall
+	CachedMaxSpaceAhead = MaxReport;
+
 	if (AActor* Owner = GetOwner())
 	{
 		FVector Start = Owner->GetActorLocation();
-		FVector End = Start + FVector(DirDrive.X, DirDrive.Y, 0.0f) * MaxReport;
+
+		// Walls in the collision grid first: the walk starts at the cycle's last face
+		FArmaCoord GridHit;
+		AArmaWall* GridWall = nullptr;
+		if (CastGridRay(DirDrive, MaxReport, GridHit, GridWall))
+		{
+			CachedMaxSpaceAhead = (GridHit - FArmaCoord(Start.X, Start.Y)).Norm();
+		}
+
+		// Then walls not gridded (growing walls, the rim), only up to the grid's hit
+		FVector End = Start + FVector(DirDrive.X, DirDrive.Y, 0.0f) * CachedMaxSpaceAhead;
 
 		FHitResult HitResult;
 		FCollisionQueryParams QueryParams;
 		QueryParams.AddIgnoredActor(Owner);
 
-		if (GetWorld()->LineTraceSingleByChannel(HitResult, Start, End, ECC_Visibility, QueryParams))
+		if (CachedMaxSpaceAhead > 0.0f && GetWorld()->LineTraceSingleByChannel(HitResult, Start, End, ECC_Visibility, QueryParams))
 		{
-			CachedMaxSpaceAhead = HitResult.Distance;
-		}
-		else
-		{
-			CachedMaxSpaceAhead = MaxReport;
+			CachedMaxSpaceAhead = FMath::Min(CachedMaxSpaceAhead, HitResult.Distance);
 		}
 	}
-	else
-	{
-		CachedMaxSpaceAhead = MaxReport;
-	}
 
 	MaxSpaceMaxCast = MaxReport;
 	bRefreshSpaceAhead = false;
@@ -403,10 +433,23 @@ float UArmaCycleMovementComponent::GetMaxSpaceAhead(float MaxReport) const
 	return FMath::Min(CachedMaxSpaceAhead, MaxReport);
 }
 
+bool UArmaCycleMovementComponent::CastGridRay(const FArmaCoord& Direction, float Range, FArmaCoord& HitPoint, AArmaWall*& HitWall) const
+{
+	HitWall = nullptr;
+
+	AActor* Owner = GetOwner();
+	if (!GridSubsystem || !Owner)
+		return false;
+
+	const FVector Location = Owner->GetActorLocation();
+	const FArmaCoord Start(Location.X, Location.Y);
+	return GridSubsystem->RayCast(Start, Start + Direction * Range, HitPoint, HitWall, GridFaceHint);
+}
+
 bool UArmaCycleMovementComponent::IsVulnerable() const
 {
 	// Check if cycle is in a grace period after spawn
-	float CurrentTime = GetWorld()->GetTimeSeconds();
+	float CurrentTime = UArmaCollisionSubsystem::GetSimTime(GetWorld());
 	// Could add spawn invulnerability here
 	return IsAlive();
 }
@@ -484,7 +527,7 @@ void UArmaCycleMovementComponent::AddDestination()
 	FVector Loc = GetOwner()->GetActorLocation();
 	NewDest.Position = FArmaCoord(Loc.X, Loc.Y);
 	NewDest.Direction = DirDrive;
-	NewDest.GameTime = GetWorld()->GetTimeSeconds();
+	NewDest.GameTime = UArmaCollisionSubsystem::GetSimTime(GetWorld());
 	NewDest.Distance = Distance;
 	NewDest.Speed = CurrentSpeed;
 	NewDest.bBraking = bBraking;
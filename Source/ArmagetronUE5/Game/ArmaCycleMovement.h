@@ -87,8 +87,13 @@ public:
 
 	// UActorComponent interface
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 
+	// Turns, timestep and the owner's move for one step - from TickComponent with the
+	// render DeltaTime, or from UArmaCollisionSubsystem::OnSimStep in fixed-step mode
+	void SimulateStep(float DeltaTime);
+
 	//////////////////////////////////////////////////////////////////////////
 	// Speed System - Port from gCycleMovement
 	//////////////////////////////////////////////////////////////////////////
@@ -179,6 +184,9 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Cycle|Rubber")
 	float GetMaxSpaceAhead(float MaxReport) const;
 
+	// Ray cast through the collision grid from the cycle, starting the walk at its last grid face
+	bool CastGridRay(const FArmaCoord& Direction, float Range, FArmaCoord& HitPoint, AArmaWall*& HitWall) const;
+
 	//////////////////////////////////////////////////////////////////////////
 	// Braking System - Port from gCycleMovement
 	//////////////////////////////////////////////////////////////////////////
@@ -387,6 +395,9 @@ protected:
 	mutable float CachedMaxSpaceAhead;
 	mutable float MaxSpaceMaxCast;
 
+	// Grid face the cycle was last found in; grid walks start here (usually zero or one step away)
+	mutable int32 GridFaceHint;
+
 	// Gap detection for squeezing through walls
 	mutable float Gap[2];
 	mutable bool bKeepLookingForGap[2];
@@ -407,6 +418,8 @@ protected:
 	UPROPERTY()
 	AArmaCycle* OwnerCycle;
 
+	FDelegateHandle SimStepHandle;
+
 	// Initialize internal state
 	void InitializeMovement();
 };
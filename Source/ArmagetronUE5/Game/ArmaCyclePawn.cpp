@@ -2,6 +2,8 @@
 
 #include "ArmaCyclePawn.h"
 #include "ArmaWallRegistry.h"
+#include "ArmaTestGameMode.h"
+#include "ArmagetronUE5.h"
 #include "Components/StaticMeshComponent.h"
 #include "Components/BoxComponent.h"
 #include "GameFramework/SpringArmComponent.h"
@@ -88,18 +90,17 @@ void AArmaCyclePawn::BeginPlay()
 {
 	Super::BeginPlay();
 
-	GameStartTime = GetWorld()->GetTimeSeconds();
+	GameStartTime = UArmaCollisionSubsystem::GetSimTime(GetWorld());
+
+	// Fixed-step mode drives the simulation through the collision subsystem
+	if (UArmaCollisionSubsystem* Collision = UArmaCollisionSubsystem::Get(GetWorld()))
+	{
+		SimStepHandle = Collision->OnSimStep.AddUObject(this, &AArmaCyclePawn::SimulateStep);
+	}
 	
 	// Initialize spawn values
 	SpawnLocation = GetActorLocation();
 	SpawnDirection = MoveDirection;
-	SpawnTime = GameStartTime;
-	CurrentRubber = MaxRubber;
-	MoveSpeed = BaseSpeed;
-	
-	// Allow immediate first turn after spawn (set LastTurnTime in the past)
-	LastTurnTime = GameStartTime - TurnDelay;
-	LastTurnPosition = SpawnLocation;  // Initialize turn position for dig mechanic
 
 	UE_LOG(LogTemp, Warning, TEXT("BeginPlay: CycleMesh=%s, Location=%s"), 
 		CycleMesh ? TEXT("Valid") : TEXT("NULL"),
@@ -130,8 +131,16 @@ void AArmaCyclePawn::BeginPlay()
 	// Spawn the glossy black grid floor
 	SpawnFloorGrid();
 
-	// Start first wall segment
-	StartNewWallSegment();
+	// Our cycle joins the simulation here and starts its first wall segment
+	if (UArmaCollisionSubsystem* Collision = UArmaCollisionSubsystem::Get(GetWorld()))
+	{
+		SimCycle = Collision->AddCycle(this, MakeSimParams(), FVector2D(SpawnLocation.X, SpawnLocation.Y), FVector2D(SpawnDirection.X, SpawnDirection.Y));
+		SyncFromSim();
+	}
+	else
+	{
+		UE_LOG(LogTemp, Error, TEXT("NO COLLISION SUBSYSTEM!"));
+	}
 
 	// Show controls
 	if (GEngine)
@@ -426,400 +435,203 @@ void AArmaCyclePawn::SpawnAmbientLighting()
 	UE_LOG(LogTemp, Warning, TEXT("SpawnAmbientLighting: Created directional, sky, and ambient point lights"));
 }
 
-void AArmaCyclePawn::Tick(float DeltaTime)
+void AArmaCyclePawn::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-	Super::Tick(DeltaTime);
-	
-	// ========== PROCESS PENDING TURNS (like original gCycleMovement::Timestep) ==========
-	// Execute queued turns when their time has come
-	if (bIsAlive)
+	if (UArmaCollisionSubsystem* Collision = UArmaCollisionSubsystem::Get(GetWorld()))
 	{
-		ProcessPendingTurns();
-	}
+		Collision->OnSimStep.Remove(SimStepHandle);
 
-	// ========== IMMEDIATE BOUNDARY ENFORCEMENT ==========
-	// This runs EVERY tick to catch any escaped cycles (failsafe)
-	const float HardBoundary = 4950.0f;
-	FVector CurrentPos = GetActorLocation();
-	bool bNeedsTeleport = false;
-	
-	if (FMath::Abs(CurrentPos.X) > HardBoundary || FMath::Abs(CurrentPos.Y) > HardBoundary)
-	{
-		// Cycle is outside arena - clamp it back inside
-		CurrentPos.X = FMath::Clamp(CurrentPos.X, -HardBoundary, HardBoundary);
-		CurrentPos.Y = FMath::Clamp(CurrentPos.Y, -HardBoundary, HardBoundary);
-		SetActorLocation(CurrentPos);
-		bNeedsTeleport = true;
-		
-		UE_LOG(LogTemp, Error, TEXT("BOUNDARY VIOLATION! Cycle was outside arena, clamped to (%.1f, %.1f)"), 
-			CurrentPos.X, CurrentPos.Y);
-		
-		// If we were way outside, probably a bug - kill the cycle
-		if (FMath::Abs(GetActorLocation().X) > 10000.0f || FMath::Abs(GetActorLocation().Y) > 10000.0f)
+		// A destroyed cycle takes its walls along; on world teardown they go with the world
+		if (EndPlayReason == EEndPlayReason::Destroyed)
 		{
-			if (bIsAlive && IsVulnerable())
-			{
-				UE_LOG(LogTemp, Error, TEXT("*** DEATH! Cycle escaped arena boundary ***"));
-				Die();
-			}
+			Collision->RemoveCycle(SimCycle);
 		}
 	}
+	SimCycle = INDEX_NONE;
 
-	// If menu is open, only draw menu
-	if (bMenuOpen)
-	{
-		DrawMenu();
-		return;
-	}
+	Super::EndPlay(EndPlayReason);
+}
 
-	if (!bIsAlive) 
-	{
-		// When dead, just update camera and HUD
-		UpdateCamera(DeltaTime);
-		DrawHUD();
-		return;
-	}
-	
-	// Update invulnerability blink effect
-	UpdateInvulnerabilityBlink();
+void AArmaCyclePawn::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
 
-	// ========== ARMAGETRON-STYLE SPEED DECAY ==========
-	// Speed naturally decays toward base speed
-	float SpeedDiff = BaseSpeed - MoveSpeed;
-	if (MoveSpeed < BaseSpeed)
-	{
-		MoveSpeed += SpeedDiff * SpeedDecayBelow * DeltaTime;
-	}
-	else if (MoveSpeed > BaseSpeed)
+	// In fixed-step mode the collision subsystem steps the simulation (OnSimStep) before
+	// actors tick; otherwise it advances by this frame's DeltaTime
+	if (!UArmaCollisionSubsystem::IsFixedStep(GetWorld()))
 	{
-		MoveSpeed += SpeedDiff * SpeedDecayAbove * DeltaTime;
+		SimulateStep(DeltaTime);
 	}
-	MoveSpeed = FMath::Clamp(MoveSpeed, 100.0f, MaxSpeed);
 
-	// Update wall proximity acceleration (speed boost near walls)
-	UpdateWallAcceleration(DeltaTime);
+	UpdatePresentation(DeltaTime);
+}
 
-	// Update rubber regeneration
-	UpdateRubber(DeltaTime);
-	
-	// Update wall decay (remove old walls when exceeding max length)
-	UpdateWallDecay();
+void AArmaCyclePawn::SimulateStep(float DeltaTime)
+{
+	// The player's input arrives through key bindings - nothing to do per step
+}
 
-	// ========== COLLISION CHECK BEFORE MOVING (Armagetron Style) ==========
-	// Key insight: Check where we WOULD end up, and if we'd hit a wall, stop there
-	// Now uses GLOBAL wall registry so we detect ALL walls (player, AI, and rim)
-	FVector2D MyPos2D(GetActorLocation().X, GetActorLocation().Y);
-	FVector2D MyDir2D(MoveDirection.X, MoveDirection.Y);
-	
-	// EMERGENCY BOUNDARY CHECK - If somehow outside arena, teleport back NOW
-	const float EmergencyBoundary = 5500.0f;
-	if (FMath::Abs(MyPos2D.X) > EmergencyBoundary || FMath::Abs(MyPos2D.Y) > EmergencyBoundary)
-	{
-		UE_LOG(LogTemp, Error, TEXT("!!! EMERGENCY TELEPORT !!! Cycle at (%.1f, %.1f) - forcing to origin!"), 
-			MyPos2D.X, MyPos2D.Y);
-		SetActorLocation(FVector(0, 0, 92.0f));
-		MoveDirection = FVector(1, 0, 0);
-		MoveSpeed = BaseSpeed;
-		MyPos2D = FVector2D(0, 0);
-		MyDir2D = FVector2D(1, 0);
-	}
-	
-	float DesiredMoveDistance = MoveSpeed * DeltaTime;
-	const float WallGracePeriod = 0.3f;
-	
-	// Use global wall registry for collision detection
-	UArmaWallRegistry* WallRegistry = UArmaWallRegistry::Get(GetWorld());
-	FArmaRegisteredWall HitWallInfo;
-	float ClosestHitDist = MAX_FLT;
-	float WallSide = 0.0f;  // Which side of the wall we're on
-	
-	if (WallRegistry)
-	{
-		// Query registry for all walls (including AI and rim walls)
-		// Pass ourselves as ignore owner with grace period for our own walls
-		ClosestHitDist = WallRegistry->RaycastWalls(
-			MyPos2D, 
-			MyDir2D, 
-			DesiredMoveDistance + 50.0f, 
-			this,  // Ignore our own recent walls
-			WallGracePeriod, 
-			HitWallInfo,
-			WallSide  // Get which side of the wall we're on
-		);
-		
-		// Debug logging for collision detection
-		static int LogCounter = 0;
-		if (LogCounter++ % 60 == 0)  // Log every 60 frames
-		{
-			int32 TotalWalls = WallRegistry->GetWallCount();
-			UE_LOG(LogTemp, Display, TEXT("COLLISION CHECK: Pos=(%.1f,%.1f) Dir=(%.2f,%.2f) HitDist=%.1f TotalWalls=%d WallType=%s"),
-				MyPos2D.X, MyPos2D.Y, MyDir2D.X, MyDir2D.Y, ClosestHitDist, TotalWalls,
-				HitWallInfo.WallType == EArmaWallType::Rim ? TEXT("RIM") : TEXT("CYCLE"));
-		}
-	}
-	else
-	{
-		UE_LOG(LogTemp, Error, TEXT("NO WALL REGISTRY!"));
-	}
-	
-	DistanceToWall = ClosestHitDist;
-	
-	// Check if we're in the turn grace period (needed for wall side tracking)
-	float CurrentTime = GetWorld()->GetTimeSeconds();
-	bool bInTurnGrace = (CurrentTime - LastTurnTime) < TurnGracePeriod;
-	
-	// ========== WALL SIDE TRACKING (prevent going through walls) ==========
-	// Track which side of the wall we're on to prevent crossing through when turning quickly
-	bool bHitWall = (ClosestHitDist < MAX_FLT);
-	
-	if (bHitWall && HitWallInfo.WallID != 0)
-	{
-		// If we're tracking a different wall, update our side tracking
-		if (CurrentWallID != HitWallInfo.WallID)
-		{
-			CurrentWallID = HitWallInfo.WallID;
-			CurrentWallSide = WallSide;
-		}
-		else
-		{
-			// Same wall - check if we're trying to cross to the other side
-			// If side signs are different, we're crossing through the wall
-			bool bCrossingWall = (CurrentWallSide * WallSide < 0.0f);
-			
-			if (bCrossingWall && IsVulnerable() && !bInTurnGrace)
-			{
-				// Trying to go through the wall - prevent it unless invulnerable or in turn grace
-				UE_LOG(LogTemp, Warning, TEXT("BLOCKED: Trying to cross through wall %d (side %.1f -> %.1f)"), 
-					HitWallInfo.WallID, CurrentWallSide, WallSide);
-				
-				// Block movement - treat as wall collision
-				ClosestHitDist = 0.0f;
-				bHitWall = true;
-			}
-			else
-			{
-				// Update side tracking (we're staying on same side or allowed to cross)
-				CurrentWallSide = WallSide;
-			}
-		}
-	}
-	else if (!bHitWall)
-	{
-		// No wall hit - clear side tracking
-		CurrentWallID = 0;
-		CurrentWallSide = 0.0f;
-	}
-	
-	// ========== MOVEMENT WITH COLLISION RESPONSE ==========
-	float ActualMoveDistance = DesiredMoveDistance;
-	
-	// bInTurnGrace already calculated above for wall side tracking
-	
-	// ========== PERFECT TURN PROTECTION (sg_rubberCycleMinAdjust from original) ==========
-	// When adjusting to a wall after a turn, allow getting closer by at least RubberMinAdjust percentage
-	// Formula from original: maxStop = (distSinceLastTurn + space) * (1 - sg_rubberCycleMinAdjust)
-	// This is the key mechanic for "digging" - right after a turn, minimum distance is drastically reduced
-	float DistSinceTurn = GetDistanceSinceLastTurn();
-	float EffectiveMinDistance;
-	
-	if (bInTurnGrace || DistSinceTurn < 50.0f)  // Within 50 units of last turn = recently turned
+FArmaSimWorld* AArmaCyclePawn::GetSimWorld() const
+{
+	UArmaCollisionSubsystem* Collision = UArmaCollisionSubsystem::Get(GetWorld());
+	return Collision ? Collision->GetSimWorld() : nullptr;
+}
+
+FVector2D AArmaCyclePawn::GetSimLocation() const
+{
+	const FArmaSimWorld* Sim = GetSimWorld();
+	if (Sim && Sim->IsValidCycle(SimCycle))
 	{
-		// Calculate dynamic minimum distance based on distance since last turn
-		// The closer we are to the turn point, the closer we're allowed to get to walls
-		// This is the "dig" mechanic - perfect turns let you squeeze through tiny gaps
-		float MaxStop = (DistSinceTurn + ClosestHitDist) * (1.0f - RubberMinAdjust);
-		EffectiveMinDistance = FMath::Max(0.1f, FMath::Min(MaxStop, MinWallDistance));
-		
-		// For VERY recent turns (within first few units), give extra leniency
-		// This handles the "pixel perfect" case where you turn exactly at the wall
-		if (DistSinceTurn < 5.0f)
-		{
-			EffectiveMinDistance = 0.01f;  // Almost no minimum - you just turned into this!
-			UE_LOG(LogTemp, Verbose, TEXT("PERFECT TURN PROTECTION: DistSinceTurn=%.1f, EffMinDist=%.3f"), 
-				DistSinceTurn, EffectiveMinDistance);
-		}
+		return Sim->GetCycle(SimCycle).Position;
 	}
-	else
+	return FVector2D(GetActorLocation().X, GetActorLocation().Y);
+}
+
+FArmaSimCycleParams AArmaCyclePawn::MakeSimParams() const
+{
+	FArmaSimCycleParams Params;
+	Params.BaseSpeed = BaseSpeed;
+	Params.MaxSpeed = MaxSpeed;
+	Params.TurnSpeedFactor = TurnSpeedFactor;
+	Params.SpeedDecayBelow = SpeedDecayBelow;
+	Params.SpeedDecayAbove = SpeedDecayAbove;
+	Params.TurnDelay = TurnDelay;
+	Params.TurnMemory = TurnMemory;
+	Params.MaxRubber = MaxRubber;
+	Params.MinWallDistance = MinWallDistance;
+	Params.RubberMinAdjust = RubberMinAdjust;
+	Params.TurnGracePeriod = TurnGracePeriod;
+	Params.DiggingRubberMultiplier = DiggingRubberMultiplier;
+	Params.WallAcceleration = WallAcceleration;
+	Params.WallAccelDistance = WallAccelDistance;
+	Params.WallAccelOffset = WallAccelOffset;
+	Params.SlingshotMultiplier = SlingshotMultiplier;
+	Params.SpawnInvulnerabilityTime = SpawnInvulnerabilityTime;
+	Params.MaxWallsLength = MaxWallsLength;
+	Params.WallsStayUpDelay = WallsStayUpDelay;
+	Params.ExplosionRadius = ExplosionRadius;
+	return Params;
+}
+
+void AArmaCyclePawn::PushSimParams()
+{
+	FArmaSimWorld* Sim = GetSimWorld();
+	if (!Sim || !Sim->IsValidCycle(SimCycle))
 	{
-		// Normal operation - use standard minimum distance
-		EffectiveMinDistance = MinWallDistance;
+		return;
 	}
-	
-	// Would we hit a wall this frame?
-	if (bHitWall && ClosestHitDist < DesiredMoveDistance + EffectiveMinDistance)
+
+	Sim->SetParams(SimCycle, MakeSimParams());
+
+	// The mirrors only differ from the cycle where a slider just moved them
+	FArmaSimCycle& Cycle = Sim->GetCycle(SimCycle);
+	if (Cycle.bAlive)
 	{
-		bIsGrinding = true;
-		
-		// How far past the safe distance would we go?
-		float SafeDistance = ClosestHitDist - EffectiveMinDistance;
-		
-		if (SafeDistance < 0)
-		{
-			// We're already too close or would end up inside the wall
-			if (CurrentRubber > 0)
-			{
-				// Use rubber to survive - stay at minimum distance
-				// During grace period, use MUCH less rubber (digging is cheaper)
-				float RubberMultiplier = bInTurnGrace ? 0.1f : 2.0f;
-				float RubberNeeded = FMath::Abs(SafeDistance) * RubberMultiplier;
-				CurrentRubber = FMath::Max(0.0f, CurrentRubber - RubberNeeded);
-				
-				// During grace period, allow SOME movement even when close
-				// This is key to the dig mechanic - you can squeeze through
-				ActualMoveDistance = bInTurnGrace ? DesiredMoveDistance * 0.5f : 0.0f;
-				
-				// Sparks
-				if (ClosestHitDist < 30.0f)
-				{
-					FVector2D HitPoint = MyPos2D + MyDir2D * ClosestHitDist;
-					SpawnSpark(FVector(HitPoint.X, HitPoint.Y, GetActorLocation().Z), 
-						FVector(-MoveDirection.X, -MoveDirection.Y, 0));
-				}
-			}
-			else if (IsVulnerable() && !bInTurnGrace)
-			{
-				// No rubber, wall collision = death (but not during turn grace)
-				UE_LOG(LogTemp, Error, TEXT("*** DEATH! Hit wall, no rubber, dist=%.1f ***"), ClosestHitDist);
-				Die();
-				return;
-			}
-			else if (bInTurnGrace)
-			{
-				// During turn grace with no rubber, allow movement but slower
-				ActualMoveDistance = DesiredMoveDistance * 0.3f;
-				UE_LOG(LogTemp, Warning, TEXT("Turn grace: Allowing movement despite close wall (dist=%.1f)"), ClosestHitDist);
-			}
-		}
-		else if (SafeDistance < DesiredMoveDistance)
-		{
-			// We can move some, but not the full distance
-			if (CurrentRubber > 0)
-			{
-				float Overshoot = DesiredMoveDistance - SafeDistance;
-				float RubberMultiplier = bInTurnGrace ? 0.1f : 0.3f;
-				float RubberNeeded = Overshoot * RubberMultiplier;
-				CurrentRubber = FMath::Max(0.0f, CurrentRubber - RubberNeeded);
-				ActualMoveDistance = SafeDistance;  // Stop at safe distance
-				
-				if (ClosestHitDist < 30.0f)
-				{
-					FVector2D HitPoint = MyPos2D + MyDir2D * ClosestHitDist;
-					SpawnSpark(FVector(HitPoint.X, HitPoint.Y, GetActorLocation().Z), 
-						FVector(-MoveDirection.X, -MoveDirection.Y, 0));
-				}
-			}
-			else if (IsVulnerable() && SafeDistance <= 0 && !bInTurnGrace)
-			{
-				UE_LOG(LogTemp, Error, TEXT("*** DEATH! Would hit wall, no rubber ***"));
-				Die();
-				return;
-			}
-			else
-			{
-				ActualMoveDistance = FMath::Max(0.0f, SafeDistance);
-			}
-		}
+		Cycle.Speed = MoveSpeed;
 	}
-	else
+	Cycle.Rubber = FMath::Min(CurrentRubber, MaxRubber);
+}
+
+void AArmaCyclePawn::SetSimSpeed(float Speed)
+{
+	MoveSpeed = Speed;
+
+	FArmaSimWorld* Sim = GetSimWorld();
+	if (Sim && Sim->IsValidCycle(SimCycle))
 	{
-		bIsGrinding = false;
+		Sim->GetCycle(SimCycle).Speed = Speed;
 	}
-	
-	// ========== ACTUALLY MOVE (clamped to safe distance) ==========
-	FVector DesiredMove = MoveDirection * ActualMoveDistance;
-	FVector NewLocation = GetActorLocation() + DesiredMove;
-	
-	// HARD BOUNDARY CLAMP - Failsafe to prevent escaping arena
-	// This catches any edge cases where raycast collision might miss
-	const float ArenaHalfSize = 4950.0f;  // Slightly inside the 5000 rim
-	bool bWasOutside = false;
-	
-	if (NewLocation.X > ArenaHalfSize)
+}
+
+void AArmaCyclePawn::SyncFromSim()
+{
+	const FArmaSimWorld* Sim = GetSimWorld();
+	if (!Sim || !Sim->IsValidCycle(SimCycle))
 	{
-		NewLocation.X = ArenaHalfSize;
-		bWasOutside = true;
+		return;
 	}
-	else if (NewLocation.X < -ArenaHalfSize)
+
+	const FArmaSimCycle& Cycle = Sim->GetCycle(SimCycle);
+	const float Z = GetActorLocation().Z;
+
+	MoveSpeed = Cycle.Speed;
+	CurrentRubber = Cycle.Rubber;
+	bIsGrinding = Cycle.bGrinding;
+	DistanceToWall = Cycle.DistanceToWall;
+	CurrentWallSide = Cycle.WallSide;
+	LastTurnTime = (float)Cycle.LastTurnTime;
+	LastTurnPosition = FVector(Cycle.LastTurnPosition, Z);
+	GapLeft = Cycle.GapLeft;
+	GapRight = Cycle.GapRight;
+	SpawnTime = (float)Cycle.SpawnTime;
+	TotalWallLength = Cycle.TotalWallLength;
+	bIsAlive = Cycle.bAlive;
+	MoveDirection = FVector(Cycle.Direction, 0.0f);
+}
+
+void AArmaCyclePawn::HandleSimEvent(const FArmaSimEvent& Event)
+{
+	const float Z = GetActorLocation().Z;
+
+	if (Event.Type == FArmaSimEvent::EType::Spark)
 	{
-		NewLocation.X = -ArenaHalfSize;
-		bWasOutside = true;
+		SpawnSpark(FVector(Event.Position, Z), FVector(Event.Direction, 0.0f));
+		return;
 	}
-	
-	if (NewLocation.Y > ArenaHalfSize)
+
+	static const TCHAR* CauseNames[] = { TEXT("killed"), TEXT("hit a wall"), TEXT("touched a wall") };
+	UE_LOG(LogTemp, Error, TEXT("CYCLE DIED (%s)! Round %d, Deaths: %d"), CauseNames[(int32)Event.Cause], CurrentRound, DeathCount + 1);
+
+	bIsAlive = false;
+	DeathCount++;
+	MoveSpeed = 0.0f;
+	SetActorLocation(FVector(Event.Position, Z));
+
+	// Hide cycle mesh
+	if (CycleMesh)
 	{
-		NewLocation.Y = ArenaHalfSize;
-		bWasOutside = true;
+		CycleMesh->SetVisibility(false);
 	}
-	else if (NewLocation.Y < -ArenaHalfSize)
+
+	// Spawn explosion effect (simple flash for now); the simulation blew the wall holes (ExplosionRadius)
+	if (CycleGlowLight)
 	{
-		NewLocation.Y = -ArenaHalfSize;
-		bWasOutside = true;
+		CycleGlowLight->SetIntensity(500000.0f); // Bright flash
+		CycleGlowLight->SetLightColor(FColor::Red);
 	}
-	
-	// If we hit the boundary and have no rubber, die
-	if (bWasOutside && CurrentRubber <= 0 && IsVulnerable())
+}
+
+void AArmaCyclePawn::UpdatePresentation(float DeltaTime)
+{
+	// If menu is open, only draw menu
+	if (bMenuOpen)
 	{
-		UE_LOG(LogTemp, Error, TEXT("*** DEATH! Hit arena boundary ***"));
-		Die();
+		DrawMenu();
 		return;
 	}
-	else if (bWasOutside)
+
+	if (!bIsAlive) 
 	{
-		// Use rubber to survive boundary collision
-		CurrentRubber = FMath::Max(0.0f, CurrentRubber - 10.0f);
+		// When dead, just update camera and HUD
+		UpdateCamera(DeltaTime);
+		DrawHUD();
+		return;
 	}
 	
-	SetActorLocation(NewLocation);
-
-	// ========== POST-MOVEMENT COLLISION CHECK (Safety Net) ==========
-	// Check if we're now too close to any wall (catches edge cases)
-	if (WallRegistry && bIsAlive)
+	// Follow the simulated cycle
+	if (const FArmaSimWorld* Sim = GetSimWorld())
 	{
-		FVector2D FinalPos2D(NewLocation.X, NewLocation.Y);
-		FArmaRegisteredWall NearbyWall;
-		
-		// Check in all 4 cardinal directions for nearby walls
-		FVector2D Directions[4] = {
-			FVector2D(1, 0), FVector2D(-1, 0), FVector2D(0, 1), FVector2D(0, -1)
-		};
-		
-		for (const FVector2D& CheckDir : Directions)
+		if (Sim->IsValidCycle(SimCycle))
 		{
-			float DummySide = 0.0f;
-			float NearbyDist = WallRegistry->RaycastWalls(
-				FinalPos2D, CheckDir, MinWallDistance * 2.0f, 
-				this, WallGracePeriod, NearbyWall, DummySide);
-			
-			if (NearbyDist < MinWallDistance && NearbyWall.WallType != EArmaWallType::Cycle)
-			{
-				// Too close to a rim wall - use rubber or die
-				if (CurrentRubber > 0)
-				{
-					CurrentRubber = FMath::Max(0.0f, CurrentRubber - 5.0f);
-				}
-				else if (IsVulnerable() && !bInTurnGrace)
-				{
-					UE_LOG(LogTemp, Error, TEXT("*** DEATH! Post-move collision check failed ***"));
-					Die();
-					return;
-				}
-			}
-			else if (NearbyDist < 1.0f && NearbyWall.OwnerActor != this)
-			{
-				// Extremely close to someone else's wall - definitely collision
-				if (CurrentRubber > 0)
-				{
-					CurrentRubber = FMath::Max(0.0f, CurrentRubber - 20.0f);
-				}
-				else if (IsVulnerable())
-				{
-					UE_LOG(LogTemp, Error, TEXT("*** DEATH! Inside another cycle's wall ***"));
-					Die();
-					return;
-				}
-			}
+			const FArmaSimCycle& Cycle = Sim->GetCycle(SimCycle);
+			SetActorLocation(FVector(Cycle.Position, GetActorLocation().Z));
+			TargetPawnYaw = FVector(Cycle.Direction, 0.0f).Rotation().Yaw;
 		}
 	}
+	UpdateCurrentWall();
+
+	// Update invulnerability blink effect
+	UpdateInvulnerabilityBlink();
 
 	// Smoothly rotate pawn to face movement direction
 	float DeltaYaw = FMath::FindDeltaAngleDegrees(CurrentPawnYaw, TargetPawnYaw);
@@ -834,9 +646,6 @@ void AArmaCyclePawn::Tick(float DeltaTime)
 	
 	SetActorRotation(FRotator(0, CurrentPawnYaw, 0));
 
-	// Update the current wall segment
-	UpdateCurrentWall();
-
 	// Update camera to follow bike rotation
 	UpdateCamera(DeltaTime);
 
@@ -869,9 +678,12 @@ void AArmaCyclePawn::DrawHUD()
 {
 	if (GEngine)
 	{
+		const FArmaSimWorld* Sim = GetSimWorld();
+		const int32 WallCount = (Sim && Sim->IsValidCycle(SimCycle)) ? Sim->GetTrail(SimCycle).Num() : 0;
+
 		// Show wall count with collision info
 		GEngine->AddOnScreenDebugMessage(-1, 0.0f, FColor::Magenta,
-			FString::Printf(TEXT("WALLS: %d (Collision Active) | ESC=Menu | Rubber: %.0f"), WallActors.Num(), CurrentRubber));
+			FString::Printf(TEXT("WALLS: %d (Collision Active) | ESC=Menu | Rubber: %.0f"), WallCount, CurrentRubber));
 		
 		// Round and status
 		FString StatusStr = bIsAlive ? (IsVulnerable() ? TEXT("ALIVE") : TEXT("INVULNERABLE")) : TEXT("DEAD");
@@ -961,282 +773,45 @@ bool AArmaCyclePawn::CanMakeTurn() const
 {
 	// ========== TURN DELAY (sg_delayCycle from original Armagetron) ==========
 	// Returns true if enough time has passed since the last turn AND no pending turns
-	float CurrentTime = GetWorld()->GetTimeSeconds();
-	return PendingTurns.Num() == 0 && (CurrentTime - LastTurnTime) >= TurnDelay;
+	const FArmaSimWorld* Sim = GetSimWorld();
+	return Sim && Sim->IsValidCycle(SimCycle) && Sim->CanTurn(SimCycle);
 }
 
-void AArmaCyclePawn::ProcessPendingTurns()
+void AArmaCyclePawn::TurnLeft()
 {
-	// ========== EXECUTE QUEUED TURNS (like original gCycleMovement::Timestep) ==========
-	// Execute pending turns when their time has come
-	if (PendingTurns.Num() > 0)
-	{
-		float CurrentTime = GetWorld()->GetTimeSeconds();
-		float NextTurnTime = LastTurnTime + TurnDelay;
-		
-		if (CurrentTime >= NextTurnTime)
-		{
-			int32 Direction = PendingTurns[0];
-			PendingTurns.RemoveAt(0);
-			
-			// Execute the turn directly (bypassing the queue check)
-			if (Direction < 0)
-			{
-				ExecuteTurnLeft();
-			}
-			else if (Direction > 0)
-			{
-				ExecuteTurnRight();
-			}
-		}
-	}
+	RequestTurn(-1);
 }
 
-void AArmaCyclePawn::ExecuteTurnLeft()
+void AArmaCyclePawn::TurnRight()
 {
-	// Internal function - actually executes the turn (called from queue or directly)
-	
-	// ========== DIGGING MECHANIC (Armagetron advanced technique) ==========
-	// When grinding against a wall, turning INTO the wall is allowed but costs extra rubber
-	// This creates the "dig" that lets you escape tight situations
-	if (bIsGrinding && DistanceToWall < MinWallDistance * 5.0f)
-	{
-		// Consume extra rubber for the dig turn
-		float DiggingCost = DiggingRubberMultiplier * (MinWallDistance * 5.0f - DistanceToWall);
-		CurrentRubber = FMath::Max(0.0f, CurrentRubber - DiggingCost);
-		
-		UE_LOG(LogTemp, Warning, TEXT("DIG TURN LEFT: Cost %.1f rubber, remaining %.1f"), DiggingCost, CurrentRubber);
-		
-		// Update gap on right side (we're turning left, so gap opens on right)
-		GapRight = FMath::Max(GapRight, DistanceToWall);
-	}
-	
-	// ========== TURN SPEED FACTOR (sg_cycleTurnSpeedFactor) ==========
-	// Each turn costs 5% of current speed
-	MoveSpeed *= TurnSpeedFactor;
-	
-	// Record turn time AND position for grace period and dig mechanic
-	LastTurnTime = GetWorld()->GetTimeSeconds();
-	LastTurnPosition = GetActorLocation();
-
-	FVector OldDir = MoveDirection;
-	FVector CurrentPos = GetActorLocation();
-	
-	// Finalize the current wall segment (make it permanent)
-	if (CurrentWallActor)
-	{
-		// Add current wall actor to the permanent list
-		WallActors.Add(CurrentWallActor);
-		
-		// Store 2D wall segment in local array (for legacy code)
-		FVector2D SegStart(CurrentWallStart.X, CurrentWallStart.Y);
-		FVector2D SegEnd(CurrentPos.X, CurrentPos.Y);
-		float WallTime = GetWorld()->GetTimeSeconds();
-		WallSegments.Add(FWallSegment(SegStart, SegEnd, CurrentWallActor, WallTime));
-		WallCount++;
-		
-		// Update final position of current wall in registry (it was already registered in StartNewWallSegment)
-		// No need to re-register - just finalize the endpoint
-		if (UArmaWallRegistry* WallRegistry = UArmaWallRegistry::Get(GetWorld()))
-		{
-			if (CurrentWallID != 0)
-			{
-				WallRegistry->UpdateWallEnd(CurrentWallID, SegEnd);
-			}
-		}
-		
-		UE_LOG(LogTemp, Warning, TEXT("TurnLeft: Wall %d finalized at time %.1f"), WallCount, WallTime);
-		CurrentWallActor = nullptr;
-		CurrentWallID = 0;
-	}
-
-	// Turn 90 degrees left (counter-clockwise when viewed from above)
-	FVector NewDir;
-	if (FMath::Abs(MoveDirection.X) > 0.5f)
-	{
-		NewDir = FVector(0.0f, -MoveDirection.X, 0.0f);
-	}
-	else
-	{
-		NewDir = FVector(MoveDirection.Y, 0.0f, 0.0f);
-	}
-	MoveDirection = NewDir.GetSafeNormal();
-	
-	// Set target yaw for smooth rotation
-	TargetPawnYaw = MoveDirection.Rotation().Yaw;
-
-	// Start new wall segment from current position
-	StartNewWallSegment();
-
-	UE_LOG(LogTemp, Warning, TEXT("TURN LEFT: Dir %s -> %s, Pos: %s, TargetYaw: %.1f"), 
-		*OldDir.ToString(), *MoveDirection.ToString(), *CurrentPos.ToString(), TargetPawnYaw);
+	RequestTurn(1);
 }
 
-void AArmaCyclePawn::TurnLeft()
+void AArmaCyclePawn::RequestTurn(int32 Direction)
 {
 	if (!bIsAlive || bMenuOpen) return;
 	
-	// ========== TURN QUEUEING (like original gCycleMovement::DoTurn) ==========
-	// If we can turn now, do it immediately. Otherwise queue it.
-	if (CanMakeTurn())
+	// Stamped with when the input handler ran, mapped onto the simulation clock, so the
+	// simulation turns there however the frames fall; queued (sg_cycleTurnMemory) like
+	// original gCycleMovement::DoTurn. A networked turn would carry the client's stamp instead
+	const double ReceivedTime = FPlatformTime::Seconds();
+	if (FArmaSimWorld* Sim = GetSimWorld())
 	{
-		ExecuteTurnLeft();
-	}
-	else
-	{
-		// Queue the turn (up to TurnMemory turns)
-		if (PendingTurns.Num() < TurnMemory)
-		{
-			PendingTurns.Add(-1);  // -1 = left
-			UE_LOG(LogTemp, Verbose, TEXT("TurnLeft queued (%d pending)"), PendingTurns.Num());
-		}
-		else if (PendingTurns.Num() > 0 && PendingTurns.Last() != -1)
-		{
-			// Opposite turns cancel out
-			PendingTurns.Pop();
-			UE_LOG(LogTemp, Verbose, TEXT("TurnLeft cancelled opposite turn (%d pending)"), PendingTurns.Num());
-		}
+		Sim->RequestTurn(SimCycle, Direction, UArmaCollisionSubsystem::GetInputTime(GetWorld(), ReceivedTime));
 	}
 }
 
-void AArmaCyclePawn::ExecuteTurnRight()
+AActor* AArmaCyclePawn::CreateWallVisual(FVector2D Start)
 {
-	// Internal function - actually executes the turn (called from queue or directly)
-	
-	// ========== DIGGING MECHANIC (Armagetron advanced technique) ==========
-	// When grinding against a wall, turning INTO the wall is allowed but costs extra rubber
-	// This creates the "dig" that lets you escape tight situations
-	if (bIsGrinding && DistanceToWall < MinWallDistance * 5.0f)
-	{
-		// Consume extra rubber for the dig turn
-		float DiggingCost = DiggingRubberMultiplier * (MinWallDistance * 5.0f - DistanceToWall);
-		CurrentRubber = FMath::Max(0.0f, CurrentRubber - DiggingCost);
-		
-		UE_LOG(LogTemp, Warning, TEXT("DIG TURN RIGHT: Cost %.1f rubber, remaining %.1f"), DiggingCost, CurrentRubber);
-		
-		// Update gap on left side (we're turning right, so gap opens on left)
-		GapLeft = FMath::Max(GapLeft, DistanceToWall);
-	}
+	UWorld* World = GetWorld();
+	if (!World) return nullptr;
 	
-	// ========== TURN SPEED FACTOR (sg_cycleTurnSpeedFactor) ==========
-	// Each turn costs 5% of current speed
-	MoveSpeed *= TurnSpeedFactor;
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
 	
-	// Record turn time AND position for grace period and dig mechanic
-	LastTurnTime = GetWorld()->GetTimeSeconds();
-	LastTurnPosition = GetActorLocation();
-
-	FVector OldDir = MoveDirection;
-	FVector CurrentPos = GetActorLocation();
-	
-	// Finalize the current wall segment (make it permanent)
-	if (CurrentWallActor)
-	{
-		// Add current wall actor to the permanent list
-		WallActors.Add(CurrentWallActor);
-		
-		// Store 2D wall segment in local array (for legacy code)
-		FVector2D SegStart(CurrentWallStart.X, CurrentWallStart.Y);
-		FVector2D SegEnd(CurrentPos.X, CurrentPos.Y);
-		float WallTime = GetWorld()->GetTimeSeconds();
-		WallSegments.Add(FWallSegment(SegStart, SegEnd, CurrentWallActor, WallTime));
-		WallCount++;
-		
-		// Update final position of current wall in registry (it was already registered in StartNewWallSegment)
-		// No need to re-register - just finalize the endpoint
-		if (UArmaWallRegistry* WallRegistry = UArmaWallRegistry::Get(GetWorld()))
-		{
-			if (CurrentWallID != 0)
-			{
-				WallRegistry->UpdateWallEnd(CurrentWallID, SegEnd);
-			}
-		}
-		
-		UE_LOG(LogTemp, Warning, TEXT("TurnRight: Wall %d finalized at time %.1f"), WallCount, WallTime);
-		CurrentWallActor = nullptr;
-		CurrentWallID = 0;
-	}
-
-	// Turn 90 degrees right (clockwise when viewed from above)
-	FVector NewDir;
-	if (FMath::Abs(MoveDirection.X) > 0.5f)
-	{
-		NewDir = FVector(0.0f, MoveDirection.X, 0.0f);
-	}
-	else
-	{
-		NewDir = FVector(-MoveDirection.Y, 0.0f, 0.0f);
-	}
-	MoveDirection = NewDir.GetSafeNormal();
-	
-	// Set target yaw for smooth rotation
-	TargetPawnYaw = MoveDirection.Rotation().Yaw;
-
-	// Start new wall segment from current position
-	StartNewWallSegment();
-
-	UE_LOG(LogTemp, Warning, TEXT("TURN RIGHT: Dir %s -> %s, Pos: %s, TargetYaw: %.1f"), 
-		*OldDir.ToString(), *MoveDirection.ToString(), *CurrentPos.ToString(), TargetPawnYaw);
-}
-
-void AArmaCyclePawn::TurnRight()
-{
-	if (!bIsAlive || bMenuOpen) return;
-	
-	// ========== TURN QUEUEING (like original gCycleMovement::DoTurn) ==========
-	// If we can turn now, do it immediately. Otherwise queue it.
-	if (CanMakeTurn())
-	{
-		ExecuteTurnRight();
-	}
-	else
-	{
-		// Queue the turn (up to TurnMemory turns)
-		if (PendingTurns.Num() < TurnMemory)
-		{
-			PendingTurns.Add(1);  // +1 = right
-			UE_LOG(LogTemp, Verbose, TEXT("TurnRight queued (%d pending)"), PendingTurns.Num());
-		}
-		else if (PendingTurns.Num() > 0 && PendingTurns.Last() != 1)
-		{
-			// Opposite turns cancel out
-			PendingTurns.Pop();
-			UE_LOG(LogTemp, Verbose, TEXT("TurnRight cancelled opposite turn (%d pending)"), PendingTurns.Num());
-		}
-	}
-}
-
-void AArmaCyclePawn::StartNewWallSegment()
-{
-	CurrentWallStart = GetActorLocation();
-	
-	// Create a new current wall actor if needed
-	CreateCurrentWallActor();
-	
-	// CRITICAL FIX: Register the current wall in the global registry IMMEDIATELY
-	// This ensures other players can collide with walls even before a turn is made
-	// In Armagetron, currentWall->PartialCopyIntoGrid() does this continuously
-	if (UArmaWallRegistry* WallRegistry = UArmaWallRegistry::Get(GetWorld()))
-	{
-		FVector2D SegStart(CurrentWallStart.X, CurrentWallStart.Y);
-		FVector2D SegEnd(CurrentWallStart.X, CurrentWallStart.Y); // Same point initially
-		CurrentWallID = WallRegistry->RegisterWall(SegStart, SegEnd, EArmaWallType::Cycle, this, CurrentWallActor);
-		UE_LOG(LogTemp, Warning, TEXT("StartNewWallSegment: Registered wall ID %d at (%.1f, %.1f)"), 
-			CurrentWallID, SegStart.X, SegStart.Y);
-	}
-}
-
-void AArmaCyclePawn::CreateCurrentWallActor()
-{
-	UWorld* World = GetWorld();
-	if (!World) return;
-	
-	FActorSpawnParameters SpawnParams;
-	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
-	
-	// Create a simple actor with procedural mesh component (like rim walls)
-	CurrentWallActor = World->SpawnActor<AActor>(AActor::StaticClass(), 
-		CurrentWallStart, FRotator::ZeroRotator, SpawnParams);
+	// Create a simple actor with procedural mesh component (like rim walls)
+	CurrentWallActor = World->SpawnActor<AActor>(AActor::StaticClass(), 
+		FVector(Start, GetActorLocation().Z), FRotator::ZeroRotator, SpawnParams);
 	
 	if (CurrentWallActor)
 	{
@@ -1289,64 +864,74 @@ void AArmaCyclePawn::CreateCurrentWallActor()
 			GlowLight->RegisterComponent();
 		}
 	}
+	
+	return CurrentWallActor;
 }
 
 void AArmaCyclePawn::UpdateCurrentWall()
 {
-	// Update the current wall segment to stretch from start to current position
-	if (!CurrentWallActor) 
+	SCOPE_CYCLE_COUNTER(STAT_ArmaUpdateCurrentWall);
+	ARMA_TRACE_SCOPE("Arma.UpdateCurrentWall");
+
+	// Stretch the current wall's mesh from its start to the cycle (the registry entry
+	// already follows every simulation step)
+	const FArmaSimWorld* Sim = GetSimWorld();
+	if (!IsValid(CurrentWallActor) || !Sim || !Sim->IsValidCycle(SimCycle))
 	{
-		UE_LOG(LogTemp, Error, TEXT("UpdateCurrentWall: No CurrentWallActor!"));
 		return;
 	}
-	
-	FVector CurrentPos = GetActorLocation();
-	FVector Direction = CurrentPos - CurrentWallStart;
-	float Length = Direction.Size();
-	
-	// CRITICAL FIX: Always update registry even for short walls (for collision detection)
-	// This is how Armagetron handles it - currentWall->Update() + PartialCopyIntoGrid()
-	if (CurrentWallID != 0)
+
+	const FArmaSimCycle& Cycle = Sim->GetCycle(SimCycle);
+	UpdateWallVisual(CurrentWallActor, Cycle.WallStart, Cycle.Position);
+}
+
+void AArmaCyclePawn::FinalizeWallVisual(AActor* Visual, FVector2D Start, FVector2D End)
+{
+	// The wall stops growing - its mesh is built once more and then left alone
+	UpdateWallVisual(Visual, Start, End);
+	if (Visual == CurrentWallActor)
 	{
-		if (UArmaWallRegistry* WallRegistry = UArmaWallRegistry::Get(GetWorld()))
-		{
-			FVector2D NewEnd(CurrentPos.X, CurrentPos.Y);
-			WallRegistry->UpdateWallEnd(CurrentWallID, NewEnd);
-		}
-		else
-		{
-			UE_LOG(LogTemp, Error, TEXT("UpdateCurrentWall: No WallRegistry!"));
-		}
+		CurrentWallActor = nullptr;
 	}
-	else
+}
+
+void AArmaCyclePawn::UpdateWallVisual(AActor* Visual, FVector2D Start, FVector2D End)
+{
+	if (!IsValid(Visual))
 	{
-		// Log periodically if wall ID is 0
-		static int WarnCounter = 0;
-		if (WarnCounter++ % 120 == 0)
-		{
-			UE_LOG(LogTemp, Error, TEXT("UpdateCurrentWall: CurrentWallID is 0!"));
-		}
+		return;
 	}
-	
+
 	// Hide the wall mesh if it's too short (prevents artifacts at corners)
 	const float MinVisibleLength = 10.0f;
-	if (Length < MinVisibleLength)
+	if ((End - Start).Size() < MinVisibleLength)
 	{
-		CurrentWallActor->SetActorHiddenInGame(true);
+		Visual->SetActorHiddenInGame(true);
 		return;
 	}
 	
 	// Show the wall
-	CurrentWallActor->SetActorHiddenInGame(false);
+	Visual->SetActorHiddenInGame(false);
 	
 	// Get procedural mesh component
-	UProceduralMeshComponent* ProcMesh = CurrentWallActor->FindComponentByClass<UProceduralMeshComponent>();
+	UProceduralMeshComponent* ProcMesh = Visual->FindComponentByClass<UProceduralMeshComponent>();
 	if (!ProcMesh)
 	{
-		UE_LOG(LogTemp, Error, TEXT("UpdateCurrentWall: No ProceduralMeshComponent!"));
+		UE_LOG(LogTemp, Error, TEXT("UpdateWallVisual: No ProceduralMeshComponent!"));
 		return;
 	}
 	
+	BuildWallMesh(ProcMesh, FVector(Start, 0.0f), FVector(End, 0.0f));
+	
+	// Ensure material is set
+	if (Visual == CurrentWallActor && CurrentWallMaterial)
+	{
+		ProcMesh->SetMaterial(0, CurrentWallMaterial);
+	}
+}
+
+void AArmaCyclePawn::BuildWallMesh(UProceduralMeshComponent* ProcMesh, const FVector& Start, const FVector& End)
+{
 	// Generate mesh procedurally (same approach as rim walls)
 	TArray<FVector> Vertices;
 	TArray<int32> Triangles;
@@ -1359,13 +944,11 @@ void AArmaCyclePawn::UpdateCurrentWall()
 	float WallHeight = TrailHeight;
 	
 	// Calculate wall direction and perpendicular
+	const FVector Direction = End - Start;
+	const float Length = Direction.Size();
 	FVector DirNorm = Direction.GetSafeNormal();
 	FVector Perp = FVector(-DirNorm.Y, DirNorm.X, 0.0f) * (WallThickness * 0.5f);
 	
-	// Start and end points
-	FVector Start = CurrentWallStart;
-	FVector End = CurrentPos;
-	
 	// Create quad vertices (similar to rim wall generation)
 	// Bottom-left, Top-left, Bottom-right, Top-right
 	Vertices.Add(FVector(Start.X + Perp.X, Start.Y + Perp.Y, 0.0f));  // 0: BL
@@ -1424,103 +1007,6 @@ void AArmaCyclePawn::UpdateCurrentWall()
 	
 	// Create/update mesh section
 	ProcMesh->CreateMeshSection_LinearColor(0, Vertices, Triangles, Normals, UVs, Colors, TArray<FProcMeshTangent>(), true);
-	
-	// Ensure material is set
-	if (CurrentWallMaterial)
-	{
-		ProcMesh->SetMaterial(0, CurrentWallMaterial);
-	}
-}
-
-AActor* AArmaCyclePawn::SpawnWallSegment(FVector Start, FVector End)
-{
-	UWorld* World = GetWorld();
-	if (!World) return nullptr;
-
-	// Calculate wall dimensions
-	FVector Direction = End - Start;
-	float Length = Direction.Size();
-	
-	if (Length < 10.0f) return nullptr; // Skip tiny segments
-
-	FVector Center = (Start + End) / 2.0f;
-	Center.Z = TrailHeight / 2.0f; // Wall center at half height above ground
-
-	// Determine rotation based on direction
-	FRotator WallRotation = Direction.Rotation();
-
-	FActorSpawnParameters SpawnParams;
-	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
-
-	// Use AStaticMeshActor for reliable mesh spawning
-	AStaticMeshActor* WallActor = World->SpawnActor<AStaticMeshActor>(AStaticMeshActor::StaticClass(), Center, WallRotation, SpawnParams);
-
-	if (WallActor)
-	{
-		UStaticMeshComponent* WallMeshComp = WallActor->GetStaticMeshComponent();
-		if (WallMeshComp)
-		{
-			WallMeshComp->SetMobility(EComponentMobility::Movable);
-			
-			UStaticMesh* CubeMesh = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
-			if (CubeMesh)
-			{
-				WallMeshComp->SetStaticMesh(CubeMesh);
-			}
-			
-			// Scale: X is length, Y is width, Z is height
-			float ScaleX = (Length + 10.0f) / 100.0f;  // Smaller overlap
-			float ScaleY = 0.5f; // 50 units wide - VERY visible for debugging
-			float ScaleZ = TrailHeight / 100.0f;
-			WallActor->SetActorScale3D(FVector(ScaleX, ScaleY, ScaleZ));
-			
-			// SIMPLE APPROACH: Use default material which always renders
-			UMaterial* DefaultMat = UMaterial::GetDefaultMaterial(MD_Surface);
-			if (DefaultMat)
-			{
-				UMaterialInstanceDynamic* WallMat = UMaterialInstanceDynamic::Create(DefaultMat, WallActor);
-				WallMat->SetVectorParameterValue(TEXT("BaseColor"), CycleColor);
-				WallMeshComp->SetMaterial(0, WallMat);
-			}
-			
-			// Force simple rendering
-			WallMeshComp->SetCastShadow(false);
-			WallMeshComp->bReceivesDecals = false;
-			
-			// Enable collision so cycle can't pass through
-			WallMeshComp->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
-			WallMeshComp->SetCollisionObjectType(ECC_WorldDynamic);
-			WallMeshComp->SetCollisionResponseToAllChannels(ECR_Block);
-			WallMeshComp->SetGenerateOverlapEvents(true);
-			WallMeshComp->SetNotifyRigidBodyCollision(true);
-			WallMeshComp->SetVisibility(true);
-			WallMeshComp->SetHiddenInGame(false);
-		}
-		
-		// Add point light for glow effect using CycleColor
-		UPointLightComponent* WallLight = NewObject<UPointLightComponent>(WallActor, TEXT("WallGlow"));
-		if (WallLight)
-		{
-			WallLight->SetupAttachment(WallActor->GetRootComponent());
-			WallLight->SetMobility(EComponentMobility::Movable);
-			WallLight->SetRelativeLocation(FVector(0, 0, TrailHeight / 2.0f));
-			WallLight->SetIntensity(20000.0f);
-			WallLight->SetAttenuationRadius(250.0f);
-			WallLight->SetLightColor(FColor(
-				FMath::Clamp(int32(CycleColor.R * 255), 0, 255),
-				FMath::Clamp(int32(CycleColor.G * 255), 0, 255),
-				FMath::Clamp(int32(CycleColor.B * 255), 0, 255)
-			));
-			WallLight->RegisterComponent();
-		}
-
-		WallActors.Add(WallActor);
-		WallCount++;
-
-		UE_LOG(LogTemp, Warning, TEXT("Wall %d finalized: Length=%.0f"), WallCount, Length);
-	}
-
-	return WallActor;
 }
 
 void AArmaCyclePawn::OnBrakePressed()
@@ -1533,7 +1019,7 @@ void AArmaCyclePawn::OnBrakePressed()
 	}
 	
 	bIsBraking = true;
-	MoveSpeed = FMath::Max(200.0f, MoveSpeed * 0.5f);
+	SetSimSpeed(FMath::Max(200.0f, MoveSpeed * 0.5f));
 }
 
 void AArmaCyclePawn::OnBrakeReleased()
@@ -1541,7 +1027,7 @@ void AArmaCyclePawn::OnBrakeReleased()
 	if (!bIsAlive) return;
 	
 	bIsBraking = false;
-	MoveSpeed = BaseSpeed;
+	SetSimSpeed(BaseSpeed);
 }
 
 void AArmaCyclePawn::OnMouseX(float Value)
@@ -1580,391 +1066,26 @@ void AArmaCyclePawn::OnZoomOut()
 
 bool AArmaCyclePawn::IsVulnerable() const
 {
-	if (!bIsAlive) return false;
-	
-	float CurrentTime = GetWorld()->GetTimeSeconds();
-	return (CurrentTime - SpawnTime) > SpawnInvulnerabilityTime;
+	const FArmaSimWorld* Sim = GetSimWorld();
+	return Sim && Sim->IsValidCycle(SimCycle) && Sim->IsVulnerable(SimCycle);
 }
 
 float AArmaCyclePawn::GetDistanceSinceLastTurn() const
 {
-	// Calculate how far we've traveled since the last turn (like original gCycleMovement)
-	// This is used for the "dig" mechanic - the closer we are to the last turn, 
-	// the closer we're allowed to get to walls
-	FVector Delta = GetActorLocation() - LastTurnPosition;
-	return Delta.Size();
-}
-
-float AArmaCyclePawn::GetDistanceToNearestWall(FVector Direction) const
-{
-	UWorld* World = GetWorld();
-	if (!World) return 9999.0f;
-	
-	FVector Start = GetActorLocation();
-	FVector End = Start + Direction.GetSafeNormal() * 1000.0f; // Cast 1000 units
-	
-	FHitResult HitResult;
-	FCollisionQueryParams QueryParams;
-	QueryParams.AddIgnoredActor(this);
-	
-	// Trace against all wall actors
-	float MinDist = 9999.0f;
-	
-	for (AActor* WallActor : WallActors)
-	{
-		if (!WallActor) continue;
-		
-		// Use the wall's actual location for distance calculation
-		FVector WallLocation = WallActor->GetActorLocation();
-		FVector ToWall = WallLocation - Start;
-		
-		// Project onto our direction
-		float ForwardDist = FVector::DotProduct(ToWall, Direction.GetSafeNormal());
-		
-		if (ForwardDist > 0 && ForwardDist < MinDist)
-		{
-			// Check if we're actually heading toward this wall
-			FVector LateralOffset = ToWall - Direction.GetSafeNormal() * ForwardDist;
-			if (LateralOffset.Size() < 100.0f) // Within 100 units laterally
-			{
-				MinDist = ForwardDist;
-			}
-		}
-	}
-	
-	// Also check current wall actor
-	if (CurrentWallActor)
-	{
-		FVector WallLocation = CurrentWallActor->GetActorLocation();
-		FVector ToWall = WallLocation - Start;
-		float ForwardDist = FVector::DotProduct(ToWall, Direction.GetSafeNormal());
-		
-		if (ForwardDist > 50.0f && ForwardDist < MinDist) // Ignore if too close (it's behind us)
-		{
-			FVector LateralOffset = ToWall - Direction.GetSafeNormal() * ForwardDist;
-			if (LateralOffset.Size() < 100.0f)
-			{
-				MinDist = ForwardDist;
-			}
-		}
-	}
-	
-	return MinDist;
-}
-
-void AArmaCyclePawn::UpdateRubber(float DeltaTime)
-{
-	// Rubber regeneration when not grinding
-	// Armagetron: sg_rubberCycleTime = 10 seconds to fully regenerate
-	const float RubberRegenTime = 10.0f;
-	
-	if (!bIsGrinding)
-	{
-		// Regenerate rubber when not using it
-		float RegenAmount = (MaxRubber / RubberRegenTime) * DeltaTime;
-		CurrentRubber = FMath::Min(MaxRubber, CurrentRubber + RegenAmount);
-	}
-	
-	// Clamp rubber
-	CurrentRubber = FMath::Clamp(CurrentRubber, 0.0f, MaxRubber);
-}
-
-void AArmaCyclePawn::UpdateWallDecay()
-{
-	// ========== WALL LENGTH DECAY (Armagetron WALLS_LENGTH) ==========
-	// When total wall length exceeds max, remove oldest segments
-	// This is how Armagetron makes walls "fall" after a certain distance
-	
-	// First, calculate total wall length
-	TotalWallLength = 0.0f;
-	for (const FWallSegment& Seg : WallSegments)
-	{
-		float SegLength = (Seg.End - Seg.Start).Size();
-		TotalWallLength += SegLength;
-	}
-	
-	// Add current wall segment length
-	if (CurrentWallActor)
-	{
-		FVector CurrentPos = GetActorLocation();
-		float CurrentSegLength = (FVector2D(CurrentPos.X, CurrentPos.Y) - FVector2D(CurrentWallStart.X, CurrentWallStart.Y)).Size();
-		TotalWallLength += CurrentSegLength;
-	}
-	
-	// If max length is set and we exceed it, remove oldest walls
-	if (MaxWallsLength > 0.0f && TotalWallLength > MaxWallsLength)
-	{
-		float ExcessLength = TotalWallLength - MaxWallsLength;
-		
-		// Remove walls from the beginning (oldest first)
-		while (ExcessLength > 0.0f && WallSegments.Num() > 0)
-		{
-			FWallSegment& OldestWall = WallSegments[0];
-			float WallLength = (OldestWall.End - OldestWall.Start).Size();
-			
-			if (WallLength <= ExcessLength)
-			{
-				// Remove entire wall segment
-				if (OldestWall.Actor && IsValid(OldestWall.Actor))
-				{
-					OldestWall.Actor->Destroy();
-				}
-				
-				// Also remove from global registry
-				if (UArmaWallRegistry* WallRegistry = UArmaWallRegistry::Get(GetWorld()))
-				{
-					// Find and remove this wall from registry
-					const TArray<FArmaRegisteredWall>& AllWalls = WallRegistry->GetAllWalls();
-					for (int32 i = 0; i < AllWalls.Num(); i++)
-					{
-						const FArmaRegisteredWall& RegWall = AllWalls[i];
-						if (RegWall.OwnerActor == this && 
-							FVector2D::DistSquared(RegWall.Start, OldestWall.Start) < 1.0f &&
-							FVector2D::DistSquared(RegWall.End, OldestWall.End) < 1.0f)
-						{
-							WallRegistry->RemoveWall(RegWall.WallID);
-							break;
-						}
-					}
-				}
-				
-				ExcessLength -= WallLength;
-				WallSegments.RemoveAt(0);
-				WallCount--;
-				
-				UE_LOG(LogTemp, Display, TEXT("Wall decay: Removed oldest segment (Length=%.0f, Excess=%.0f)"), 
-					WallLength, ExcessLength);
-			}
-			else
-			{
-				// Partial removal - shrink the wall (for smoother decay)
-				// For now just break - full segment removal is simpler
-				break;
-			}
-		}
-		
-		TotalWallLength = FMath::Max(0.0f, TotalWallLength - (TotalWallLength - MaxWallsLength));
-	}
-}
-
-void AArmaCyclePawn::UpdateWallAcceleration(float DeltaTime)
-{
-	// ========== ARMAGETRON-STYLE WALL ACCELERATION ==========
-	// Cast rays to LEFT and RIGHT (perpendicular to travel direction)
-	// Acceleration = accel * (1/(dist+offset) - 1/(nearDist+offset))
-	// NOTE: Only CYCLE walls provide acceleration, not RIM walls!
-	
-	FVector2D MyPos2D(GetActorLocation().X, GetActorLocation().Y);
-	FVector2D MyDir2D(MoveDirection.X, MoveDirection.Y);
-	FVector2D LeftDir2D(-MyDir2D.Y, MyDir2D.X);   // 90 degrees left
-	FVector2D RightDir2D(MyDir2D.Y, -MyDir2D.X);  // 90 degrees right
-	
-	// Use member variables configured in header
-	const float NearCycle = WallAccelDistance;     // sg_nearCycle - walls within this distance contribute
-	const float AccelOffset = WallAccelOffset;     // sg_accelerationCycleOffs
-	const float AccelBase = WallAcceleration;      // sg_accelerationCycle base value
-	const float WallGracePeriod = 0.3f;
-	float CurrentTime = GetWorld()->GetTimeSeconds();
-	
-	// Find closest wall to left and right using GLOBAL registry
-	float LeftDist = NearCycle + 1.0f;
-	float RightDist = NearCycle + 1.0f;
-	
-	UArmaWallRegistry* WallRegistry = UArmaWallRegistry::Get(GetWorld());
-	if (WallRegistry)
-	{
-		const TArray<FArmaRegisteredWall>& AllWalls = WallRegistry->GetAllWalls();
-		for (const FArmaRegisteredWall& Wall : AllWalls)
-		{
-			// Skip rim walls - they don't provide acceleration in Armagetron
-			if (Wall.WallType == EArmaWallType::Rim)
-			{
-				continue;
-			}
-			
-			// Skip very recent own walls
-			if (Wall.OwnerActor == this && (CurrentTime - Wall.CreationTime) < WallGracePeriod)
-			{
-				continue;
-			}
-			
-			float Dist = DistanceToLineSegment2D(MyPos2D, Wall.Start, Wall.End);
-			
-			if (Dist < NearCycle)
-			{
-				// Determine if wall is to our left or right
-				FVector2D ToWall = ((Wall.Start + Wall.End) * 0.5f - MyPos2D).GetSafeNormal();
-				float LeftDot = FVector2D::DotProduct(LeftDir2D, ToWall);
-				float RightDot = FVector2D::DotProduct(RightDir2D, ToWall);
-				
-				if (LeftDot > 0.3f && Dist < LeftDist)
-				{
-					LeftDist = Dist;
-				}
-				if (RightDot > 0.3f && Dist < RightDist)
-				{
-					RightDist = Dist;
-				}
-			}
-		}
-	}
-	
-	// Calculate acceleration using Armagetron formula
-	float TotalAcceleration = 0.0f;
-	
-	if (LeftDist < NearCycle)
-	{
-		// Inverse distance formula: accel * (1/(dist+offset) - 1/(nearDist+offset))
-		float Factor = (1.0f / (LeftDist + AccelOffset)) - (1.0f / (NearCycle + AccelOffset));
-		TotalAcceleration += AccelBase * Factor;
-	}
-	
-	if (RightDist < NearCycle)
-	{
-		float Factor = (1.0f / (RightDist + AccelOffset)) - (1.0f / (NearCycle + AccelOffset));
-		TotalAcceleration += AccelBase * Factor;
-	}
-	
-	// Slingshot bonus when walls on both sides
-	if (LeftDist < NearCycle && RightDist < NearCycle)
-	{
-		TotalAcceleration *= SlingshotMultiplier;
-	}
-	
-	// Apply acceleration (only when not grinding into a wall ahead)
-	if (TotalAcceleration > 0 && !bIsGrinding)
-	{
-		MoveSpeed = FMath::Min(MaxSpeed, MoveSpeed + TotalAcceleration * DeltaTime);
-	}
-	
-	// Debug visualization
-	if (bDebugDrawEnabled)
-	{
-		UWorld* World = GetWorld();
-		if (World)
-		{
-			FVector Start = GetActorLocation();
-			FVector LeftEnd = Start + FVector(LeftDir2D.X, LeftDir2D.Y, 0) * LeftDist;
-			FVector RightEnd = Start + FVector(RightDir2D.X, RightDir2D.Y, 0) * RightDist;
-			
-			DrawDebugLine(World, Start, LeftEnd, LeftDist < NearCycle ? FColor::Green : FColor::White, false, -1.0f, 0, 2.0f);
-			DrawDebugLine(World, Start, RightEnd, RightDist < NearCycle ? FColor::Blue : FColor::White, false, -1.0f, 0, 2.0f);
-			
-		}
-	}
-}
-
-bool AArmaCyclePawn::CheckWallCollision(const FVector& DesiredMove, FVector& OutNewLocation)
-{
-	UWorld* World = GetWorld();
-	if (!World) return false;
-	
-	// Check if we're about to hit a wall with this move
-	FVector Start = GetActorLocation();
-	FVector End = OutNewLocation + MoveDirection * 20.0f; // A bit past where we want to go
-	
-	FHitResult HitResult;
-	FCollisionQueryParams QueryParams;
-	QueryParams.AddIgnoredActor(this);
-	// Ignore our current trail wall (it's behind us)
-	if (CurrentWallActor) QueryParams.AddIgnoredActor(CurrentWallActor);
-	
-	// Use object type query to find WorldStatic objects (walls)
-	FCollisionObjectQueryParams ObjectParams;
-	ObjectParams.AddObjectTypesToQuery(ECC_WorldStatic);
-	ObjectParams.AddObjectTypesToQuery(ECC_WorldDynamic); // Also check dynamic objects
-	
-	bool bHitWall = World->LineTraceSingleByObjectType(HitResult, Start, End, ObjectParams, QueryParams);
-	
-	if (bDebugDrawEnabled && bHitWall)
-	{
-		UE_LOG(LogTemp, Warning, TEXT("COLLISION: Hit %s at dist %.1f"), 
-			*HitResult.GetActor()->GetName(), HitResult.Distance);
-		DrawDebugSphere(World, HitResult.ImpactPoint, 20.0f, 8, FColor::Red, false, 1.0f);
-	}
-	
-	if (bHitWall && HitResult.GetActor())
-	{
-		// We're going to hit a wall!
-		if (CurrentRubber > 0.0f)
-		{
-			// Rubber absorbs the impact - stop just before the wall
-			FVector SafePos = HitResult.ImpactPoint - MoveDirection * 25.0f;
-			SafePos.Z = Start.Z;
-			OutNewLocation = SafePos;
-			
-			// Set our position to the safe spot
-			SetActorLocation(SafePos);
-			
-			// Slow down significantly
-			MoveSpeed = FMath::Max(50.0f, MoveSpeed * 0.3f);
-			
-			// Spawn sparks at impact point
-			SpawnSpark(HitResult.ImpactPoint, HitResult.ImpactNormal);
-			
-			return true; // Movement blocked but handled by rubber
-		}
-		else
-		{
-			// No rubber left - die!
-			if (IsVulnerable())
-			{
-				Die();
-			}
-			return true; // Movement blocked, player dead
-		}
-	}
-	
-	return false; // No collision
+	// How far we've traveled since the last turn (like original gCycleMovement) - the
+	// closer we are to the last turn, the closer we're allowed to get to walls
+	const FArmaSimWorld* Sim = GetSimWorld();
+	return (Sim && Sim->IsValidCycle(SimCycle)) ? Sim->GetDistanceSinceLastTurn(SimCycle) : 0.0f;
 }
 
 void AArmaCyclePawn::Die()
 {
 	if (!bIsAlive) return;
 	
-	UE_LOG(LogTemp, Error, TEXT("CYCLE DIED! Round %d, Deaths: %d"), CurrentRound, DeathCount + 1);
-	
-	bIsAlive = false;
-	DeathCount++;
-	
-	// Stop movement
-	MoveSpeed = 0.0f;
-	
-	// Hide cycle mesh
-	if (CycleMesh)
-	{
-		CycleMesh->SetVisibility(false);
-	}
-	
-	// Finalize current wall with collision
-	if (CurrentWallActor)
-	{
-		UProceduralMeshComponent* WallMesh = CurrentWallActor->FindComponentByClass<UProceduralMeshComponent>();
-		if (WallMesh)
-		{
-			WallMesh->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
-			WallMesh->SetCollisionObjectType(ECC_WorldDynamic);
-			WallMesh->SetCollisionResponseToAllChannels(ECR_Block);
-			WallMesh->SetGenerateOverlapEvents(true);
-			WallMesh->SetNotifyRigidBodyCollision(true);
-		}
-		WallActors.Add(CurrentWallActor);
-		
-		// Store 2D segment with timestamp
-		FVector CurrentPos = GetActorLocation();
-		FVector2D SegStart(CurrentWallStart.X, CurrentWallStart.Y);
-		FVector2D SegEnd(CurrentPos.X, CurrentPos.Y);
-		float WallTime = GetWorld()->GetTimeSeconds();
-		WallSegments.Add(FWallSegment(SegStart, SegEnd, CurrentWallActor, WallTime));
-		WallCount++;
-		CurrentWallActor = nullptr;
-	}
-	
-	// Spawn explosion effect (simple flash for now)
-	if (CycleGlowLight)
+	// The simulation finalizes the wall and lets the trail fall; HandleSimEvent presents it
+	if (UArmaCollisionSubsystem* Collision = UArmaCollisionSubsystem::Get(GetWorld()))
 	{
-		CycleGlowLight->SetIntensity(500000.0f); // Bright flash
-		CycleGlowLight->SetLightColor(FColor::Red);
+		Collision->KillCycle(SimCycle);
 	}
 }
 
@@ -1973,10 +1094,15 @@ void AArmaCyclePawn::Respawn()
 	UE_LOG(LogTemp, Warning, TEXT("RESPAWNING! Starting Round %d"), CurrentRound + 1);
 	
 	CurrentRound++;
-	bIsAlive = true;
 	
-	// Clear all walls
-	ClearAllWalls();
+	// The player's respawn starts the next round; AI respawns happen within one
+	if (IsPlayerControlled())
+	{
+		if (AArmaTestGameMode* GameMode = GetWorld()->GetAuthGameMode<AArmaTestGameMode>())
+		{
+			GameMode->StartRound();
+		}
+	}
 	
 	// Validate SpawnLocation is inside arena
 	const float SafeBoundary = 4500.0f;  // Spawn well inside arena
@@ -1992,28 +1118,19 @@ void AArmaCyclePawn::Respawn()
 		SafeSpawn = FVector(0, 0, 92.0f);
 	}
 	
-	// Reset position and direction
+	// The simulation clears our old walls, resets speed, rubber and turns, and starts a new wall
 	SetActorLocation(SafeSpawn);
-	MoveDirection = SpawnDirection;
+	if (UArmaCollisionSubsystem* Collision = UArmaCollisionSubsystem::Get(GetWorld()))
+	{
+		Collision->SpawnCycle(SimCycle, FVector2D(SafeSpawn.X, SafeSpawn.Y), FVector2D(SpawnDirection.X, SpawnDirection.Y));
+	}
+	SyncFromSim();
+	
+	// Reset rotation
 	TargetPawnYaw = MoveDirection.Rotation().Yaw;
 	CurrentPawnYaw = TargetPawnYaw;
 	SetActorRotation(FRotator(0, CurrentPawnYaw, 0));
 	
-	// Reset physics
-	CurrentRubber = MaxRubber;
-	MoveSpeed = BaseSpeed;
-	bIsGrinding = false;
-	DistanceToWall = 9999.0f;
-	
-	// Set spawn time for invulnerability
-	SpawnTime = GetWorld()->GetTimeSeconds();
-	
-	// Allow immediate first turn after respawn (set LastTurnTime in the past)
-	LastTurnTime = SpawnTime - TurnDelay;
-	
-	// Clear any pending turns from before death
-	PendingTurns.Empty();
-	
 	// Show cycle mesh
 	if (CycleMesh)
 	{
@@ -2030,31 +1147,6 @@ void AArmaCyclePawn::Respawn()
 			FMath::Clamp(int32(CycleColor.B * 255), 0, 255)
 		));
 	}
-	
-	// Start new wall segment
-	StartNewWallSegment();
-}
-
-void AArmaCyclePawn::ClearAllWalls()
-{
-	// Remove walls from global registry (this also destroys visual actors)
-	if (UArmaWallRegistry* WallRegistry = UArmaWallRegistry::Get(GetWorld()))
-	{
-		WallRegistry->RemoveWallsByOwner(this);
-	}
-	
-	// Also clean up local arrays
-	WallActors.Empty();
-	WallSegments.Empty();
-	WallCount = 0;
-	
-	// Destroy current wall actor
-	if (CurrentWallActor)
-	{
-		CurrentWallActor->Destroy();
-		CurrentWallActor = nullptr;
-		CurrentWallID = 0;
-	}
 }
 
 void AArmaCyclePawn::SpawnSpark(FVector Location, FVector Normal)
@@ -2110,7 +1202,7 @@ void AArmaCyclePawn::UpdateInvulnerabilityBlink()
 	if (IsVulnerable()) return;
 	
 	// Blink the cycle mesh during invulnerability
-	float TimeSinceSpawn = GetWorld()->GetTimeSeconds() - SpawnTime;
+	float TimeSinceSpawn = UArmaCollisionSubsystem::GetSimTime(GetWorld()) - SpawnTime;
 	float BlinkRate = 10.0f; // Blinks per second
 	bool bVisible = FMath::Fmod(TimeSinceSpawn * BlinkRate, 1.0f) > 0.5f;
 	
@@ -2120,25 +1212,6 @@ void AArmaCyclePawn::UpdateInvulnerabilityBlink()
 	}
 }
 
-float AArmaCyclePawn::DistanceToLineSegment2D(FVector2D Point, FVector2D LineStart, FVector2D LineEnd) const
-{
-	// Vector from line start to end
-	FVector2D Line = LineEnd - LineStart;
-	float LineLengthSq = Line.SizeSquared();
-	
-	if (LineLengthSq < 0.0001f)
-	{
-		// Line is basically a point
-		return FVector2D::Distance(Point, LineStart);
-	}
-	
-	// Project point onto line, clamped to segment
-	float T = FMath::Clamp(FVector2D::DotProduct(Point - LineStart, Line) / LineLengthSq, 0.0f, 1.0f);
-	FVector2D Projection = LineStart + T * Line;
-	
-	return FVector2D::Distance(Point, Projection);
-}
-
 // ========== Debug Functions ==========
 
 void AArmaCyclePawn::DebugNextVar()
@@ -2167,6 +1240,8 @@ void AArmaCyclePawn::DebugIncreaseVar()
 	case 5: WallAccelDistance = FMath::Clamp(WallAccelDistance + 50.0f, 50.0f, 1000.0f); break;
 	case 6: MaxWallsLength = (MaxWallsLength < 0) ? 5000.0f : FMath::Clamp(MaxWallsLength + 1000.0f, 1000.0f, 50000.0f); break;
 	}
+	
+	PushSimParams();
 }
 
 void AArmaCyclePawn::DebugDecreaseVar()
@@ -2186,6 +1261,8 @@ void AArmaCyclePawn::DebugDecreaseVar()
 			MaxWallsLength = -1.0f;  // Go to infinite
 		break;
 	}
+	
+	PushSimParams();
 }
 
 void AArmaCyclePawn::DebugToggleDraw()
@@ -2215,11 +1292,28 @@ void AArmaCyclePawn::DrawDebugRays()
 		DrawDebugSphere(World, ForwardEnd, 15.0f, 8, FColor::Red, false, -1.0f, 0, 3.0f);
 	}
 	
+	const FArmaSimWorld* Sim = GetSimWorld();
+	if (!Sim || !Sim->IsValidCycle(SimCycle)) return;
+	const FArmaSimCycle& Cycle = Sim->GetCycle(SimCycle);
+	const FArmaWallTrail& WallTrail = Sim->GetTrail(SimCycle);
+	
+	// Side walls feeding wall acceleration (sg_nearCycle)
+	const float NearCycle = WallAccelDistance;
+	const float LeftDist = FMath::Min(Cycle.LeftWallDistance, NearCycle + 1.0f);
+	const float RightDist = FMath::Min(Cycle.RightWallDistance, NearCycle + 1.0f);
+	const FVector LeftDir(-MoveDirection.Y, MoveDirection.X, 0.0f);
+	DrawDebugLine(World, Start, Start + LeftDir * LeftDist, LeftDist < NearCycle ? FColor::Green : FColor::White, false, -1.0f, 0, 2.0f);
+	DrawDebugLine(World, Start, Start - LeftDir * RightDist, RightDist < NearCycle ? FColor::Blue : FColor::White, false, -1.0f, 0, 2.0f);
+	
 	// Draw all wall segments as 2D lines (extruded to 3D)
-	float CurrentTime = World->GetTimeSeconds();
-	for (int32 i = 0; i < WallSegments.Num(); i++)
+	float CurrentTime = UArmaCollisionSubsystem::GetSimTime(World);
+	for (int32 i = 0; i < WallTrail.Num(); i++)
 	{
-		const FWallSegment& Wall = WallSegments[i];
+		const FArmaTrailSegment& Wall = WallTrail[i];
+		if (Wall.Wall == INDEX_NONE)
+		{
+			continue;  // Blown away
+		}
 		float Age = CurrentTime - Wall.CreationTime;
 		FColor WallColor = (Age < 0.5f) ? FColor::Yellow : FColor::Purple;
 		
@@ -2233,7 +1327,7 @@ void AArmaCyclePawn::DrawDebugRays()
 	}
 	
 	// Current wall (being created) - YELLOW DASHED
-	if (CurrentWallActor)
+	if (IsValid(CurrentWallActor))
 	{
 		FVector WallCenter = CurrentWallActor->GetActorLocation();
 		FVector WallExtent = CurrentWallActor->GetComponentsBoundingBox().GetExtent();
@@ -2243,7 +1337,7 @@ void AArmaCyclePawn::DrawDebugRays()
 	// On-screen status
 	GEngine->AddOnScreenDebugMessage(100, 0.0f, ForwardColor,
 		FString::Printf(TEXT(">>> FORWARD: %.0f units | Segments: %d | Grinding: %s <<<"),
-			DistanceToWall, WallSegments.Num(), bIsGrinding ? TEXT("YES") : TEXT("NO")));
+			DistanceToWall, WallTrail.Num(), bIsGrinding ? TEXT("YES") : TEXT("NO")));
 }
 
 void AArmaCyclePawn::DrawDebugSliders()
@@ -2337,33 +1431,9 @@ void AArmaCyclePawn::OnWallHit(UPrimitiveComponent* HitComponent, AActor* OtherA
 	if (OtherActor == this) return;
 	if (OtherActor == CurrentWallActor) return; // Ignore our current trail
 	
-	UE_LOG(LogTemp, Error, TEXT("WALL HIT! Actor: %s, Rubber: %.1f"), 
+	// Wall contact is decided by the simulation - physics contacts are only reported
+	UE_LOG(LogTemp, Verbose, TEXT("WALL HIT! Actor: %s, Rubber: %.1f"), 
 		*OtherActor->GetName(), CurrentRubber);
-	
-	// Check if it's a wall (our trail walls are AStaticMeshActor)
-	if (CurrentRubber > 0.0f)
-	{
-		// Rubber absorbs the impact
-		CurrentRubber -= 10.0f;
-		MoveSpeed = FMath::Max(100.0f, MoveSpeed * 0.5f);
-		
-		// Push back from wall
-		FVector PushDir = Hit.ImpactNormal;
-		SetActorLocation(GetActorLocation() + PushDir * 30.0f);
-		
-		// Spawn spark
-		SpawnSpark(Hit.ImpactPoint, Hit.ImpactNormal);
-		
-		bIsGrinding = true;
-	}
-	else
-	{
-		// No rubber - die!
-		if (IsVulnerable())
-		{
-			Die();
-		}
-	}
 }
 
 void AArmaCyclePawn::OnWallOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor,
@@ -2373,18 +1443,7 @@ void AArmaCyclePawn::OnWallOverlap(UPrimitiveComponent* OverlappedComponent, AAc
 	if (OtherActor == this) return;
 	if (OtherActor == CurrentWallActor) return;
 	
-	UE_LOG(LogTemp, Warning, TEXT("WALL OVERLAP! Actor: %s"), *OtherActor->GetName());
-	
-	// Treat overlap like a hit for safety
-	if (CurrentRubber > 0.0f)
-	{
-		CurrentRubber -= 5.0f;
-		bIsGrinding = true;
-	}
-	else if (IsVulnerable())
-	{
-		Die();
-	}
+	UE_LOG(LogTemp, Verbose, TEXT("WALL OVERLAP! Actor: %s"), *OtherActor->GetName());
 }
 
 // ========== ESC Menu ==========
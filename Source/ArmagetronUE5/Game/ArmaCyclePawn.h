@@ -4,6 +4,8 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Pawn.h"
+#include "ArmaWallRegistry.h"
+#include "ArmaCollisionSubsystem.h"
 #include "ArmaCyclePawn.generated.h"
 
 class UCameraComponent;
@@ -16,6 +18,10 @@ class UProceduralMeshComponent;
 
 /**
  * AArmaCyclePawn - Snake/Armagetron style movement with glowing trails
+ * The cycle's rules run in UArmaCollisionSubsystem's FArmaSimWorld: the pawn sends it
+ * turns, mirrors its state into the properties below after every step, and presents it
+ * (actor transform, wall meshes, camera, HUD). The tunables are pushed to the simulation
+ * at BeginPlay and whenever the debug sliders change them.
  */
 UCLASS()
 class ARMAGETRONUE5_API AArmaCyclePawn : public APawn
@@ -26,6 +32,7 @@ public:
 	AArmaCyclePawn();
 
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void Tick(float DeltaTime) override;
 	virtual void SetupPlayerInputComponent(UInputComponent* PlayerInputComponent) override;
 
@@ -107,9 +114,6 @@ public:
 	UPROPERTY(BlueprintReadOnly, Category = "Rubber")
 	float CurrentWallSide = 0.0f;  // Side of the wall we're currently on (from last collision check)
 	
-	UPROPERTY(BlueprintReadOnly, Category = "Rubber")
-	int32 CurrentWallID = 0;  // ID of the wall we're tracking side for
-	
 	// Grace period after turn to allow escaping tight situations (digging mechanic)
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rubber")
 	float TurnGracePeriod = 0.15f;  // Time after turn where collision is relaxed
@@ -197,6 +201,12 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "WallLength")
 	float WallDecayRate = 0.0f;  // Units per second that wall tail shrinks (0 = no decay)
 	
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "WallLength")
+	float WallsStayUpDelay = -1.0f;  // -1 = walls stay until respawn, >=0 = seconds they stay up after death (sg_wallsStayUpDelay)
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "WallLength")
+	float ExplosionRadius = 160.0f;  // Walls this close to where the cycle dies get a hole (sg_explosionRadius, scaled like the speeds; 0 = none)
+	
 	UPROPERTY(BlueprintReadOnly, Category = "WallLength")
 	float TotalWallLength = 0.0f;  // Current total length of all walls
 
@@ -217,6 +227,31 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Physics")
 	void Respawn();
 	
+	// ========== Simulation (FArmaSimWorld in UArmaCollisionSubsystem) ==========
+	int32 GetSimCycle() const { return SimCycle; }
+	
+	// The cycle's simulated position (the actor only follows it once per frame)
+	FVector2D GetSimLocation() const;
+	
+	// The tunables above as simulation parameters
+	FArmaSimCycleParams MakeSimParams() const;
+	
+	// Copy the cycle's state into the mirrored properties (after every step)
+	void SyncFromSim();
+	
+	// Death or spark from the simulation
+	void HandleSimEvent(const FArmaSimEvent& Event);
+	
+	// Wall visuals, driven by the simulation's registry wall backend
+	AActor* CreateWallVisual(FVector2D Start);
+	void FinalizeWallVisual(AActor* Visual, FVector2D Start, FVector2D End);
+	void UpdateWallVisual(AActor* Visual, FVector2D Start, FVector2D End);
+	
+	// ========== Simulation Step ==========
+	// Per-step input hook (AI thinking) before the simulation steps - from Tick with the
+	// render DeltaTime, or from UArmaCollisionSubsystem::OnSimStep in fixed-step mode
+	virtual void SimulateStep(float DeltaTime);
+	
 	// Collision callbacks
 	UFUNCTION()
 	void OnWallHit(UPrimitiveComponent* HitComponent, AActor* OtherActor, 
@@ -228,29 +263,26 @@ public:
 
 protected:
 	// ========== Physics Helpers ==========
-	void UpdateRubber(float DeltaTime);
-	void UpdateWallAcceleration(float DeltaTime);
-	void UpdateWallDecay();  // Remove old wall segments when exceeding max length
-	bool CheckWallCollision(const FVector& DesiredMove, FVector& OutNewLocation);
-	float GetDistanceToNearestWall(FVector Direction) const;
 	void SpawnSpark(FVector Location, FVector Normal);
 	void UpdateInvulnerabilityBlink();
-	void ClearAllWalls();
-	// ========== Turn Queue (sg_cycleTurnMemory from original) ==========
-	// Pending turns queue (like original pendingTurns deque)
-	// Values: -1 = left, +1 = right
-	TArray<int32> PendingTurns;
 	
-	// Process any pending turns that are now ready to execute
-	void ProcessPendingTurns();
+	// Simulation of this world, nullptr if there is none
+	FArmaSimWorld* GetSimWorld() const;
+	
+	// Push the tunables (and the mirrored speed and rubber) to the cycle after a change
+	void PushSimParams();
+	void SetSimSpeed(float Speed);
+	
+	// Index of our cycle in the simulation
+	int32 SimCycle = INDEX_NONE;
 	
 	// ========== Input Handlers ==========
 	void TurnLeft();
 	void TurnRight();
 	
-	// Internal turn execution (called directly or from queue)
-	void ExecuteTurnLeft();
-	void ExecuteTurnRight();
+	// Send a turn to the simulation, timestamped with the input (-1 = left, 1 = right)
+	void RequestTurn(int32 Direction);
+	
 	void OnBrakePressed();
 	void OnBrakeReleased();
 	
@@ -260,26 +292,7 @@ protected:
 	void OnZoomOut();
 
 	// ========== Trail System ==========
-	// Wall segment as 2D line (start and end points)
-	struct FWallSegment
-	{
-		FVector2D Start;
-		FVector2D End;
-		AActor* Actor;
-		float CreationTime; // When this wall was created
-		
-		FWallSegment() : Start(FVector2D::ZeroVector), End(FVector2D::ZeroVector), Actor(nullptr), CreationTime(0) {}
-		FWallSegment(FVector2D InStart, FVector2D InEnd, AActor* InActor, float InTime) 
-			: Start(InStart), End(InEnd), Actor(InActor), CreationTime(InTime) {}
-	};
-	
-	UPROPERTY()
-	TArray<AActor*> WallActors;
-	
-	// Wall segments for 2D collision (parallel array with WallActors)
-	TArray<FWallSegment> WallSegments;
-	
-	// The currently growing wall segment (updated every frame)
+	// The currently growing wall segment (rebuilt every frame from the cycle's wall start)
 	// Uses procedural mesh component (like rim walls) for proper rendering
 	UPROPERTY()
 	class AActor* CurrentWallActor;
@@ -287,19 +300,10 @@ protected:
 	UPROPERTY()
 	UMaterialInstanceDynamic* CurrentWallMaterial;
 	
-	FVector CurrentWallStart;
 	float GameStartTime;
-	int32 WallCount = 0;
-	
-	// ID of current growing wall in the global registry (declared above in Rubber section)
 	
-	void StartNewWallSegment();
 	void UpdateCurrentWall();
-	AActor* SpawnWallSegment(FVector Start, FVector End);
-	void CreateCurrentWallActor();
-	
-	// 2D collision helper
-	float DistanceToLineSegment2D(FVector2D Point, FVector2D LineStart, FVector2D LineEnd) const;
+	void BuildWallMesh(class UProceduralMeshComponent* ProcMesh, const FVector& Start, const FVector& End);
 
 	// ========== Environment ==========
 	void SpawnFloorGrid();
@@ -330,6 +334,11 @@ protected:
 
 	void UpdateCamera(float DeltaTime);
 	void DrawHUD();
+	
+	// Once per rendered frame after the simulation: rotation smoothing, camera, HUD, menu
+	void UpdatePresentation(float DeltaTime);
+	
+	FDelegateHandle SimStepHandle;
 
 	// ========== Debug Controls ==========
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Debug")
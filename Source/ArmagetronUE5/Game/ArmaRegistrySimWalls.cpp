@@ -0,0 +1,397 @@
+// ArmaRegistrySimWalls.cpp - Simulation wall backend on top of the world's wall registry
+
+#include "ArmaRegistrySimWalls.h"
+#include "ArmaCyclePawn.h"
+
+void FArmaRegistrySimWalls::SetOwner(int32 Cycle, AArmaCyclePawn* Pawn)
+{
+	if (Cycle == INDEX_NONE)
+	{
+		return;
+	}
+	if (Cycle >= Cycles.Num())
+	{
+		Cycles.SetNum(Cycle + 1);
+	}
+
+	FCycleRef& Ref = Cycles[Cycle];
+	if (AArmaCyclePawn* OldPawn = Ref.Pawn.Get())
+	{
+		CycleByOwner.Remove(OldPawn);
+	}
+
+	Ref.Pawn = Pawn;
+	Ref.ForwardRayCache.Invalidate();
+	if (Pawn)
+	{
+		CycleByOwner.Add(Pawn, Cycle);
+	}
+}
+
+AArmaCyclePawn* FArmaRegistrySimWalls::GetOwner(int32 Cycle) const
+{
+	return Cycles.IsValidIndex(Cycle) ? Cycles[Cycle].Pawn.Get() : nullptr;
+}
+
+void FArmaRegistrySimWalls::RemoveExpiredWalls()
+{
+	if (UArmaWallRegistry* Registry = GetRegistry())
+	{
+		NumExpired += Registry->RemoveExpiredWalls();
+	}
+}
+
+uint32 FArmaRegistrySimWalls::GetForeignChangeStamp() const
+{
+	// Everything else in the registry is changed through us; both counts only grow
+	const UArmaWallRegistry* Registry = GetRegistry();
+	return (Registry ? Registry->GetLayoutEpoch() : 0) + NumExpired;
+}
+
+int32 FArmaRegistrySimWalls::AddWall(int32 Owner, FVector2D Start)
+{
+	UArmaWallRegistry* Registry = GetRegistry();
+	if (!Registry)
+	{
+		return INDEX_NONE;
+	}
+
+	// The visual is created with the wall so the registry can destroy them together
+	AArmaCyclePawn* Pawn = GetOwner(Owner);
+	AActor* Visual = Pawn ? Pawn->CreateWallVisual(Start) : nullptr;
+
+	const FArmaWallHandle Handle = Registry->RegisterWall(Start, Start, EArmaWallType::Cycle, Pawn, Visual);
+	if (Handle.Index >= WallRefs.Num())
+	{
+		WallRefs.SetNum(Handle.Index + 1);
+	}
+	WallRefs[Handle.Index].Handle = Handle;
+	WallRefs[Handle.Index].bGrowing = true;
+	return Handle.Index;
+}
+
+void FArmaRegistrySimWalls::UpdateWallEnd(int32 Wall, FVector2D End)
+{
+	if (UArmaWallRegistry* Registry = GetRegistry())
+	{
+		Registry->UpdateWallEnd(GetHandle(Wall), End);
+	}
+}
+
+void FArmaRegistrySimWalls::UpdateWallStart(int32 Wall, FVector2D Start)
+{
+	UArmaWallRegistry* Registry = GetRegistry();
+	if (!Registry)
+	{
+		return;
+	}
+
+	const FArmaWallHandle Handle = GetHandle(Wall);
+	Registry->UpdateWallStart(Handle, Start);
+
+	// A finalized wall's mesh only changes here
+	const FArmaRegisteredWall* Registered = Registry->FindWall(Handle);
+	if (Registered && !WallRefs[Wall].bGrowing)
+	{
+		if (AArmaCyclePawn* Pawn = Cast<AArmaCyclePawn>(Registered->OwnerActor))
+		{
+			Pawn->UpdateWallVisual(Registered->VisualActor, Registered->Start, Registered->End);
+		}
+	}
+}
+
+void FArmaRegistrySimWalls::FinalizeWall(int32 Wall, FVector2D End)
+{
+	UArmaWallRegistry* Registry = GetRegistry();
+	if (!Registry)
+	{
+		return;
+	}
+
+	const FArmaWallHandle Handle = GetHandle(Wall);
+	Registry->FinalizeWall(Handle, End);
+
+	if (const FArmaRegisteredWall* Registered = Registry->FindWall(Handle))
+	{
+		WallRefs[Wall].bGrowing = false;
+		if (AArmaCyclePawn* Pawn = Cast<AArmaCyclePawn>(Registered->OwnerActor))
+		{
+			Pawn->FinalizeWallVisual(Registered->VisualActor, Registered->Start, Registered->End);
+		}
+	}
+}
+
+int32 FArmaRegistrySimWalls::SplitWall(int32 Wall, FVector2D HoleStart, FVector2D HoleEnd)
+{
+	UArmaWallRegistry* Registry = GetRegistry();
+	const FArmaRegisteredWall* Registered = Registry ? Registry->FindWall(GetHandle(Wall)) : nullptr;
+	if (!Registered)
+	{
+		return INDEX_NONE;
+	}
+
+	// The far piece gets its own visual; both meshes are rebuilt for the shorter walls
+	AArmaCyclePawn* Pawn = Cast<AArmaCyclePawn>(Registered->OwnerActor);
+	AActor* NearVisual = Registered->VisualActor;
+	const FVector2D Start = Registered->Start;
+	const FVector2D End = Registered->End;
+	AActor* FarVisual = Pawn ? Pawn->CreateWallVisual(HoleEnd) : nullptr;
+
+	const FArmaWallHandle Far = Registry->SplitWall(GetHandle(Wall), HoleStart, HoleEnd, FarVisual);
+	if (Far.Index >= WallRefs.Num())
+	{
+		WallRefs.SetNum(Far.Index + 1);
+	}
+	WallRefs[Far.Index].Handle = Far;
+	WallRefs[Far.Index].bGrowing = false;
+
+	if (Pawn)
+	{
+		Pawn->FinalizeWallVisual(NearVisual, Start, HoleStart);
+		Pawn->FinalizeWallVisual(FarVisual, HoleEnd, End);
+	}
+	return Far.Index;
+}
+
+void FArmaRegistrySimWalls::RemoveWall(int32 Wall)
+{
+	// The registry destroys the visual with the wall
+	if (UArmaWallRegistry* Registry = GetRegistry())
+	{
+		Registry->RemoveWall(GetHandle(Wall));
+	}
+}
+
+void FArmaRegistrySimWalls::RemoveWallsByOwner(int32 Owner)
+{
+	UArmaWallRegistry* Registry = GetRegistry();
+	AArmaCyclePawn* Pawn = GetOwner(Owner);
+	if (Registry && Pawn)
+	{
+		Registry->RemoveWallsByOwner(Pawn);
+	}
+}
+
+void FArmaRegistrySimWalls::ExpireWallsByOwner(int32 Owner, float Delay)
+{
+	UArmaWallRegistry* Registry = GetRegistry();
+	AArmaCyclePawn* Pawn = GetOwner(Owner);
+	if (Registry && Pawn)
+	{
+		Registry->ExpireWallsByOwner(Pawn, Delay);
+	}
+}
+
+FArmaRayQuery FArmaRegistrySimWalls::MakeQuery(const FArmaSimRay& Ray) const
+{
+	return FArmaRayQuery(Ray.Origin, Ray.Direction, Ray.MaxDistance, GetOwner(Ray.IgnoreOwner), Ray.GraceTime);
+}
+
+FArmaSimHit FArmaRegistrySimWalls::MakeHit(const FArmaRayHit& Hit) const
+{
+	FArmaSimHit Result;
+	if (!Hit.IsHit())
+	{
+		return Result;
+	}
+
+	Result.Distance = Hit.Distance;
+	Result.Side = Hit.Side;
+	Result.Wall = Hit.Wall.Index;
+	Result.bRim = Hit.WallType == EArmaWallType::Rim;
+	if (const int32* Owner = Hit.OwnerActor ? CycleByOwner.Find(Hit.OwnerActor) : nullptr)
+	{
+		Result.Owner = *Owner;
+	}
+	return Result;
+}
+
+void FArmaRegistrySimWalls::CastRays(TConstArrayView<FArmaSimRay> Rays, TArrayView<FArmaSimHit> OutHits)
+{
+	check(Rays.Num() == OutHits.Num());
+
+	const UArmaWallRegistry* Registry = GetRegistry();
+	if (!Registry)
+	{
+		for (FArmaSimHit& Hit : OutHits)
+		{
+			Hit = FArmaSimHit();
+		}
+		return;
+	}
+
+	TArray<FArmaRayQuery, TInlineAllocator<64>> Queries;
+	TArray<FArmaRayHit, TInlineAllocator<64>> Hits;
+	for (const FArmaSimRay& Ray : Rays)
+	{
+		Queries.Add(MakeQuery(Ray));
+	}
+	Hits.SetNum(Queries.Num());
+	CastClustered(*Registry, Queries, Hits);
+
+	for (int32 i = 0; i < Rays.Num(); i++)
+	{
+		OutHits[i] = MakeHit(Hits[i]);
+	}
+}
+
+FArmaSimHit FArmaRegistrySimWalls::CastForwardRay(int32 Cycle, const FArmaSimRay& Ray)
+{
+	// While nothing changed in the corridor ahead, only the growing walls are scanned
+	// and the wall index isn't touched at all
+	const UArmaWallRegistry* Registry = GetRegistry();
+	if (!Registry || !Cycles.IsValidIndex(Cycle))
+	{
+		return IArmaSimWalls::CastForwardRay(Cycle, Ray);
+	}
+	return MakeHit(Registry->RaycastWallsCached(MakeQuery(Ray), Cycles[Cycle].ForwardRayCache));
+}
+
+void FArmaRegistrySimWalls::ForgetCycle(int32 Cycle)
+{
+	if (Cycles.IsValidIndex(Cycle))
+	{
+		Cycles[Cycle].ForwardRayCache.Invalidate();
+	}
+}
+
+FArmaSimSideWalls FArmaRegistrySimWalls::FindNearestSideWalls(FVector2D Position, FVector2D Direction, float MaxDistance, int32 IgnoreOwner, float GraceTime)
+{
+	FArmaSimSideWalls Result;
+	if (const UArmaWallRegistry* Registry = GetRegistry())
+	{
+		const FArmaSideWalls SideWalls = Registry->FindNearestSideWalls(Position, Direction, MaxDistance, GetOwner(IgnoreOwner), GraceTime);
+		if (SideWalls.HasLeft())
+		{
+			Result.LeftDistance = SideWalls.LeftDistance;
+		}
+		if (SideWalls.HasRight())
+		{
+			Result.RightDistance = SideWalls.RightDistance;
+		}
+	}
+	return Result;
+}
+
+void FArmaRegistrySimWalls::CastClustered(const UArmaWallRegistry& Registry, TConstArrayView<FArmaRayQuery> Queries, TArrayView<FArmaRayHit> OutHits) const
+{
+	const int32 NumQueries = Queries.Num();
+
+	// Swept box of each ray
+	TArray<FBox2D, TInlineAllocator<64>> Boxes;
+	TArray<int32, TInlineAllocator<64>> SortedByMinX;
+	for (int32 i = 0; i < NumQueries; i++)
+	{
+		const FArmaRayQuery& Query = Queries[i];
+		FBox2D Box(ForceInit);
+		Box += Query.Origin;
+		Box += Query.Origin + Query.Direction.GetSafeNormal() * Query.MaxDistance;
+		Boxes.Add(Box);
+		SortedByMinX.Add(i);
+	}
+	SortedByMinX.Sort([&Boxes](int32 A, int32 B)
+	{
+		return Boxes[A].Min.X < Boxes[B].Min.X || (Boxes[A].Min.X == Boxes[B].Min.X && A < B);
+	});
+
+	// Union-find over queries whose boxes overlap
+	TArray<int32, TInlineAllocator<64>> Parent;
+	Parent.SetNumUninitialized(NumQueries);
+	for (int32 i = 0; i < NumQueries; i++)
+	{
+		Parent[i] = i;
+	}
+	auto FindRoot = [&Parent](int32 i)
+	{
+		while (Parent[i] != i)
+		{
+			Parent[i] = Parent[Parent[i]];
+			i = Parent[i];
+		}
+		return i;
+	};
+
+	// Sweep along X: a box only meets the boxes still open when it starts, then prune on Y
+	TArray<int32, TInlineAllocator<64>> Active;
+	for (int32 Query : SortedByMinX)
+	{
+		const FBox2D& Box = Boxes[Query];
+		Active.RemoveAllSwap([&](int32 Other) { return Boxes[Other].Max.X < Box.Min.X; }, EAllowShrinking::No);
+
+		for (int32 Other : Active)
+		{
+			if (Boxes[Other].Min.Y <= Box.Max.Y && Box.Min.Y <= Boxes[Other].Max.Y)
+			{
+				const int32 RootA = FindRoot(Query);
+				const int32 RootB = FindRoot(Other);
+				if (RootA != RootB)
+				{
+					// Lower index becomes the root so clusters come out in query order
+					Parent[FMath::Max(RootA, RootB)] = FMath::Min(RootA, RootB);
+				}
+			}
+		}
+		Active.Add(Query);
+	}
+
+	// Group queries by cluster (clusters in order of their first query), one registry batch each
+	TArray<int32, TInlineAllocator<64>> Roots;
+	TArray<int32, TInlineAllocator<64>> ByCluster;
+	for (int32 i = 0; i < NumQueries; i++)
+	{
+		Roots.Add(FindRoot(i));
+		ByCluster.Add(i);
+	}
+	ByCluster.Sort([&Roots](int32 A, int32 B)
+	{
+		return Roots[A] < Roots[B] || (Roots[A] == Roots[B] && A < B);
+	});
+
+	TArray<FArmaRayQuery, TInlineAllocator<16>> ClusterQueries;
+	TArray<FArmaRayHit, TInlineAllocator<16>> ClusterHits;
+	for (int32 Begin = 0; Begin < NumQueries;)
+	{
+		int32 End = Begin + 1;
+		while (End < NumQueries && Roots[ByCluster[End]] == Roots[ByCluster[Begin]])
+		{
+			End++;
+		}
+
+		ClusterQueries.Reset();
+		for (int32 j = Begin; j < End; j++)
+		{
+			ClusterQueries.Add(Queries[ByCluster[j]]);
+		}
+		ClusterHits.SetNum(ClusterQueries.Num());
+		Registry.RaycastWallsBatch(ClusterQueries, ClusterHits);
+
+		for (int32 j = Begin; j < End; j++)
+		{
+			OutHits[ByCluster[j]] = ClusterHits[j - Begin];
+		}
+		Begin = End;
+	}
+}
+
+void FArmaRegistrySimWalls::FindCycleWallsInRange(FVector2D Center, float Radius, TArray<FArmaSimWallInRange>& OutWalls)
+{
+	const UArmaWallRegistry* Registry = GetRegistry();
+	if (!Registry)
+	{
+		return;
+	}
+
+	Registry->ProcessCycleWallsInRange(Center, Radius, [&](FArmaWallHandle Handle, float BeginDist, float EndDist)
+	{
+		FArmaSimWallInRange& Found = OutWalls.AddDefaulted_GetRef();
+		Found.Wall = Handle.Index;
+		Found.BeginDist = BeginDist;
+		Found.EndDist = EndDist;
+
+		const FArmaRegisteredWall* Registered = Registry->FindWall(Handle);
+		if (const int32* Owner = Registered && Registered->OwnerActor ? CycleByOwner.Find(Registered->OwnerActor) : nullptr)
+		{
+			Found.Owner = *Owner;
+		}
+	});
+}
@@ -0,0 +1,86 @@
+// ArmaRegistrySimWalls.h - Simulation wall backend on top of the world's wall registry
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+#include "Sim/ArmaSimWalls.h"
+#include "ArmaWallRegistry.h"
+
+class AArmaCyclePawn;
+
+/**
+ * FArmaRegistrySimWalls - Lets FArmaSimWorld collide against UArmaWallRegistry
+ * Each simulation cycle is presented by a pawn, which owns its registry walls and their
+ * visual actors, so rays, side queries, snapshots and history see the same walls as the
+ * rest of the game. Wall ids are registry slot indices.
+ *
+ * Forward rays are answered from each cycle's FArmaRayCache when possible. For the rest
+ * (the post-move probes) the rays' bounding boxes are swept and pruned along X, and rays
+ * whose boxes overlap are batched into one registry query, so each cluster of nearby
+ * cycles gathers its candidate walls from the wall index once.
+ */
+class ARMAGETRONUE5_API FArmaRegistrySimWalls : public IArmaSimWalls
+{
+public:
+	explicit FArmaRegistrySimWalls(UWorld* InWorld) : World(InWorld) {}
+
+	// The pawn presenting a cycle; nullptr detaches it
+	void SetOwner(int32 Cycle, AArmaCyclePawn* Pawn);
+	AArmaCyclePawn* GetOwner(int32 Cycle) const;
+
+	// Drop the registry walls whose stay-up time ran out (before each step)
+	void RemoveExpiredWalls();
+
+	// IArmaSimWalls interface
+	virtual void SetTime(double Time) override {}	// The registry reads the collision subsystem's clock
+	virtual int32 AddWall(int32 Owner, FVector2D Start) override;
+	virtual void UpdateWallEnd(int32 Wall, FVector2D End) override;
+	virtual void UpdateWallStart(int32 Wall, FVector2D Start) override;
+	virtual void FinalizeWall(int32 Wall, FVector2D End) override;
+	virtual int32 SplitWall(int32 Wall, FVector2D HoleStart, FVector2D HoleEnd) override;
+	virtual void RemoveWall(int32 Wall) override;
+	virtual void RemoveWallsByOwner(int32 Owner) override;
+	virtual void ExpireWallsByOwner(int32 Owner, float Delay) override;
+	virtual void CastRays(TConstArrayView<FArmaSimRay> Rays, TArrayView<FArmaSimHit> OutHits) override;
+	virtual FArmaSimHit CastForwardRay(int32 Cycle, const FArmaSimRay& Ray) override;
+	virtual void ForgetCycle(int32 Cycle) override;
+	virtual FArmaSimSideWalls FindNearestSideWalls(FVector2D Position, FVector2D Direction, float MaxDistance, int32 IgnoreOwner, float GraceTime) override;
+	virtual void FindCycleWallsInRange(FVector2D Center, float Radius, TArray<FArmaSimWallInRange>& OutWalls) override;
+	virtual uint32 GetForeignChangeStamp() const override;
+	virtual float GetParallelTolerance() const override { return UArmaWallRegistry::GetParallelTolerance(); }
+
+private:
+	UArmaWallRegistry* GetRegistry() const { return UArmaWallRegistry::Get(World); }
+
+	// Registry handle of a wall id, invalid if the sim never got it from us
+	FArmaWallHandle GetHandle(int32 Wall) const { return WallRefs.IsValidIndex(Wall) ? WallRefs[Wall].Handle : FArmaWallHandle(); }
+
+	FArmaRayQuery MakeQuery(const FArmaSimRay& Ray) const;
+	FArmaSimHit MakeHit(const FArmaRayHit& Hit) const;
+
+	// Cast every query, batching the ones whose swept boxes overlap
+	void CastClustered(const UArmaWallRegistry& Registry, TConstArrayView<FArmaRayQuery> Queries, TArrayView<FArmaRayHit> OutHits) const;
+
+	UWorld* World = nullptr;
+
+	// By cycle index: the presenting pawn and its last forward ray
+	struct FCycleRef
+	{
+		TWeakObjectPtr<AArmaCyclePawn> Pawn;
+		FArmaRayCache ForwardRayCache;
+	};
+	TArray<FCycleRef> Cycles;
+	TMap<TObjectKey<AActor>, int32> CycleByOwner;
+
+	// By wall id (registry slot)
+	struct FWallRef
+	{
+		FArmaWallHandle Handle;
+		bool bGrowing = false;		// The owner's visual is rebuilt every frame, not here
+	};
+	TArray<FWallRef> WallRefs;
+
+	// Walls removed by RemoveExpiredWalls so far
+	uint32 NumExpired = 0;
+};
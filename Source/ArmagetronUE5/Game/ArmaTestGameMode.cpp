@@ -3,6 +3,7 @@
 #include "ArmaTestGameMode.h"
 #include "ArmaCyclePawn.h"
 #include "ArmaWallRegistry.h"
+#include "Core/ArmaGrid.h"
 #include "AI/ArmaAICycle.h"
 #include "GameFramework/PlayerController.h"
 #include "Engine/World.h"
@@ -25,6 +26,21 @@ void AArmaTestGameMode::BeginPlay()
 	
 	// Spawn AI players
 	SpawnAIPlayers();
+	
+	StartRound();
+}
+
+void AArmaTestGameMode::StartRound()
+{
+	RoundNumber++;
+	
+	if (UArmaGridSubsystem* Grid = GetWorld()->GetSubsystem<UArmaGridSubsystem>())
+	{
+		if (Grid->NeedsCompaction())
+		{
+			Grid->Compact();
+		}
+	}
 }
 
 void AArmaTestGameMode::SpawnArenaRim()
@@ -37,6 +53,23 @@ void AArmaTestGameMode::SpawnArenaRim()
 		UE_LOG(LogTemp, Warning, TEXT("ArmaTestGameMode: Spawned arena rim walls (%.0fx%.0f)"), 
 			ArenaHalfSize * 2, ArenaHalfSize * 2);
 	}
+
+	// The collision grid reaches a little past the rim, which goes in as static constrained
+	// edges; cycle walls are added as they finalize
+	if (UArmaGridSubsystem* Grid = GetWorld()->GetSubsystem<UArmaGridSubsystem>())
+	{
+		Grid->CreateGrid(ArenaHalfSize * 2.0f + GridMargin * 2.0f);
+		const FArmaCoord Corners[] = {
+			FArmaCoord(-ArenaHalfSize, -ArenaHalfSize),
+			FArmaCoord(ArenaHalfSize, -ArenaHalfSize),
+			FArmaCoord(ArenaHalfSize, ArenaHalfSize),
+			FArmaCoord(-ArenaHalfSize, ArenaHalfSize),
+		};
+		for (int32 i = 0; i < 4; i++)
+		{
+			Grid->InsertWall(Corners[i], Corners[(i + 1) % 4]);
+		}
+	}
 }
 
 void AArmaTestGameMode::SpawnAIPlayers()
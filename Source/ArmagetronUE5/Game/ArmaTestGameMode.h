@@ -21,10 +21,19 @@ public:
 	
 	virtual void BeginPlay() override;
 	
+	// A new round begins: at arena setup and whenever the player respawns. Nothing holds
+	// grid IDs across it, so the collision grid is compacted here when it needs it
+	UFUNCTION(BlueprintCallable, Category = "Round")
+	void StartRound();
+	
 	// Number of AI players to spawn
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI")
 	int32 NumAIPlayers = 1;
 	
+	// Rounds started so far
+	UPROPERTY(BlueprintReadOnly, Category = "Round")
+	int32 RoundNumber = 0;
+	
 	// Spawned AI players
 	UPROPERTY(BlueprintReadOnly, Category = "AI")
 	TArray<AArmaAICycle*> AIPlayers;
@@ -33,6 +42,10 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Arena")
 	float ArenaHalfSize = 5000.0f;
 	
+	// How far the collision grid extends beyond the rim
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Arena")
+	float GridMargin = 500.0f;
+	
 protected:
 	void SpawnAIPlayers();
 	void SpawnArenaRim();
@@ -3,6 +3,8 @@
 #include "ArmaWall.h"
 #include "ArmaCycle.h"
 #include "ArmaCycleMovement.h"
+#include "ArmaCollisionSubsystem.h"
+#include "Core/ArmaGrid.h"
 #include "ProceduralMeshComponent.h"
 #include "Materials/MaterialInstanceDynamic.h"
 #include "Materials/Material.h"
@@ -95,6 +97,16 @@ void AArmaWall::Tick(float DeltaTime)
 
 void AArmaWall::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
+	// Take the wall's edges out of the grid; a world going away drops the whole grid anyway
+	if (bInGrid && (EndPlayReason == EEndPlayReason::Destroyed || EndPlayReason == EEndPlayReason::RemovedFromWorld))
+	{
+		if (UArmaGridSubsystem* Grid = GetWorld()->GetSubsystem<UArmaGridSubsystem>())
+		{
+			Grid->RemoveWall(this);
+		}
+		bInGrid = false;
+	}
+
 	Super::EndPlay(EndPlayReason);
 }
 
@@ -112,7 +124,7 @@ void AArmaWall::Initialize(AArmaCycle* InOwnerCycle, const FArmaColor& Color)
 		FVector Forward = InOwnerCycle->GetActorForwardVector();
 		Direction = FArmaCoord(Forward.X, Forward.Y).Normalized();
 
-		BeginTime = GetWorld()->GetTimeSeconds();
+		BeginTime = UArmaCollisionSubsystem::GetSimTime(GetWorld());
 		EndTime = BeginTime;
 
 		// Get distance from cycle movement
@@ -142,6 +154,18 @@ void AArmaWall::Initialize(AArmaCycle* InOwnerCycle, const FArmaColor& Color)
 void AArmaWall::Finalize()
 {
 	bFinalized = true;
+
+	// A finished wall no longer moves, so it goes into the collision grid now (like
+	// gPlayerWall's gridding); EndPlay takes it out again
+	if (!bInGrid)
+	{
+		UArmaGridSubsystem* Grid = GetWorld()->GetSubsystem<UArmaGridSubsystem>();
+		if (Grid && Grid->HasGrid())
+		{
+			bInGrid = Grid->InsertWall(BeginPoint, EndPoint, this) >= 0;
+			GriddingTime = EndTime;
+		}
+	}
 }
 
 void AArmaWall::UpdateEnd(const FArmaCoord& NewEnd, float Time)
@@ -158,7 +182,7 @@ void AArmaWall::Checkpoint()
 {
 	// Add a checkpoint segment for interpolation accuracy
 	float CurrentDist = EndDist;
-	float CurrentTime = GetWorld()->GetTimeSeconds();
+	float CurrentTime = UArmaCollisionSubsystem::GetSimTime(GetWorld());
 	
 	// Only add if there's been meaningful movement
 	if (Segments.Num() > 0)
@@ -247,7 +271,7 @@ void AArmaWall::BlowHole(float HoleBeginDist, float HoleEndDist, AActor* Holer)
 	if (HoleEndDist <= HoleBeginDist)
 		return;
 
-	float CurrentTime = GetWorld()->GetTimeSeconds();
+	float CurrentTime = UArmaCollisionSubsystem::GetSimTime(GetWorld());
 
 	// Find where to insert hole segments
 	int32 BeginIndex = FindSegmentIndexByPos(HoleBeginDist);
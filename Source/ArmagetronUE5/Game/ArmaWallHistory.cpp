@@ -0,0 +1,283 @@
+// ArmaWallHistory.cpp - Wall history implementation
+
+#include "ArmaWallHistory.h"
+#include "Core/ArmaWallKernel.h"
+#include "ArmagetronUE5.h"
+
+void FArmaWallHistory::SetWindow(float Seconds)
+{
+	Window = Seconds;
+	if (!IsRecording())
+	{
+		Reset();
+	}
+}
+
+void FArmaWallHistory::Reset()
+{
+	Records.Empty();
+	SlotToRecord.Empty();
+	RemovedOrder.Reset();
+	FoldQueue.Reset();
+	Hash.Reset();
+	OldestTime = 0.0f;
+}
+
+FArmaWallHistory::FRecord* FArmaWallHistory::FindLive(FArmaWallHandle Handle, int32* OutRecordIndex)
+{
+	if (!SlotToRecord.IsValidIndex(Handle.Index) || SlotToRecord[Handle.Index] == INDEX_NONE)
+	{
+		return nullptr;
+	}
+	const int32 RecordIndex = SlotToRecord[Handle.Index];
+	FRecord& Record = Records[RecordIndex];
+	if (Record.Handle != Handle)
+	{
+		return nullptr;
+	}
+	if (OutRecordIndex)
+	{
+		*OutRecordIndex = RecordIndex;
+	}
+	return &Record;
+}
+
+void FArmaWallHistory::RecordAdded(const FArmaRegisteredWall& Wall, float Time)
+{
+	if (!IsRecording())
+	{
+		return;
+	}
+
+	FRecord Record;
+	Record.Handle = Wall.Handle;
+	Record.WallType = Wall.WallType;
+	Record.OwnerActor = Wall.OwnerActor;
+	Record.CreationTime = Time;
+	Record.StartLog.Add({ Time, FVector2f(Wall.Start) });
+	Record.EndLog.Add({ Time, FVector2f(Wall.End) });
+	Record.Bounds += Wall.Start;
+	Record.Bounds += Wall.End;
+	const FBox2D Bounds = Record.Bounds;
+	const int32 RecordIndex = Records.Add(MoveTemp(Record));
+	Hash.Insert(RecordIndex, Bounds.Min, Bounds.Max);
+
+	while (SlotToRecord.Num() <= Wall.Handle.Index)
+	{
+		SlotToRecord.Add(INDEX_NONE);
+	}
+	SlotToRecord[Wall.Handle.Index] = RecordIndex;
+}
+
+void FArmaWallHistory::RecordStart(FArmaWallHandle Handle, FVector2D Start, float Time)
+{
+	int32 RecordIndex;
+	if (FRecord* Record = FindLive(Handle, &RecordIndex))
+	{
+		AppendSample(RecordIndex, Record->StartLog, Time, Start);
+	}
+}
+
+void FArmaWallHistory::RecordEnd(FArmaWallHandle Handle, FVector2D End, float Time)
+{
+	int32 RecordIndex;
+	if (FRecord* Record = FindLive(Handle, &RecordIndex))
+	{
+		AppendSample(RecordIndex, Record->EndLog, Time, End);
+	}
+}
+
+void FArmaWallHistory::RecordRemoved(FArmaWallHandle Handle, float Time)
+{
+	int32 RecordIndex;
+	if (FRecord* Record = FindLive(Handle, &RecordIndex))
+	{
+		Record->RemovalTime = Time;
+		SlotToRecord[Handle.Index] = INDEX_NONE;
+		RemovedOrder.Add(RecordIndex);
+	}
+}
+
+void FArmaWallHistory::AppendSample(int32 RecordIndex, TArray<FSample>& Log, float Time, FVector2D Point)
+{
+	// The hash only moves the record when the point leaves its box
+	FRecord& Record = Records[RecordIndex];
+	const FBox2D Grown = Record.Bounds + Point;
+	if (Grown.Min != Record.Bounds.Min || Grown.Max != Record.Bounds.Max)
+	{
+		Record.Bounds = Grown;
+		Hash.Update(RecordIndex, Grown.Min, Grown.Max);
+	}
+
+	// One sample per frame: a second move in the same frame overwrites it
+	if (Log.Num() > 0 && Log.Last().Time >= Time)
+	{
+		Log.Last().Point = FVector2f(Point);
+		return;
+	}
+	Log.Add({ Time, FVector2f(Point) });
+	FoldQueue.Emplace(RecordIndex, Time);
+}
+
+void FArmaWallHistory::TrimLog(TArray<FSample>& Log, float Cutoff)
+{
+	// Keep the last sample at or before the cutoff - it is the state at the window's start
+	int32 Lo = 0;
+	int32 Hi = Log.Num();
+	while (Lo < Hi)
+	{
+		const int32 Mid = (Lo + Hi) / 2;
+		if (Log[Mid].Time <= Cutoff)
+		{
+			Lo = Mid + 1;
+		}
+		else
+		{
+			Hi = Mid;
+		}
+	}
+	if (Lo > 1)
+	{
+		Log.RemoveAt(0, Lo - 1, EAllowShrinking::No);
+	}
+}
+
+void FArmaWallHistory::Trim(float Now)
+{
+	if (!IsRecording())
+	{
+		return;
+	}
+
+	const float Cutoff = Now - Window;
+	OldestTime = FMath::Max(OldestTime, Cutoff);
+
+	while (!FoldQueue.IsEmpty() && FoldQueue.First().Value < Cutoff)
+	{
+		const int32 RecordIndex = FoldQueue.PopFrontValue().Key;
+		if (Records.IsValidIndex(RecordIndex))
+		{
+			TrimLog(Records[RecordIndex].StartLog, Cutoff);
+			TrimLog(Records[RecordIndex].EndLog, Cutoff);
+		}
+	}
+
+	while (!RemovedOrder.IsEmpty() && Records[RemovedOrder.First()].RemovalTime < Cutoff)
+	{
+		const int32 RecordIndex = RemovedOrder.PopFrontValue();
+		Hash.Remove(RecordIndex);
+		Records.RemoveAt(RecordIndex);
+	}
+}
+
+FVector2D FArmaWallHistory::SampleAt(const TArray<FSample>& Log, float Time)
+{
+	// Last sample at or before Time (the first one if Time predates the log)
+	int32 Lo = 1;
+	int32 Hi = Log.Num();
+	while (Lo < Hi)
+	{
+		const int32 Mid = (Lo + Hi) / 2;
+		if (Log[Mid].Time <= Time)
+		{
+			Lo = Mid + 1;
+		}
+		else
+		{
+			Hi = Mid;
+		}
+	}
+	return FVector2D(Log[Lo - 1].Point);
+}
+
+FArmaRayHit FArmaWallHistory::Raycast(const FArmaRayQuery& Query, float Time) const
+{
+	FArmaRayHit Hit;
+
+	const FVector2D NormDir = Query.Direction.GetSafeNormal();
+	if (NormDir.IsZero() || Query.MaxDistance <= 0.0f)
+	{
+		return Hit;
+	}
+
+	// The walls before the window are gone - answering from what is left would be wrong
+	if (Time < OldestTime)
+	{
+		INC_DWORD_STAT(STAT_ArmaHistoryRaysOutOfWindow);
+		return Hit;
+	}
+
+	// Rebuild the walls standing at Time near the ray into a hot store and run the regular
+	// kernel on it. Owner tags are local: 1 = the ignored owner, 2 = anyone else, 0 = no
+	// owner. A null IgnoreOwner is tag 0 as in the registry, so young unowned walls get the grace too
+	FArmaWallHotStore Store;
+	TArray<int32, TInlineAllocator<256>> StoreToRecord;
+	TArray<TPair<FVector2D, FVector2D>, TInlineAllocator<256>> Geometry;
+	auto AddIfStanding = [&](int32 RecordIndex)
+	{
+		const FRecord& Record = Records[RecordIndex];
+		if (Record.CreationTime > Time || Record.RemovalTime <= Time)
+		{
+			return;
+		}
+
+		const FVector2D Start = SampleAt(Record.StartLog, Time);
+		const FVector2D End = SampleAt(Record.EndLog, Time);
+		const int32 OwnerTag = !Record.OwnerActor ? 0 : (Record.OwnerActor == Query.IgnoreOwner ? 1 : 2);
+		Store.Add(Start, End, Record.WallType == EArmaWallType::Rim, OwnerTag, Record.CreationTime);
+		StoreToRecord.Add(RecordIndex);
+		Geometry.Emplace(Start, End);
+	};
+
+	// Rays longer than this cover most cells anyway and visit every record
+	const float MaxGatherDistance = 100000.0f;
+	if (Query.MaxDistance > MaxGatherDistance)
+	{
+		for (auto It = Records.CreateConstIterator(); It; ++It)
+		{
+			AddIfStanding(It.GetIndex());
+		}
+	}
+	else
+	{
+		FBox2D Bounds(ForceInit);
+		Bounds += Query.Origin;
+		Bounds += Query.Origin + NormDir * Query.MaxDistance;
+
+		TBitArray<> Seen(false, Records.GetMaxIndex());
+		Hash.QueryBox(Bounds.ExpandBy(ParallelTolerance), [&](TConstArrayView<int32> CellRecords)
+		{
+			for (int32 RecordIndex : CellRecords)
+			{
+				if (!Seen[RecordIndex])
+				{
+					Seen[RecordIndex] = true;
+					AddIfStanding(RecordIndex);
+				}
+			}
+		});
+	}
+
+	const ArmaWallKernel::FRay Ray = ArmaWallKernel::MakeRay(Query.Origin, NormDir, Query.MaxDistance,
+		Query.IgnoreOwner ? 1 : 0, Time, Query.GraceTime, ParallelTolerance);
+
+	float Best = MAX_FLT;
+	int32 BestIndex = INDEX_NONE;
+	ArmaWallKernel::TestRange(Store, 0, Store.Num(), Ray, Best, BestIndex);
+
+	if (BestIndex != INDEX_NONE)
+	{
+		const FRecord& Record = Records[StoreToRecord[BestIndex]];
+		const FVector2D Start = Geometry[BestIndex].Key;
+		const FVector2D WallDir = (Geometry[BestIndex].Value - Start).GetSafeNormal();
+		const FVector2D Normal(-WallDir.Y, WallDir.X);
+
+		// Same convention as UArmaWallRegistry::ComputeWallSide
+		Hit.Distance = Best;
+		Hit.Side = FVector2D::DotProduct(Start - Query.Origin, Normal);
+		Hit.Wall = Record.Handle;
+		Hit.WallType = Record.WallType;
+		Hit.OwnerActor = Record.OwnerActor;
+	}
+	return Hit;
+}
@@ -0,0 +1,94 @@
+// ArmaWallHistory.h - Append-only record of how the wall set changed over time
+// Answers "which walls existed, and where did they end, at time t?" for lag
+// compensation and replay checks, within a bounded window of recent history
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/RingBuffer.h"
+#include "Core/ArmaSpatialHash.h"
+#include "ArmaWallRegistry.h"
+
+/**
+ * FArmaWallHistory - Per-wall lifetime plus a compact log of its moving endpoints
+ * Each wall gets one record: creation and removal time, and one (time, point) sample
+ * per frame in which its end (growing) or start (WALLS_LENGTH shrink) moved. The
+ * state at time t is the last sample at or before t.
+ *
+ * Memory is bounded by the window: samples older than it are folded into the one
+ * sample that still describes the wall at the window's start, and removed walls are
+ * dropped once their removal is older than the window.
+ *
+ * Records are bucketed in a spatial hash by the box of every position they took, so a
+ * query only rebuilds the walls near its ray. Recording is off until someone sets a window.
+ */
+class ARMAGETRONUE5_API FArmaWallHistory
+{
+public:
+	// Seconds of history kept; <= 0 stops recording and drops everything. The registry
+	// records the walls already up when recording starts again
+	void SetWindow(float Seconds);
+	float GetWindow() const { return Window; }
+	bool IsRecording() const { return Window > 0.0f; }
+
+	// Registry hooks, all at the registry's current world time
+	void RecordAdded(const FArmaRegisteredWall& Wall, float Time);
+	void RecordStart(FArmaWallHandle Handle, FVector2D Start, float Time);
+	void RecordEnd(FArmaWallHandle Handle, FVector2D End, float Time);
+	void RecordRemoved(FArmaWallHandle Handle, float Time);
+	void Reset();
+
+	// Drop what fell out of the window (once per tick)
+	void Trim(float Now);
+
+	// Closest wall hit as the walls stood at Time; same rules as UArmaWallRegistry::RaycastWalls.
+	// A Time before GetOldestTime is a miss, counted in stat arma (History Rays Out Of Window)
+	FArmaRayHit Raycast(const FArmaRayQuery& Query, float Time) const;
+
+	// Oldest time the history can still answer for
+	float GetOldestTime() const { return OldestTime; }
+
+	int32 NumRecords() const { return Records.Num(); }
+
+private:
+	friend class UArmaWallRegistry;
+
+	struct FSample
+	{
+		float Time;
+		FVector2f Point;
+	};
+
+	struct FRecord
+	{
+		FArmaWallHandle Handle;
+		EArmaWallType WallType = EArmaWallType::Cycle;
+		AActor* OwnerActor = nullptr;		// Compared only, never dereferenced
+		float CreationTime = 0.0f;
+		float RemovalTime = MAX_FLT;
+		TArray<FSample> StartLog;			// Never empty; first sample at CreationTime
+		TArray<FSample> EndLog;
+		FBox2D Bounds = FBox2D(ForceInit);	// Every point either log held; only grows
+	};
+
+	void AppendSample(int32 RecordIndex, TArray<FSample>& Log, float Time, FVector2D Point);
+	static void TrimLog(TArray<FSample>& Log, float Cutoff);
+	static FVector2D SampleAt(const TArray<FSample>& Log, float Time);
+
+	FRecord* FindLive(FArmaWallHandle Handle, int32* OutRecordIndex = nullptr);
+
+	TSparseArray<FRecord> Records;
+	TArray<int32> SlotToRecord;				// Registry slot -> record of its live wall
+	TRingBuffer<int32> RemovedOrder;		// Removed records, in removal (= time) order
+
+	// (record, time) for every sample appended; once the time leaves the window the
+	// record's logs are folded, so a wall that stopped moving keeps a single sample
+	TRingBuffer<TPair<int32, float>> FoldQueue;
+
+	// Record index -> cells its Bounds cover
+	FArmaSpatialHash Hash;
+
+	float Window = 0.0f;					// Off until lag compensation or replay asks for it
+	float OldestTime = 0.0f;
+	float ParallelTolerance = 5.0f;			// The registry's, set when it creates the history
+};
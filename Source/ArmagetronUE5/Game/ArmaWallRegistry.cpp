@@ -1,6 +1,10 @@
 // ArmaWallRegistry.cpp - Global wall registry implementation
 
 #include "ArmaWallRegistry.h"
+#include "ArmaWallSnapshot.h"
+#include "ArmaWallHistory.h"
+#include "ArmaCollisionSubsystem.h"
+#include "ArmagetronUE5.h"
 #include "Engine/World.h"
 #include "Engine/StaticMeshActor.h"
 #include "Components/StaticMeshComponent.h"
@@ -16,97 +20,426 @@ UArmaWallRegistry* UArmaWallRegistry::Get(UWorld* World)
 void UArmaWallRegistry::Initialize(FSubsystemCollectionBase& Collection)
 {
 	Super::Initialize(Collection);
+	History = MakeShared<FArmaWallHistory>();
+	History->ParallelTolerance = ParallelTolerance;
 	UE_LOG(LogTemp, Warning, TEXT("ArmaWallRegistry: Initialized"));
 }
 
 void UArmaWallRegistry::Deinitialize()
 {
 	ClearAllWalls();
+	Snapshot.Reset();
+	History.Reset();
 	Super::Deinitialize();
 }
 
-int32 UArmaWallRegistry::RegisterWall(FVector2D Start, FVector2D End, EArmaWallType WallType, AActor* Owner, AActor* VisualActor)
+FArmaWallHandle UArmaWallRegistry::RegisterWall(FVector2D Start, FVector2D End, EArmaWallType WallType, AActor* Owner, AActor* VisualActor)
 {
-	float CurrentTime = GetWorld() ? GetWorld()->GetTimeSeconds() : 0.0f;
-	int32 ID = NextWallID++;
+	float CurrentTime = UArmaCollisionSubsystem::GetSimTime(GetWorld());
+
+	// Reuse a free slot if we have one; its generation was bumped when it was freed
+	int32 Slot;
+	if (FreeSlots.Num() > 0)
+	{
+		Slot = FreeSlots.Pop(EAllowShrinking::No);
+	}
+	else
+	{
+		Slot = Slots.AddDefaulted();
+	}
+	const FArmaWallHandle Handle(Slot, Slots[Slot].Generation);
+	Slots[Slot].ExpireTime = -1.0f;
+	
+	// Owners get a small stable tag so the hot store can compare them in SIMD lanes
+	const int32 OwnerTag = AcquireOwnerTag(Owner);
 	
-	FArmaRegisteredWall NewWall(Start, End, WallType, Owner, VisualActor, CurrentTime, ID);
-	Walls.Add(NewWall);
+	FArmaRegisteredWall NewWall(Start, End, WallType, Owner, VisualActor, CurrentTime, Handle);
+	Slots[Slot].DenseIndex = Walls.Add(NewWall);
+	HotWalls.Add(Start, End, WallType == EArmaWallType::Rim, OwnerTag, CurrentTime);
+	if (History)
+	{
+		History->RecordAdded(NewWall, CurrentTime);
+	}
+
+	// Rim walls never change; cycle walls start out growing until FinalizeWall
+	IndexWall(NewWall, WallType == EArmaWallType::Rim ? EWallLayer::Static : EWallLayer::Growing);
+
+	if (Owner)
+	{
+		WallsByOwner.FindOrAdd(TObjectKey<AActor>(Owner)).Add(Handle);
+	}
 	
 	UE_LOG(LogTemp, Display, TEXT("Wall %d registered: (%.0f,%.0f)-(%.0f,%.0f) Type=%s Owner=%s"),
-		ID, Start.X, Start.Y, End.X, End.Y,
+		Slot, Start.X, Start.Y, End.X, End.Y,
 		WallType == EArmaWallType::Rim ? TEXT("RIM") : TEXT("CYCLE"),
 		Owner ? *Owner->GetName() : TEXT("None"));
 	
-	return ID;
+	return Handle;
 }
 
-void UArmaWallRegistry::UpdateWallEnd(int32 WallID, FVector2D NewEnd)
+int32 UArmaWallRegistry::ResolveHandle(FArmaWallHandle Handle) const
 {
-	for (FArmaRegisteredWall& Wall : Walls)
+	if (!Slots.IsValidIndex(Handle.Index) || Slots[Handle.Index].Generation != Handle.Generation)
+	{
+		return INDEX_NONE;
+	}
+	return Slots[Handle.Index].DenseIndex;
+}
+
+const FArmaRegisteredWall* UArmaWallRegistry::FindWall(FArmaWallHandle Handle) const
+{
+	const int32 Index = ResolveHandle(Handle);
+	return Index != INDEX_NONE ? &Walls[Index] : nullptr;
+}
+
+void UArmaWallRegistry::UpdateWallEnd(FArmaWallHandle Handle, FVector2D NewEnd)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ArmaUpdateWallEnd);
+	ARMA_TRACE_SCOPE("Arma.UpdateWallEnd");
+	INC_DWORD_STAT(STAT_ArmaWallEndUpdates);
+
+	const int32 Index = ResolveHandle(Handle);
+	if (Index == INDEX_NONE)
+	{
+		UE_LOG(LogTemp, Error, TEXT("UpdateWallEnd: Wall %d (gen %d) not found!"), Handle.Index, Handle.Generation);
+		return;
+	}
+
+	FArmaRegisteredWall& Wall = Walls[Index];
+
+	// Only log significant changes (> 10 units) to avoid spam
+	float Delta = (NewEnd - Wall.End).Size();
+	if (Delta > 100.0f)
+	{
+		UE_LOG(LogTemp, Display, TEXT("Wall %d updated: (%.0f,%.0f)-(%.0f,%.0f) len=%.1f"),
+			Handle.Index, Wall.Start.X, Wall.Start.Y, NewEnd.X, NewEnd.Y,
+			(NewEnd - Wall.Start).Size());
+	}
+	Wall.End = NewEnd;
+	HotWalls.SetEnd(Index, NewEnd);
+	if (History)
+	{
+		History->RecordEnd(Handle, NewEnd, UArmaCollisionSubsystem::GetSimTime(GetWorld()));
+	}
+
+	// Growing and static walls are scanned directly - only a finalized wall has index entries to move
+	if (Slots[Handle.Index].Layer == EWallLayer::Finalized)
+	{
+		IndexFinalizedWall(Wall);
+	}
+	else if (Slots[Handle.Index].Layer == EWallLayer::Static)
+	{
+		LayoutEpoch++;
+		IndexedVersion++;
+	}
+}
+
+void UArmaWallRegistry::UpdateWallStart(FArmaWallHandle Handle, FVector2D NewStart)
+{
+	const int32 Index = ResolveHandle(Handle);
+	if (Index == INDEX_NONE)
+	{
+		UE_LOG(LogTemp, Error, TEXT("UpdateWallStart: Wall %d (gen %d) not found!"), Handle.Index, Handle.Generation);
+		return;
+	}
+
+	FArmaRegisteredWall& Wall = Walls[Index];
+	Wall.Start = NewStart;
+	HotWalls.SetStart(Index, NewStart);
+	if (History)
+	{
+		History->RecordStart(Handle, NewStart, UArmaCollisionSubsystem::GetSimTime(GetWorld()));
+	}
+
+	if (Slots[Handle.Index].Layer == EWallLayer::Finalized)
 	{
-		if (Wall.WallID == WallID)
+		IndexFinalizedWall(Wall);
+	}
+	else if (Slots[Handle.Index].Layer == EWallLayer::Static)
+	{
+		LayoutEpoch++;
+		IndexedVersion++;
+	}
+}
+
+void UArmaWallRegistry::FinalizeWall(FArmaWallHandle Handle, FVector2D FinalEnd)
+{
+	const int32 Index = ResolveHandle(Handle);
+	if (Index == INDEX_NONE)
+	{
+		UE_LOG(LogTemp, Error, TEXT("FinalizeWall: Wall %d (gen %d) not found!"), Handle.Index, Handle.Generation);
+		return;
+	}
+
+	FArmaRegisteredWall& Wall = Walls[Index];
+	Wall.End = FinalEnd;
+	HotWalls.SetEnd(Index, FinalEnd);
+	if (History)
+	{
+		History->RecordEnd(Handle, FinalEnd, UArmaCollisionSubsystem::GetSimTime(GetWorld()));
+	}
+
+	if (Slots[Handle.Index].Layer == EWallLayer::Growing)
+	{
+		UnindexWall(Handle.Index);
+		IndexWall(Wall, EWallLayer::Finalized);
+	}
+	else if (Slots[Handle.Index].Layer == EWallLayer::Finalized)
+	{
+		IndexFinalizedWall(Wall);
+	}
+}
+
+FArmaWallHandle UArmaWallRegistry::SplitWall(FArmaWallHandle Handle, FVector2D HoleStart, FVector2D HoleEnd, AActor* FarVisualActor)
+{
+	const int32 Index = ResolveHandle(Handle);
+	if (Index == INDEX_NONE)
+	{
+		UE_LOG(LogTemp, Error, TEXT("SplitWall: Wall %d (gen %d) not found!"), Handle.Index, Handle.Generation);
+		return FArmaWallHandle();
+	}
+
+	const FArmaRegisteredWall Original = Walls[Index];
+	const float ExpireTime = Slots[Handle.Index].ExpireTime;
+	FinalizeWall(Handle, HoleStart);
+
+	// The far piece keeps the original's creation time, so grace times see no new wall
+	const FArmaWallHandle Far = RegisterWall(HoleEnd, Original.End, Original.WallType, Original.OwnerActor, FarVisualActor);
+	const int32 FarIndex = Slots[Far.Index].DenseIndex;
+	Walls[FarIndex].CreationTime = Original.CreationTime;
+	HotWalls.CreationTime[FarIndex] = Original.CreationTime;
+	FinalizeWall(Far, Original.End);
+	SetWallExpiry(Far, ExpireTime);
+	return Far;
+}
+
+void UArmaWallRegistry::RemoveWallsByOwner(AActor* Owner)
+{
+	TArray<FArmaWallHandle> OwnedWalls;
+	if (!WallsByOwner.RemoveAndCopyValue(TObjectKey<AActor>(Owner), OwnedWalls))
+	{
+		return;
+	}
+
+	for (const FArmaWallHandle& Handle : OwnedWalls)
+	{
+		const int32 Index = ResolveHandle(Handle);
+		if (Index != INDEX_NONE)
 		{
-			// Only log significant changes (> 10 units) to avoid spam
-			float Delta = (NewEnd - Wall.End).Size();
-			if (Delta > 100.0f)
-			{
-				UE_LOG(LogTemp, Display, TEXT("Wall %d updated: (%.0f,%.0f)-(%.0f,%.0f) len=%.1f"),
-					WallID, Wall.Start.X, Wall.Start.Y, NewEnd.X, NewEnd.Y,
-					(NewEnd - Wall.Start).Size());
-			}
-			Wall.End = NewEnd;
-			return;
+			RemoveWallAt(Index, true);
 		}
 	}
-	UE_LOG(LogTemp, Error, TEXT("UpdateWallEnd: Wall ID %d not found!"), WallID);
+	ReleaseOwnerTag(Owner);
 }
 
-void UArmaWallRegistry::RemoveWallsByOwner(AActor* Owner)
+void UArmaWallRegistry::SetWallExpiry(FArmaWallHandle Handle, float ExpireTime)
+{
+	if (ResolveHandle(Handle) == INDEX_NONE)
+	{
+		return;
+	}
+
+	// Rescheduling just files another entry; whichever fires first checks the slot's current time
+	Slots[Handle.Index].ExpireTime = ExpireTime;
+	if (ExpireTime >= 0.0f)
+	{
+		ExpiryWheel.Schedule(ExpireTime, Handle);
+	}
+}
+
+void UArmaWallRegistry::ExpireWallsByOwner(AActor* Owner, float Delay)
+{
+	const TArray<FArmaWallHandle>* OwnedWalls = WallsByOwner.Find(TObjectKey<AActor>(Owner));
+	if (!OwnedWalls)
+	{
+		return;
+	}
+
+	const float CurrentTime = UArmaCollisionSubsystem::GetSimTime(GetWorld());
+	const float ExpireTime = Delay >= 0.0f ? CurrentTime + Delay : -1.0f;
+	for (const FArmaWallHandle& Handle : *OwnedWalls)
+	{
+		SetWallExpiry(Handle, ExpireTime);
+	}
+}
+
+int32 UArmaWallRegistry::RemoveExpiredWalls()
 {
-	for (int32 i = Walls.Num() - 1; i >= 0; i--)
+	const float CurrentTime = UArmaCollisionSubsystem::GetSimTime(GetWorld());
+
+	// Collect first - removal mustn't run inside the wheel's callback
+	TArray<FArmaWallHandle, TInlineAllocator<16>> Expired;
+	ExpiryWheel.Advance(CurrentTime, [&](const FArmaWallHandle& Handle)
 	{
-		if (Walls[i].OwnerActor == Owner)
+		if (ResolveHandle(Handle) != INDEX_NONE)
 		{
-			if (Walls[i].VisualActor)
+			const float ExpireTime = Slots[Handle.Index].ExpireTime;
+			if (ExpireTime >= 0.0f && ExpireTime <= CurrentTime)
 			{
-				Walls[i].VisualActor->Destroy();
+				Expired.Add(Handle);
 			}
-			Walls.RemoveAt(i);
 		}
+	});
+
+	for (const FArmaWallHandle& Handle : Expired)
+	{
+		RemoveWall(Handle);
 	}
+	return Expired.Num();
 }
 
-void UArmaWallRegistry::RemoveWall(int32 WallID)
+void UArmaWallRegistry::RemoveWall(FArmaWallHandle Handle)
 {
-	for (int32 i = 0; i < Walls.Num(); i++)
+	const int32 Index = ResolveHandle(Handle);
+	if (Index == INDEX_NONE)
+	{
+		return;
+	}
+
+	if (AActor* Owner = Walls[Index].OwnerActor)
 	{
-		if (Walls[i].WallID == WallID)
+		TArray<FArmaWallHandle>* OwnedWalls = WallsByOwner.Find(TObjectKey<AActor>(Owner));
+		if (OwnedWalls)
 		{
-			if (Walls[i].VisualActor)
+			OwnedWalls->RemoveSingleSwap(Handle, EAllowShrinking::No);
+			if (OwnedWalls->IsEmpty())
 			{
-				Walls[i].VisualActor->Destroy();
+				WallsByOwner.Remove(TObjectKey<AActor>(Owner));
+				ReleaseOwnerTag(Owner);
 			}
-			Walls.RemoveAt(i);
-			return;
 		}
 	}
+	RemoveWallAt(Index, true);
+}
+
+void UArmaWallRegistry::RemoveWallAt(int32 DenseIndex, bool bDestroyVisual)
+{
+	const FArmaWallHandle Handle = Walls[DenseIndex].Handle;
+
+	if (bDestroyVisual && Walls[DenseIndex].VisualActor)
+	{
+		Walls[DenseIndex].VisualActor->Destroy();
+	}
+	UnindexWall(Handle.Index);
+	if (History)
+	{
+		History->RecordRemoved(Handle, UArmaCollisionSubsystem::GetSimTime(GetWorld()));
+	}
+
+	// Free the slot - the generation bump invalidates outstanding handles
+	FWallSlot& Slot = Slots[Handle.Index];
+	Slot.DenseIndex = INDEX_NONE;
+	Slot.Generation++;
+	FreeSlots.Add(Handle.Index);
+
+	// Swap-remove and patch the slot of the wall that moved into the hole
+	Walls.RemoveAtSwap(DenseIndex, 1, EAllowShrinking::No);
+	HotWalls.RemoveAtSwap(DenseIndex);
+	if (Walls.IsValidIndex(DenseIndex))
+	{
+		Slots[Walls[DenseIndex].Handle.Index].DenseIndex = DenseIndex;
+	}
 }
 
 void UArmaWallRegistry::ClearAllWalls()
 {
+	const float CurrentTime = UArmaCollisionSubsystem::GetSimTime(GetWorld());
 	for (FArmaRegisteredWall& Wall : Walls)
 	{
+		if (History)
+		{
+			History->RecordRemoved(Wall.Handle, CurrentTime);
+		}
+
 		if (Wall.VisualActor)
 		{
 			Wall.VisualActor->Destroy();
 		}
+
+		// Keep the slots but retire their generations so old handles stay invalid
+		FWallSlot& Slot = Slots[Wall.Handle.Index];
+		Slot.DenseIndex = INDEX_NONE;
+		Slot.Generation++;
+		FreeSlots.Add(Wall.Handle.Index);
 	}
 	Walls.Empty();
-	NextWallID = 1;
+	HotWalls.Reset();
+	WallsByOwner.Empty();
+	OwnerTags.Empty();
+	FreeOwnerTags.Empty();
+	NextOwnerTag = 1;
+	OwnerTagsVersion++;
+	StaticWallSlots.Empty();
+	GrowingWallSlots.Empty();
+	ExpiryWheel.Reset();
+	LayoutEpoch++;
+	IndexedVersion++;
+	WallHash.Reset();
+	AxisIndex.Reset();
+	GenericWallSlots.Empty();
 	UE_LOG(LogTemp, Warning, TEXT("ArmaWallRegistry: All walls cleared"));
 }
 
+void UArmaWallRegistry::IndexWall(const FArmaRegisteredWall& Wall, EWallLayer Layer)
+{
+	const int32 Slot = Wall.Handle.Index;
+	Slots[Slot].Layer = Layer;
+
+	switch (Layer)
+	{
+	case EWallLayer::Static:
+		StaticWallSlots.Add(Slot);
+		LayoutEpoch++;
+		IndexedVersion++;
+		break;
+	case EWallLayer::Growing:
+		GrowingWallSlots.Add(Slot);
+		break;
+	case EWallLayer::Finalized:
+		IndexFinalizedWall(Wall);
+		break;
+	}
+}
+
+void UArmaWallRegistry::UnindexWall(int32 Slot)
+{
+	switch (Slots[Slot].Layer)
+	{
+	case EWallLayer::Static:
+		StaticWallSlots.RemoveSingleSwap(Slot, EAllowShrinking::No);
+		LayoutEpoch++;
+		IndexedVersion++;
+		break;
+	case EWallLayer::Growing:
+		GrowingWallSlots.RemoveSingleSwap(Slot, EAllowShrinking::No);
+		break;
+	case EWallLayer::Finalized:
+		WallHash.Remove(Slot);
+		AxisIndex.Remove(Slot);
+		GenericWallSlots.Remove(Slot);
+		IndexedVersion++;
+		break;
+	}
+}
+
+void UArmaWallRegistry::IndexFinalizedWall(const FArmaRegisteredWall& Wall)
+{
+	const int32 Slot = Wall.Handle.Index;
+	WallHash.Update(Slot, Wall.Start, Wall.End);
+	IndexedVersion++;
+
+	// Cycle walls are always horizontal or vertical (WindingNumber 4); anything else
+	// that is long enough to be hit goes to the generic list
+	if (AxisIndex.Update(Slot, Wall.Start, Wall.End) || (Wall.End - Wall.Start).SizeSquared() < 1.0)
+	{
+		GenericWallSlots.Remove(Slot);
+	}
+	else
+	{
+		GenericWallSlots.Add(Slot);
+	}
+}
+
 void UArmaWallRegistry::SpawnArenaRim(float HalfWidth, float HalfHeight, float WallHeight)
 {
 	UWorld* World = GetWorld();
@@ -189,139 +522,590 @@ void UArmaWallRegistry::SpawnArenaRim(float HalfWidth, float HalfHeight, float W
 float UArmaWallRegistry::RaycastWalls(FVector2D Origin, FVector2D Direction, float MaxDistance,
 	AActor* IgnoreOwner, float GraceTime, FArmaRegisteredWall& OutHitWall, float& OutSide) const
 {
-	float ClosestDist = MAX_FLT;
-	float CurrentTime = GetWorld() ? GetWorld()->GetTimeSeconds() : 0.0f;
+	SCOPE_CYCLE_COUNTER(STAT_ArmaRaycastWalls);
+	ARMA_TRACE_SCOPE("Arma.RaycastWalls");
+	INC_DWORD_STAT(STAT_ArmaRaysCast);
+
+	float CurrentTime = UArmaCollisionSubsystem::GetSimTime(GetWorld());
 	
 	// Normalize direction
 	FVector2D NormDir = Direction.GetSafeNormal();
+	if (NormDir.IsZero())
+	{
+		return MAX_FLT;
+	}
 	
-	static int DebugCounter = 0;
-	bool bLogThisFrame = (DebugCounter++ % 120 == 0);  // Log every 120 calls
+	const ArmaWallKernel::FRay Ray = ArmaWallKernel::MakeRay(Origin, NormDir, MaxDistance,
+		GetOwnerTag(IgnoreOwner), CurrentTime, GraceTime, ParallelTolerance);
+
+	// Growing walls first: the index traversal below can then stop as early as possible
+	float Best = MAX_FLT;
+	int32 BestIndex = INDEX_NONE;
+	CastGrowingLayer(Ray, Best, BestIndex);
+	CastIndexedLayers(Ray, Origin, NormDir, MaxDistance, Best, BestIndex);
 
-	if (bLogThisFrame)
+	if (BestIndex == INDEX_NONE)
 	{
-		UE_LOG(LogTemp, Display, TEXT("RAYCAST: Origin=(%.1f,%.1f) Dir=(%.3f,%.3f) MaxDist=%.1f NumWalls=%d"),
-			Origin.X, Origin.Y, NormDir.X, NormDir.Y, MaxDistance, Walls.Num());
+		return MAX_FLT;
 	}
 
-	for (const FArmaRegisteredWall& Wall : Walls)
+	// Resolve the winner against the cold table
+	OutHitWall = Walls[BestIndex];
+	OutSide = ComputeWallSide(OutHitWall, Origin);
+	INC_DWORD_STAT(STAT_ArmaRayHits);
+
+	return Best;
+}
+
+void UArmaWallRegistry::CastGrowingLayer(const ArmaWallKernel::FRay& Ray, float& InOutBest, int32& InOutBestIndex) const
+{
+	ArmaWallKernel::FCandidateBatch Batch(HotWalls, Ray);
+	Batch.Best = InOutBest;
+	Batch.BestIndex = InOutBestIndex;
+	for (int32 Slot : GrowingWallSlots)
 	{
-		// Skip walls owned by the querying actor that are too new
-		if (Wall.OwnerActor == IgnoreOwner && (CurrentTime - Wall.CreationTime) < GraceTime)
+		Batch.Add(Slots[Slot].DenseIndex);
+	}
+	Batch.Flush();
+	InOutBest = Batch.Best;
+	InOutBestIndex = Batch.BestIndex;
+}
+
+void UArmaWallRegistry::CastIndexedLayers(const ArmaWallKernel::FRay& Ray, FVector2D Origin, FVector2D NormDir, float MaxDistance,
+	float& InOutBest, int32& InOutBestIndex) const
+{
+	ArmaWallQuery::CastIndexedWalls(HotWalls, WallHash, AxisIndex, GenericWallSlots, StaticWallSlots,
+		[this](int32 Slot) { return Slots[Slot].DenseIndex; },
+		Ray, Origin, NormDir, MaxDistance, ParallelTolerance, InOutBest, InOutBestIndex);
+}
+
+void UArmaWallRegistry::PublishSnapshot()
+{
+	// Every finalize, removal and WALLS_LENGTH trim changes the indexed layer, so a published
+	// generation copies it most ticks - only worth it while someone reads them
+	if (SnapshotReaders == 0)
+	{
+		Snapshot.Reset();
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_ArmaPublishSnapshot);
+	ARMA_TRACE_SCOPE("Arma.PublishSnapshot");
+
+	TSharedRef<FArmaWallSnapshot, ESPMode::ThreadSafe> Next = MakeShared<FArmaWallSnapshot, ESPMode::ThreadSafe>();
+	Next->Generation = ++SnapshotGeneration;
+	Next->Time = UArmaCollisionSubsystem::GetSimTime(GetWorld());
+	Next->ParallelTolerance = ParallelTolerance;
+
+	// Owner tags rarely change - share the previous copy until an owner comes or goes
+	if (Snapshot && SnapshotOwnerTagsVersion == OwnerTagsVersion)
+	{
+		Next->OwnerTags = Snapshot->OwnerTags;
+	}
+	else
+	{
+		Next->OwnerTags = MakeShared<TMap<TObjectKey<AActor>, int32>, ESPMode::ThreadSafe>(OwnerTags);
+		SnapshotOwnerTagsVersion = OwnerTagsVersion;
+	}
+
+	// Static/finalized layer: shared with the previous generation unless a wall was finalized or removed
+	if (Snapshot && SnapshotIndexedVersion == IndexedVersion)
+	{
+		Next->Indexed = Snapshot->Indexed;
+	}
+	else
+	{
+		TSharedRef<FArmaWallSnapshot::FIndexedLayer, ESPMode::ThreadSafe> Layer = MakeShared<FArmaWallSnapshot::FIndexedLayer, ESPMode::ThreadSafe>();
+		Layer->Hash = WallHash;
+		Layer->AxisIndex = AxisIndex;
+		Layer->GenericSlots = GenericWallSlots.Array();
+		Layer->StaticSlots = StaticWallSlots;
+		Layer->SlotToLocal.Init(INDEX_NONE, Slots.Num());
+		for (const FArmaRegisteredWall& Wall : Walls)
 		{
-			continue;
+			if (Slots[Wall.Handle.Index].Layer != EWallLayer::Growing)
+			{
+				Layer->SlotToLocal[Wall.Handle.Index] = Layer->Add(Wall, GetOwnerTag(Wall.OwnerActor));
+			}
 		}
+		Next->Indexed = Layer;
+		SnapshotIndexedVersion = IndexedVersion;
+	}
 
-		FVector2D SegVec = Wall.End - Wall.Start;
-		float SegLength = SegVec.Size();
-		
-		// Skip zero-length or very short walls (less than 1 unit)
-		if (SegLength < 1.0f)
+	// Growing layer: a few walls, copied every generation
+	for (int32 Slot : GrowingWallSlots)
+	{
+		const FArmaRegisteredWall& Wall = Walls[Slots[Slot].DenseIndex];
+		Next->Growing.Add(Wall, GetOwnerTag(Wall.OwnerActor));
+	}
+
+	Snapshot = Next;
+}
+
+void UArmaWallRegistry::RaycastWallsBatch(TConstArrayView<FArmaRayQuery> Queries, TArrayView<FArmaRayHit> OutHits) const
+{
+	check(Queries.Num() == OutHits.Num());
+	if (Queries.Num() == 0)
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_ArmaRaycastWallsBatch);
+	ARMA_TRACE_SCOPE("Arma.RaycastWallsBatch");
+	INC_DWORD_STAT_BY(STAT_ArmaRaysCast, Queries.Num());
+
+	const float CurrentTime = UArmaCollisionSubsystem::GetSimTime(GetWorld());
+
+	// Rays longer than this skip the candidate gather and scan the whole store
+	const float MaxGatherDistance = 100000.0f;
+
+	TArray<ArmaWallKernel::FRay, TInlineAllocator<16>> Rays;
+	TArray<float, TInlineAllocator<16>> Best;
+	TArray<int32, TInlineAllocator<16>> BestIndex;
+	Rays.Reserve(Queries.Num());
+	Best.Init(MAX_FLT, Queries.Num());
+	BestIndex.Init(INDEX_NONE, Queries.Num());
+
+	bool bFullScan = false;
+	FBox2D Bounds(ForceInit);
+	for (const FArmaRayQuery& Query : Queries)
+	{
+		const FVector2D NormDir = Query.Direction.GetSafeNormal();
+		Rays.Add(ArmaWallKernel::MakeRay(Query.Origin, NormDir, NormDir.IsZero() ? 0.0f : Query.MaxDistance,
+			GetOwnerTag(Query.IgnoreOwner), CurrentTime, Query.GraceTime, ParallelTolerance));
+
+		bFullScan |= Query.MaxDistance > MaxGatherDistance;
+		if (!bFullScan)
 		{
-			continue;
+			Bounds += Query.Origin;
+			Bounds += Query.Origin + NormDir * Query.MaxDistance;
 		}
-		
-		// Wall segment direction and normal
-		FVector2D WallDir = SegVec / SegLength;
-		FVector2D WallNormal(-WallDir.Y, WallDir.X);  // Perpendicular
-		
-		// Check if we're on the "front" side of the wall (approaching it)
-		// This is crucial for Armagetron-style walls where you can only collide from one side
-		FVector2D ToWallStart = Wall.Start - Origin;
-		float SideCheck = FVector2D::DotProduct(ToWallStart, WallNormal);
-		
-		// Standard line-line intersection
-		// Ray: Origin + t * NormDir
-		// Segment: Wall.Start + u * (Wall.End - Wall.Start)
-		
-		float Cross = NormDir.X * SegVec.Y - NormDir.Y * SegVec.X;
-		
-		if (FMath::Abs(Cross) < 0.0001f) 
+	}
+
+	// Gather every wall near any of the rays once. Each query batch usually comes
+	// from one cycle, so the rays share an origin and the union stays small.
+	// Static and growing walls are not in the hash and always go in.
+	TArray<int32> Candidates;
+	if (!bFullScan)
+	{
+		for (int32 Slot : StaticWallSlots)
+		{
+			Candidates.Add(Slots[Slot].DenseIndex);
+		}
+		for (int32 Slot : GrowingWallSlots)
+		{
+			Candidates.Add(Slots[Slot].DenseIndex);
+		}
+
+		TBitArray<> Seen(false, Walls.Num());
+		WallHash.QueryBox(Bounds.ExpandBy(ParallelTolerance), [&](TConstArrayView<int32> CellWalls)
 		{
-			// Parallel lines - check if collinear and overlapping
-			// This handles the case where the ray travels along a wall
-			FVector2D ToStart = Wall.Start - Origin;
-			float PerpDist = FMath::Abs(ToStart.X * NormDir.Y - ToStart.Y * NormDir.X);
-			if (PerpDist < 5.0f)  // Very close to the wall line
+			for (int32 Slot : CellWalls)
 			{
-				// Check if start of wall is ahead of us
-				float DotToStart = FVector2D::DotProduct(ToStart, NormDir);
-				if (DotToStart > 0.001f && DotToStart < MaxDistance && DotToStart < ClosestDist)
+				const int32 Index = Slots[Slot].DenseIndex;
+				if (Index != INDEX_NONE && !Seen[Index])
 				{
-					if (bLogThisFrame)
-					{
-						UE_LOG(LogTemp, Warning, TEXT("  HIT PARALLEL Wall %d at dist=%.1f"), Wall.WallID, DotToStart);
-					}
-					ClosestDist = DotToStart;
-					OutHitWall = Wall;
-					// For parallel case, calculate side from perpendicular distance
-					// Reuse the WallDir and WallNormal calculated earlier
-					OutSide = FVector2D::DotProduct(ToStart, WallNormal);
+					Seen[Index] = true;
+					Candidates.Add(Index);
 				}
 			}
-			continue;
+		});
+
+		// A gather touching most walls costs more than streaming the whole store
+		bFullScan = Candidates.Num() * 2 >= Walls.Num();
+	}
+
+	if (bFullScan)
+	{
+		ArmaWallKernel::TestRangeMulti(HotWalls, 0, HotWalls.Num(), Rays, Best, BestIndex);
+	}
+	else
+	{
+		ArmaWallKernel::TestGatheredMulti(HotWalls, Candidates.GetData(), Candidates.Num(), Rays, Best, BestIndex);
+	}
+
+	for (int32 i = 0; i < Queries.Num(); i++)
+	{
+		FArmaRayHit& Hit = OutHits[i];
+		Hit = FArmaRayHit();
+		if (BestIndex[i] != INDEX_NONE)
+		{
+			const FArmaRegisteredWall& Wall = Walls[BestIndex[i]];
+			INC_DWORD_STAT(STAT_ArmaRayHits);
+			Hit.Distance = Best[i];
+			Hit.Side = ComputeWallSide(Wall, Queries[i].Origin);
+			Hit.Wall = Wall.Handle;
+			Hit.WallType = Wall.WallType;
+			Hit.OwnerActor = Wall.OwnerActor;
 		}
-		
-		// Solve for t and u
-		FVector2D ToStart = Wall.Start - Origin;
-		float t = (ToStart.X * SegVec.Y - ToStart.Y * SegVec.X) / Cross;
-		float u = (ToStart.X * NormDir.Y - ToStart.Y * NormDir.X) / Cross;
-		
-		// Valid intersection:
-		// t > 0: intersection is in front of us
-		// u in [0,1]: intersection is on the wall segment
-		if (t > 0.001f && u >= 0.0f && u <= 1.0f && t < MaxDistance)
+	}
+}
+
+bool UArmaWallRegistry::IsRayCacheValid(const FArmaRayCache& Cache, FVector2D Origin, FVector2D NormDir, float MaxDistance,
+	AActor* IgnoreOwner, float GraceTime, float CurrentTime) const
+{
+	if (!Cache.bValid || Cache.LayoutEpoch != LayoutEpoch || CurrentTime >= Cache.ValidUntil)
+	{
+		return false;
+	}
+	if (Cache.IgnoreOwner != TObjectKey<AActor>(IgnoreOwner) || Cache.GraceTime != GraceTime)
+	{
+		return false;
+	}
+
+	// Same line, moved forward along it, and the new ray still ends inside the corridor
+	if (!NormDir.Equals(Cache.Direction, 1.0e-5f))
+	{
+		return false;
+	}
+	const FVector2D Offset = Origin - Cache.Origin;
+	const float Advance = FVector2D::DotProduct(Offset, Cache.Direction);
+	const float Lateral = FMath::Abs(FVector2D::CrossProduct(Cache.Direction, Offset));
+	if (Advance < 0.0f || Lateral > 0.01f || Advance + MaxDistance > Cache.Reach)
+	{
+		return false;
+	}
+
+	// The cached wall is about to be passed - the next one behind it is unknown
+	if (Cache.HitDistance < MAX_FLT && Cache.HitDistance - Advance <= 0.001f)
+	{
+		return false;
+	}
+
+	for (const TPair<FIntPoint, uint32>& CellStamp : Cache.CellStamps)
+	{
+		if (WallHash.GetCellStamp(CellStamp.Key) != CellStamp.Value)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+FArmaRayHit UArmaWallRegistry::RaycastWallsCached(const FArmaRayQuery& Query, FArmaRayCache& Cache) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_ArmaRaycastWallsCached);
+	ARMA_TRACE_SCOPE("Arma.RaycastWallsCached");
+	INC_DWORD_STAT(STAT_ArmaRaysCast);
+
+	FArmaRayHit Hit;
+	const float CurrentTime = UArmaCollisionSubsystem::GetSimTime(GetWorld());
+
+	const FVector2D NormDir = Query.Direction.GetSafeNormal();
+	if (NormDir.IsZero() || Query.MaxDistance <= 0.0f)
+	{
+		return Hit;
+	}
+
+	const int32 OwnerTag = GetOwnerTag(Query.IgnoreOwner);
+	float Best = MAX_FLT;
+	int32 BestIndex = INDEX_NONE;
+
+	if (IsRayCacheValid(Cache, Query.Origin, NormDir, Query.MaxDistance, Query.IgnoreOwner, Query.GraceTime, CurrentTime))
+	{
+		Cache.NumHits++;
+		INC_DWORD_STAT(STAT_ArmaRayCacheHits);
+
+		const float Advance = FVector2D::DotProduct(Query.Origin - Cache.Origin, Cache.Direction);
+		const int32 CachedIndex = ResolveHandle(Cache.HitWall);
+		if (CachedIndex != INDEX_NONE && Cache.HitDistance - Advance < Query.MaxDistance)
 		{
-			if (bLogThisFrame)
+			Best = Cache.HitDistance - Advance;
+			BestIndex = CachedIndex;
+		}
+	}
+	else
+	{
+		Cache.NumMisses++;
+
+		// Refill: static/finalized layers over a longer corridor, without the growing layer
+		const float Reach = Query.MaxDistance + RayCacheLookahead;
+		const ArmaWallKernel::FRay CorridorRay = ArmaWallKernel::MakeRay(Query.Origin, NormDir, Reach,
+			OwnerTag, CurrentTime, Query.GraceTime, ParallelTolerance);
+		float CorridorBest = MAX_FLT;
+		int32 CorridorBestIndex = INDEX_NONE;
+		CastIndexedLayers(CorridorRay, Query.Origin, NormDir, Reach, CorridorBest, CorridorBestIndex);
+
+		Cache.bValid = true;
+		Cache.LayoutEpoch = LayoutEpoch;
+		Cache.Origin = Query.Origin;
+		Cache.Direction = NormDir;
+		Cache.Reach = Reach;
+		Cache.IgnoreOwner = TObjectKey<AActor>(Query.IgnoreOwner);
+		Cache.GraceTime = Query.GraceTime;
+		Cache.HitDistance = CorridorBest;
+		Cache.HitWall = CorridorBestIndex != INDEX_NONE ? Walls[CorridorBestIndex].Handle : FArmaWallHandle();
+		Cache.ValidUntil = MAX_FLT;
+		Cache.CellStamps.Reset();
+
+		// Remember the corridor's cells; own walls still inside the grace time turn solid later,
+		// which no stamp would catch, so the cache expires when the first of them does
+		const float GraceCutoff = CurrentTime - Query.GraceTime;
+		WallHash.WalkRayCells(Query.Origin, NormDir, Reach, [&](FIntPoint Cell, float)
+		{
+			Cache.CellStamps.Emplace(Cell, WallHash.GetCellStamp(Cell));
+			for (int32 Slot : WallHash.GetCellKeys(Cell))
 			{
-				UE_LOG(LogTemp, Warning, TEXT("  HIT Wall %d at dist=%.1f (type=%s, side=%.1f, len=%.1f)"), 
-					Wall.WallID, t, Wall.WallType == EArmaWallType::Rim ? TEXT("RIM") : TEXT("CYCLE"), SideCheck, SegLength);
+				const FArmaRegisteredWall& Wall = Walls[Slots[Slot].DenseIndex];
+				if (Wall.OwnerActor == Query.IgnoreOwner && Wall.OwnerActor && Wall.CreationTime > GraceCutoff)
+				{
+					Cache.ValidUntil = FMath::Min(Cache.ValidUntil, Wall.CreationTime + Query.GraceTime);
+				}
 			}
-			
-			if (t < ClosestDist)
+			return false;
+		});
+
+		if (CorridorBest < Query.MaxDistance)
+		{
+			Best = CorridorBest;
+			BestIndex = CorridorBestIndex;
+		}
+	}
+
+	// The growing layer changes every frame and is always scanned
+	const ArmaWallKernel::FRay Ray = ArmaWallKernel::MakeRay(Query.Origin, NormDir, Query.MaxDistance,
+		OwnerTag, CurrentTime, Query.GraceTime, ParallelTolerance);
+	CastGrowingLayer(Ray, Best, BestIndex);
+
+	if (BestIndex != INDEX_NONE)
+	{
+		const FArmaRegisteredWall& Wall = Walls[BestIndex];
+		INC_DWORD_STAT(STAT_ArmaRayHits);
+		Hit.Distance = Best;
+		Hit.Side = ComputeWallSide(Wall, Query.Origin);
+		Hit.Wall = Wall.Handle;
+		Hit.WallType = Wall.WallType;
+		Hit.OwnerActor = Wall.OwnerActor;
+	}
+	return Hit;
+}
+
+float UArmaWallRegistry::ComputeWallSide(const FArmaRegisteredWall& Wall, FVector2D Point)
+{
+	// Which side of the wall line Point is on (positive = left of Start->End)
+	// This is crucial for Armagetron-style walls where you can only collide from one side
+	const FVector2D WallDir = (Wall.End - Wall.Start).GetSafeNormal();
+	const FVector2D WallNormal(-WallDir.Y, WallDir.X);
+	return FVector2D::DotProduct(Wall.Start - Point, WallNormal);
+}
+
+int32 UArmaWallRegistry::GetOwnerTag(AActor* Owner) const
+{
+	if (!Owner)
+	{
+		return 0;
+	}
+	const int32* Tag = OwnerTags.Find(TObjectKey<AActor>(Owner));
+	return Tag ? *Tag : INDEX_NONE;
+}
+
+int32 UArmaWallRegistry::AcquireOwnerTag(AActor* Owner)
+{
+	if (!Owner)
+	{
+		return 0;
+	}
+	if (const int32* Tag = OwnerTags.Find(TObjectKey<AActor>(Owner)))
+	{
+		return *Tag;
+	}
+
+	const int32 Tag = FreeOwnerTags.Num() > 0 ? FreeOwnerTags.Pop(EAllowShrinking::No) : NextOwnerTag++;
+	OwnerTags.Add(TObjectKey<AActor>(Owner), Tag);
+	OwnerTagsVersion++;
+	return Tag;
+}
+
+void UArmaWallRegistry::ReleaseOwnerTag(AActor* Owner)
+{
+	// Only once the owner has no walls left, so no live wall still carries the tag
+	int32 Tag;
+	if (Owner && OwnerTags.RemoveAndCopyValue(TObjectKey<AActor>(Owner), Tag))
+	{
+		FreeOwnerTags.Add(Tag);
+		OwnerTagsVersion++;
+	}
+}
+
+template<typename VisitorType>
+void UArmaWallRegistry::ForEachCycleWallNear(FVector2D Position, float Radius, AActor* IgnoreOwner, float GraceTime, VisitorType&& Visitor) const
+{
+	if (Walls.Num() == 0 || Radius <= 0.0f)
+	{
+		return;
+	}
+
+	const float CurrentTime = UArmaCollisionSubsystem::GetSimTime(GetWorld());
+	const FBox2D Box(Position - FVector2D(Radius, Radius), Position + FVector2D(Radius, Radius));
+
+	auto VisitCycleWall = [&](int32 Index)
+	{
+		const FArmaRegisteredWall& Wall = Walls[Index];
+		if (Wall.WallType != EArmaWallType::Cycle)
+		{
+			return;
+		}
+		if (Wall.OwnerActor == IgnoreOwner && (CurrentTime - Wall.CreationTime) < GraceTime)
+		{
+			return;
+		}
+		Visitor(Wall);
+	};
+
+	// Growing layer: one wall per cycle, cheaper to visit than to bound-check
+	for (int32 Slot : GrowingWallSlots)
+	{
+		VisitCycleWall(Slots[Slot].DenseIndex);
+	}
+
+	// Finalized layer: walls spanning several cells show up once per cell
+	// (the static layer only holds rim walls, which never count here)
+	TBitArray<> Seen(false, Walls.Num());
+	WallHash.QueryBox(Box, [&](TConstArrayView<int32> CellWalls)
+	{
+		for (int32 Slot : CellWalls)
+		{
+			const int32 Index = Slots[Slot].DenseIndex;
+			if (Index == INDEX_NONE || Seen[Index])
 			{
-				ClosestDist = t;
-				OutHitWall = Wall;
-				OutSide = SideCheck;  // Store which side of the wall we're on
+				continue;
 			}
+			Seen[Index] = true;
+			VisitCycleWall(Index);
 		}
+	});
+}
+
+FArmaRayHit UArmaWallRegistry::RaycastWallsAtTime(FVector2D Origin, FVector2D Direction, float MaxDistance, float Time,
+	AActor* IgnoreOwner, float GraceTime) const
+{
+	// Nothing is in the window while history is off (SetHistoryWindow)
+	if (!History || !History->IsRecording())
+	{
+		INC_DWORD_STAT(STAT_ArmaHistoryRaysOutOfWindow);
+		return FArmaRayHit();
+	}
+	return History->Raycast(FArmaRayQuery(Origin, Direction, MaxDistance, IgnoreOwner, GraceTime), Time);
+}
+
+void UArmaWallRegistry::SetHistoryWindow(float Seconds)
+{
+	if (!History)
+	{
+		return;
 	}
 
-	if (bLogThisFrame && ClosestDist < MAX_FLT)
+	const bool bWasRecording = History->IsRecording();
+	History->SetWindow(Seconds);
+
+	// Turned on: the walls already up are recorded as they stand now, and nothing
+	// before now can be answered
+	if (!bWasRecording && History->IsRecording())
 	{
-		UE_LOG(LogTemp, Display, TEXT("RAYCAST RESULT: ClosestDist=%.1f"), ClosestDist);
+		const float CurrentTime = UArmaCollisionSubsystem::GetSimTime(GetWorld());
+		History->Reset();
+		History->OldestTime = CurrentTime;
+		for (const FArmaRegisteredWall& Wall : Walls)
+		{
+			History->RecordAdded(Wall, Wall.CreationTime);
+		}
 	}
+}
 
-	return ClosestDist;
+void UArmaWallRegistry::TrimHistory()
+{
+	if (History)
+	{
+		History->Trim(UArmaCollisionSubsystem::GetSimTime(GetWorld()));
+	}
 }
 
 float UArmaWallRegistry::GetDistanceToNearestCycleWall(FVector2D Position, FVector2D Direction, float MaxDistance, AActor* IgnoreOwner) const
 {
 	float ClosestDist = MaxDistance;
-	float CurrentTime = GetWorld() ? GetWorld()->GetTimeSeconds() : 0.0f;
-
-	// Cast rays to left and right (for wall acceleration)
-	FVector2D LeftDir(-Direction.Y, Direction.X);
-	FVector2D RightDir(Direction.Y, -Direction.X);
 
-	for (const FArmaRegisteredWall& Wall : Walls)
+	// Only cycle walls provide acceleration (not rim walls); skip own walls that are too new
+	ForEachCycleWallNear(Position, MaxDistance, IgnoreOwner, 0.5f, [&](const FArmaRegisteredWall& Wall)
 	{
-		// Only cycle walls provide acceleration (not rim walls)
-		if (Wall.WallType != EArmaWallType::Cycle) continue;
-		
-		// Skip own walls that are too new
-		if (Wall.OwnerActor == IgnoreOwner && (CurrentTime - Wall.CreationTime) < 0.5f) continue;
-
 		float Dist = DistanceToSegment(Position, Wall.Start, Wall.End);
 		if (Dist < ClosestDist)
 		{
 			ClosestDist = Dist;
 		}
-	}
+	});
 
 	return ClosestDist;
 }
 
+void UArmaWallRegistry::ProcessCycleWallsInRange(FVector2D Center, float Radius, TFunctionRef<void(FArmaWallHandle Wall, float BeginDist, float EndDist)> Processor) const
+{
+	struct FWallInRange
+	{
+		FArmaWallHandle Handle;
+		float BeginDist;
+		float EndDist;
+	};
+	TArray<FWallInRange, TInlineAllocator<16>> Found;
+
+	ForEachCycleWallNear(Center, Radius, nullptr, 0.0f, [&](const FArmaRegisteredWall& Wall)
+	{
+		double T0, T1;
+		if (ArmaWallKernel::ClipSegmentToCircle(Wall.Start, Wall.End, Center, Radius, T0, T1))
+		{
+			const double Length = (Wall.End - Wall.Start).Size();
+			Found.Add({ Wall.Handle, (float)(T0 * Length), (float)(T1 * Length) });
+		}
+	});
+
+	for (const FWallInRange& Entry : Found)
+	{
+		Processor(Entry.Handle, Entry.BeginDist, Entry.EndDist);
+	}
+}
+
+FArmaSideWalls UArmaWallRegistry::FindNearestSideWalls(FVector2D Position, FVector2D Direction, float MaxDistance, AActor* IgnoreOwner, float GraceTime) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_ArmaFindNearestSideWalls);
+	ARMA_TRACE_SCOPE("Arma.FindNearestSideWalls");
+	INC_DWORD_STAT(STAT_ArmaSideWallQueries);
+
+	FArmaSideWalls Result;
+
+	const FVector2D Forward = Direction.GetSafeNormal();
+	if (Forward.IsZero() || MaxDistance <= 0.0f)
+	{
+		return Result;
+	}
+	const FVector2D Left(-Forward.Y, Forward.X);
+	const float Slope = FMath::Sqrt(1.0f - ArmaWallKernel::SideConeCos * ArmaWallKernel::SideConeCos) / ArmaWallKernel::SideConeCos;
+
+	ForEachCycleWallNear(Position, MaxDistance, IgnoreOwner, GraceTime, [&](const FArmaRegisteredWall& Wall)
+	{
+		// Wall endpoints in the cycle's frame: X forward, Y to the left
+		const FVector2D RelStart = Wall.Start - Position;
+		const FVector2D RelEnd = Wall.End - Position;
+		const FVector2D A(FVector2D::DotProduct(RelStart, Forward), FVector2D::DotProduct(RelStart, Left));
+		const FVector2D B(FVector2D::DotProduct(RelEnd, Forward), FVector2D::DotProduct(RelEnd, Left));
+
+		const float LeftDist = ArmaWallKernel::DistanceInSideCone(A, B, Slope);
+		if (LeftDist < MaxDistance && LeftDist < Result.LeftDistance)
+		{
+			Result.LeftDistance = LeftDist;
+			Result.LeftWall = Wall.Handle;
+		}
+
+		// Mirror across the travel line for the right side
+		const float RightDist = ArmaWallKernel::DistanceInSideCone(FVector2D(A.X, -A.Y), FVector2D(B.X, -B.Y), Slope);
+		if (RightDist < MaxDistance && RightDist < Result.RightDistance)
+		{
+			Result.RightDistance = RightDist;
+			Result.RightWall = Wall.Handle;
+		}
+	});
+
+	return Result;
+}
+
 float UArmaWallRegistry::DistanceToSegment(FVector2D Point, FVector2D SegStart, FVector2D SegEnd) const
 {
 	FVector2D Segment = SegEnd - SegStart;
@@ -4,8 +4,16 @@
 
 #include "CoreMinimal.h"
 #include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "Core/ArmaSpatialHash.h"
+#include "Core/ArmaAxisWallIndex.h"
+#include "Core/ArmaWallKernel.h"
+#include "Core/ArmaTimingWheel.h"
 #include "ArmaWallRegistry.generated.h"
 
+class FArmaWallSnapshot;
+class FArmaWallHistory;
+
 /**
  * Wall type - Rim walls behave differently from cycle walls
  */
@@ -16,6 +24,37 @@ enum class EArmaWallType : uint8
 	Cycle,		// Player/AI trail - provides acceleration when nearby
 };
 
+/**
+ * Generational handle to a registered wall
+ * Index is the registry slot, Generation changes every time the slot is reused,
+ * so a handle to a removed wall never resolves to the wall that replaced it.
+ */
+USTRUCT(BlueprintType)
+struct FArmaWallHandle
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly)
+	int32 Index = INDEX_NONE;
+
+	UPROPERTY(BlueprintReadOnly)
+	int32 Generation = 0;
+
+	FArmaWallHandle() {}
+	FArmaWallHandle(int32 InIndex, int32 InGeneration) : Index(InIndex), Generation(InGeneration) {}
+
+	bool IsValid() const { return Index != INDEX_NONE; }
+	void Reset() { Index = INDEX_NONE; Generation = 0; }
+
+	bool operator==(const FArmaWallHandle& Other) const { return Index == Other.Index && Generation == Other.Generation; }
+	bool operator!=(const FArmaWallHandle& Other) const { return !(*this == Other); }
+
+	friend uint32 GetTypeHash(const FArmaWallHandle& Handle)
+	{
+		return HashCombine(::GetTypeHash(Handle.Index), ::GetTypeHash(Handle.Generation));
+	}
+};
+
 /**
  * A single wall segment for 2D collision in the global registry
  */
@@ -43,11 +82,121 @@ struct FArmaRegisteredWall
 	float CreationTime = 0.0f;
 
 	UPROPERTY(BlueprintReadOnly)
-	int32 WallID = 0;
+	FArmaWallHandle Handle;
 
 	FArmaRegisteredWall() {}
-	FArmaRegisteredWall(FVector2D InStart, FVector2D InEnd, EArmaWallType InType, AActor* InOwner, AActor* InVisual, float InTime, int32 InID)
-		: Start(InStart), End(InEnd), WallType(InType), OwnerActor(InOwner), VisualActor(InVisual), CreationTime(InTime), WallID(InID) {}
+	FArmaRegisteredWall(FVector2D InStart, FVector2D InEnd, EArmaWallType InType, AActor* InOwner, AActor* InVisual, float InTime, FArmaWallHandle InHandle)
+		: Start(InStart), End(InEnd), WallType(InType), OwnerActor(InOwner), VisualActor(InVisual), CreationTime(InTime), Handle(InHandle) {}
+};
+
+/**
+ * One ray of a batched wall query
+ */
+USTRUCT(BlueprintType)
+struct FArmaRayQuery
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadWrite)
+	FVector2D Origin = FVector2D::ZeroVector;
+
+	UPROPERTY(BlueprintReadWrite)
+	FVector2D Direction = FVector2D(1.0, 0.0);
+
+	UPROPERTY(BlueprintReadWrite)
+	float MaxDistance = 0.0f;
+
+	UPROPERTY(BlueprintReadWrite)
+	AActor* IgnoreOwner = nullptr;  // Own walls younger than GraceTime are skipped
+
+	UPROPERTY(BlueprintReadWrite)
+	float GraceTime = 0.0f;
+
+	FArmaRayQuery() {}
+	FArmaRayQuery(FVector2D InOrigin, FVector2D InDirection, float InMaxDistance, AActor* InIgnoreOwner, float InGraceTime)
+		: Origin(InOrigin), Direction(InDirection), MaxDistance(InMaxDistance), IgnoreOwner(InIgnoreOwner), GraceTime(InGraceTime) {}
+};
+
+/**
+ * Result of one ray of a batched wall query
+ */
+USTRUCT(BlueprintType)
+struct FArmaRayHit
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly)
+	float Distance = MAX_FLT;  // MAX_FLT if nothing was hit
+
+	UPROPERTY(BlueprintReadOnly)
+	float Side = 0.0f;  // Same as RaycastWalls' OutSide
+
+	UPROPERTY(BlueprintReadOnly)
+	FArmaWallHandle Wall;
+
+	UPROPERTY(BlueprintReadOnly)
+	EArmaWallType WallType = EArmaWallType::Cycle;
+
+	UPROPERTY(BlueprintReadOnly)
+	AActor* OwnerActor = nullptr;
+
+	bool IsHit() const { return Distance < MAX_FLT; }
+};
+
+/**
+ * Nearest cycle walls beside a moving cycle (wall acceleration)
+ */
+USTRUCT(BlueprintType)
+struct FArmaSideWalls
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly)
+	float LeftDistance = MAX_FLT;  // MAX_FLT if no wall within range
+
+	UPROPERTY(BlueprintReadOnly)
+	float RightDistance = MAX_FLT;
+
+	UPROPERTY(BlueprintReadOnly)
+	FArmaWallHandle LeftWall;
+
+	UPROPERTY(BlueprintReadOnly)
+	FArmaWallHandle RightWall;
+
+	bool HasLeft() const { return LeftWall.IsValid(); }
+	bool HasRight() const { return RightWall.IsValid(); }
+};
+
+/**
+ * Per-cycle memory of its last forward query (temporal coherence)
+ * Between frames a cycle slides a few units along the same line, so the closest
+ * static/finalized wall ahead rarely changes. The cache keeps that answer for a
+ * corridor somewhat longer than the query, plus the change stamps of the hash cells
+ * the corridor crosses; while those stamps hold, the next query is answered from the
+ * cache and only the growing layer (one wall per cycle) is scanned.
+ */
+struct FArmaRayCache
+{
+	bool bValid = false;
+	uint32 LayoutEpoch = 0;				// Registry epoch (static layer / clear) at fill time
+
+	FVector2D Origin = FVector2D::ZeroVector;
+	FVector2D Direction = FVector2D::ZeroVector;
+	float Reach = 0.0f;					// Corridor length from Origin
+	TObjectKey<AActor> IgnoreOwner;
+	float GraceTime = 0.0f;
+	float ValidUntil = MAX_FLT;			// When a grace-skipped own wall in the corridor becomes solid
+
+	float HitDistance = MAX_FLT;		// Closest static/finalized hit from Origin, MAX_FLT if none within Reach
+	FArmaWallHandle HitWall;
+
+	TArray<TPair<FIntPoint, uint32>, TInlineAllocator<16>> CellStamps;
+
+	// Hit rate, for the debug overlay / logs
+	int32 NumHits = 0;
+	int32 NumMisses = 0;
+
+	void Invalidate() { bValid = false; }
 };
 
 /**
@@ -63,21 +212,51 @@ public:
 	// Get the singleton for this world
 	static UArmaWallRegistry* Get(UWorld* World);
 
-	// Register a new wall segment, returns wall ID
+	// Register a new wall segment, returns its handle
 	UFUNCTION(BlueprintCallable, Category = "Walls")
-	int32 RegisterWall(FVector2D Start, FVector2D End, EArmaWallType WallType, AActor* Owner, AActor* VisualActor);
+	FArmaWallHandle RegisterWall(FVector2D Start, FVector2D End, EArmaWallType WallType, AActor* Owner, AActor* VisualActor);
 
 	// Update a wall's end position (for growing walls)
 	UFUNCTION(BlueprintCallable, Category = "Walls")
-	void UpdateWallEnd(int32 WallID, FVector2D NewEnd);
+	void UpdateWallEnd(FArmaWallHandle Handle, FVector2D NewEnd);
+
+	// Move a wall's start along it (WALLS_LENGTH tail shrinking)
+	UFUNCTION(BlueprintCallable, Category = "Walls")
+	void UpdateWallStart(FArmaWallHandle Handle, FVector2D NewStart);
+
+	// Set a growing wall's final end and move it into the indexed layer (after a turn or death)
+	UFUNCTION(BlueprintCallable, Category = "Walls")
+	void FinalizeWall(FArmaWallHandle Handle, FVector2D FinalEnd);
+
+	// Cut the stretch between HoleStart and HoleEnd out of a finalized wall (explosions): it
+	// now ends at HoleStart, and the rest becomes a new wall with the same owner, age and expiry
+	FArmaWallHandle SplitWall(FArmaWallHandle Handle, FVector2D HoleStart, FVector2D HoleEnd, AActor* FarVisualActor);
 
 	// Remove all walls owned by an actor
 	UFUNCTION(BlueprintCallable, Category = "Walls")
 	void RemoveWallsByOwner(AActor* Owner);
 
+	// Remove a wall once the world clock reaches ExpireTime; negative cancels a pending expiry
+	UFUNCTION(BlueprintCallable, Category = "Walls")
+	void SetWallExpiry(FArmaWallHandle Handle, float ExpireTime);
+
+	// Let all walls of an actor expire Delay seconds from now (sg_wallsStayUpDelay after death)
+	UFUNCTION(BlueprintCallable, Category = "Walls")
+	void ExpireWallsByOwner(AActor* Owner, float Delay);
+
+	// Remove the walls whose expiry time has come (once per tick); returns how many went
+	int32 RemoveExpiredWalls();
+
 	// Remove a specific wall
 	UFUNCTION(BlueprintCallable, Category = "Walls")
-	void RemoveWall(int32 WallID);
+	void RemoveWall(FArmaWallHandle Handle);
+
+	// Does the handle still refer to a live wall?
+	UFUNCTION(BlueprintCallable, Category = "Walls")
+	bool IsValidWall(FArmaWallHandle Handle) const { return ResolveHandle(Handle) != INDEX_NONE; }
+
+	// Resolve a handle, nullptr if the wall was removed
+	const FArmaRegisteredWall* FindWall(FArmaWallHandle Handle) const;
 
 	// Clear all walls
 	UFUNCTION(BlueprintCallable, Category = "Walls")
@@ -91,6 +270,12 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Walls")
 	int32 GetWallCount() const { return Walls.Num(); }
 
+	// Changes whenever the static layer changes or everything is cleared
+	uint32 GetLayoutEpoch() const { return LayoutEpoch; }
+
+	// Rays running within this distance of a parallel wall hit its start
+	static float GetParallelTolerance() { return ParallelTolerance; }
+
 	// Spawn arena rim walls (rectangular boundary)
 	UFUNCTION(BlueprintCallable, Category = "Walls")
 	void SpawnArenaRim(float HalfWidth, float HalfHeight, float WallHeight = 150.0f);
@@ -102,19 +287,182 @@ public:
 	float RaycastWalls(FVector2D Origin, FVector2D Direction, float MaxDistance, 
 		AActor* IgnoreOwner, float GraceTime, FArmaRegisteredWall& OutHitWall, float& OutSide) const;
 
+	/**
+	 * Cast many rays in one pass: walls are the outer loop and rays the inner loop,
+	 * so each candidate wall is loaded once for the whole batch.
+	 * OutHits must have the same length as Queries.
+	 */
+	void RaycastWallsBatch(TConstArrayView<FArmaRayQuery> Queries, TArrayView<FArmaRayHit> OutHits) const;
+
+	// Same result as a single RaycastWalls, answered from Cache when nothing in its corridor changed
+	FArmaRayHit RaycastWallsCached(const FArmaRayQuery& Query, FArmaRayCache& Cache) const;
+
+	// Publish the current wall set as an immutable snapshot (game thread, once per tick).
+	// Does nothing while no reader is registered
+	void PublishSnapshot();
+
+	// Latest published snapshot - take it on the game thread and hand it to worker tasks,
+	// which can then query it without locks while the registry moves on.
+	// Null unless a reader was registered when the tick's walls were published.
+	TSharedPtr<const FArmaWallSnapshot, ESPMode::ThreadSafe> GetSnapshot() const { return Snapshot; }
+
+	// A system that reads snapshots registers for as long as it does; only then are they built
+	void AddSnapshotReader() { SnapshotReaders++; }
+	void RemoveSnapshotReader() { SnapshotReaders = FMath::Max(SnapshotReaders - 1, 0); }
+
+	// Same rules as RaycastWalls, against the walls as they stood at Time (lag compensation,
+	// replay checks). Time must lie inside the history window, otherwise it's a miss counted
+	// in stat arma; history is off until SetHistoryWindow turns it on.
+	FArmaRayHit RaycastWallsAtTime(FVector2D Origin, FVector2D Direction, float MaxDistance, float Time,
+		AActor* IgnoreOwner = nullptr, float GraceTime = 0.0f) const;
+
+	// Seconds of wall history kept for RaycastWallsAtTime; <= 0 turns recording off
+	UFUNCTION(BlueprintCallable, Category = "Walls")
+	void SetHistoryWindow(float Seconds);
+
+	// Drop history that fell out of the window (once per tick)
+	void TrimHistory();
+
 	// Get distance to nearest wall (for acceleration)
 	UFUNCTION(BlueprintCallable, Category = "Walls")
 	float GetDistanceToNearestCycleWall(FVector2D Position, FVector2D Direction, float MaxDistance, AActor* IgnoreOwner) const;
 
+	/**
+	 * Nearest cycle wall on each side of a cycle within MaxDistance (sg_nearCycle)
+	 * Only walls near Position are visited. A wall counts for a side by the part of it
+	 * inside that side's cone (within ~72 degrees of the perpendicular), so a wall
+	 * running past the cycle is measured at its closest point on that side.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Walls")
+	FArmaSideWalls FindNearestSideWalls(FVector2D Position, FVector2D Direction, float MaxDistance, AActor* IgnoreOwner, float GraceTime) const;
+
+	/**
+	 * Every cycle wall passing within Radius of Center, once, with the stretch of it inside
+	 * the circle as distances from its start (explosions). Finalized walls are gathered from
+	 * the wall hash. Walls are reported after the gather, so Processor may change them.
+	 */
+	void ProcessCycleWallsInRange(FVector2D Center, float Radius, TFunctionRef<void(FArmaWallHandle Wall, float BeginDist, float EndDist)> Processor) const;
+
 protected:
 	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
 	virtual void Deinitialize() override;
 
 private:
+	// Dense wall storage (cold side: actors, handles, full precision); removal swaps the last wall into the hole
 	UPROPERTY()
 	TArray<FArmaRegisteredWall> Walls;
 
-	int32 NextWallID = 1;
+	// SoA float copy of Walls for the ray kernel, same dense indices
+	FArmaWallHotStore HotWalls;
+
+	// Small stable per-owner tags packed into the hot store (0 = no owner). An owner keeps
+	// its tag while it has walls; the tag is recycled once its last wall is gone
+	TMap<TObjectKey<AActor>, int32> OwnerTags;
+	TArray<int32> FreeOwnerTags;
+	int32 NextOwnerTag = 1;
+	uint32 OwnerTagsVersion = 0;
+	int32 GetOwnerTag(AActor* Owner) const;
+	int32 AcquireOwnerTag(AActor* Owner);
+	void ReleaseOwnerTag(AActor* Owner);
+
+	/**
+	 * Walls live in one of three layers, by how often they change:
+	 *   Static    - rim walls, never change; a handful of arena-long walls scanned directly
+	 *   Finalized - trail walls behind a turn, only ever removed; spatially indexed
+	 *   Growing   - the current wall of each cycle, moves every frame; scanned directly
+	 * Queries merge all three, so per-frame index work is O(cycles) instead of O(walls).
+	 */
+	enum class EWallLayer : uint8
+	{
+		Static,
+		Finalized,
+		Growing,
+	};
+
+	// Handle slot -> dense index. Slots are recycled through FreeSlots with a bumped generation.
+	struct FWallSlot
+	{
+		int32 DenseIndex = INDEX_NONE;
+		int32 Generation = 1;
+		EWallLayer Layer = EWallLayer::Finalized;
+		float ExpireTime = -1.0f;		// World time the wall is removed at, < 0 = never
+	};
+	TArray<FWallSlot> Slots;
+	TArray<int32> FreeSlots;
+
+	// Pending expiries keyed by time. Entries are never cancelled: a popped handle only
+	// counts if it is still live and its slot's ExpireTime has actually been reached.
+	TArmaTimingWheel<FArmaWallHandle> ExpiryWheel;
+
+	// Live walls per owner, so clearing a dead cycle's trail doesn't scan every wall
+	TMap<TObjectKey<AActor>, TArray<FArmaWallHandle>> WallsByOwner;
+
+	// Dense index of a live handle, INDEX_NONE if stale
+	int32 ResolveHandle(FArmaWallHandle Handle) const;
+
+	// Remove the wall at DenseIndex from every index and swap-remove it from Walls
+	void RemoveWallAt(int32 DenseIndex, bool bDestroyVisual);
+
+	// Rays running within this distance of a parallel wall hit its start
+	static constexpr float ParallelTolerance = 5.0f;
+
+	// Static layer: slots of rim walls, baked once by SpawnArenaRim
+	TArray<int32> StaticWallSlots;
+
+	// Growing layer: slots of the walls still being extended (one per live cycle)
+	TArray<int32> GrowingWallSlots;
+
+	// Finalized layer: spatial index over finalized walls, keyed by handle slot
+	FArmaSpatialHash WallHash{500.0f, ParallelTolerance};
+
+	// Finalized horizontal/vertical walls sorted by their constant coordinate (axis-aligned rays)
+	FArmaAxisWallIndex AxisIndex;
+
+	// Finalized walls long enough to hit but neither horizontal nor vertical - scanned by axis-aligned rays
+	TSet<int32> GenericWallSlots;
+
+	// Bumped whenever the static layer changes or everything is cleared (invalidates every FArmaRayCache)
+	uint32 LayoutEpoch = 1;
+
+	// Bumped whenever the static or finalized layer changes (a snapshot must recopy it)
+	uint32 IndexedVersion = 1;
+
+	// Append-only log of wall lifetimes and endpoint moves within the history window
+	TSharedPtr<FArmaWallHistory> History;
+
+	// Published snapshot and what its shared parts were built from
+	TSharedPtr<const FArmaWallSnapshot, ESPMode::ThreadSafe> Snapshot;
+	uint64 SnapshotGeneration = 0;
+	uint32 SnapshotIndexedVersion = 0;
+	uint32 SnapshotOwnerTagsVersion = 0;
+	int32 SnapshotReaders = 0;
+
+	// Extra corridor length a ray cache is filled with beyond the query itself
+	static constexpr float RayCacheLookahead = 1000.0f;
+
+	// Put a wall into a layer / take it out of whichever layer holds it
+	void IndexWall(const FArmaRegisteredWall& Wall, EWallLayer Layer);
+	void UnindexWall(int32 Slot);
+
+	// Keep WallHash/AxisIndex/GenericWallSlots in sync with a finalized wall's geometry
+	void IndexFinalizedWall(const FArmaRegisteredWall& Wall);
+
+	// Ray against the growing layer only / the static and finalized layers only, keeping the closest hit
+	void CastGrowingLayer(const ArmaWallKernel::FRay& Ray, float& InOutBest, int32& InOutBestIndex) const;
+	void CastIndexedLayers(const ArmaWallKernel::FRay& Ray, FVector2D Origin, FVector2D NormDir, float MaxDistance,
+		float& InOutBest, int32& InOutBestIndex) const;
+
+	// Can Cache answer this ray (same line, inside the corridor, no cell changed)?
+	bool IsRayCacheValid(const FArmaRayCache& Cache, FVector2D Origin, FVector2D NormDir, float MaxDistance,
+		AActor* IgnoreOwner, float GraceTime, float CurrentTime) const;
+
+	// Helper: signed distance of Point from the wall line (the OutSide of RaycastWalls)
+	static float ComputeWallSide(const FArmaRegisteredWall& Wall, FVector2D Point);
+
+	// Visit each live cycle wall whose bounds come within Radius of Position (plus every
+	// growing wall), once, skipping IgnoreOwner's walls younger than GraceTime
+	template<typename VisitorType>
+	void ForEachCycleWallNear(FVector2D Position, float Radius, AActor* IgnoreOwner, float GraceTime, VisitorType&& Visitor) const;
 
 	// Helper: point-to-segment distance
 	float DistanceToSegment(FVector2D Point, FVector2D SegStart, FVector2D SegEnd) const;
@@ -0,0 +1,88 @@
+// ArmaWallSnapshot.cpp - Immutable wall registry snapshot implementation
+
+#include "ArmaWallSnapshot.h"
+#include "ArmagetronUE5.h"
+
+int32 FArmaWallSnapshot::FLayer::Add(const FArmaRegisteredWall& Wall, int32 OwnerTag)
+{
+	FArmaSnapshotWall& Entry = Info.AddDefaulted_GetRef();
+	Entry.Start = Wall.Start;
+	Entry.End = Wall.End;
+	Entry.WallType = Wall.WallType;
+	Entry.OwnerActor = Wall.OwnerActor;
+	Entry.CreationTime = Wall.CreationTime;
+	Entry.Handle = Wall.Handle;
+	return Hot.Add(Wall.Start, Wall.End, Wall.WallType == EArmaWallType::Rim, OwnerTag, Wall.CreationTime);
+}
+
+int32 FArmaWallSnapshot::Num() const
+{
+	return (Indexed ? Indexed->Info.Num() : 0) + Growing.Info.Num();
+}
+
+int32 FArmaWallSnapshot::GetOwnerTag(AActor* Owner) const
+{
+	if (!Owner)
+	{
+		return 0;
+	}
+	const int32* Tag = OwnerTags ? OwnerTags->Find(TObjectKey<AActor>(Owner)) : nullptr;
+	return Tag ? *Tag : INDEX_NONE;
+}
+
+FArmaRayHit FArmaWallSnapshot::Raycast(const FArmaRayQuery& Query) const
+{
+	ARMA_TRACE_SCOPE("Arma.SnapshotRaycast");
+	INC_DWORD_STAT(STAT_ArmaRaysCast);
+
+	FArmaRayHit Hit;
+
+	const FVector2D NormDir = Query.Direction.GetSafeNormal();
+	if (NormDir.IsZero() || Query.MaxDistance <= 0.0f)
+	{
+		return Hit;
+	}
+
+	const ArmaWallKernel::FRay Ray = ArmaWallKernel::MakeRay(Query.Origin, NormDir, Query.MaxDistance,
+		GetOwnerTag(Query.IgnoreOwner), Time, Query.GraceTime, ParallelTolerance);
+
+	// Growing layer first, so the index traversal can stop early
+	float GrowingBest = MAX_FLT;
+	int32 GrowingBestIndex = INDEX_NONE;
+	ArmaWallKernel::TestRange(Growing.Hot, 0, Growing.Hot.Num(), Ray, GrowingBest, GrowingBestIndex);
+
+	float IndexedBest = GrowingBest;
+	int32 IndexedBestIndex = INDEX_NONE;
+	if (Indexed)
+	{
+		const TArray<int32>& SlotToLocal = Indexed->SlotToLocal;
+		ArmaWallQuery::CastIndexedWalls(Indexed->Hot, Indexed->Hash, Indexed->AxisIndex, Indexed->GenericSlots, Indexed->StaticSlots,
+			[&SlotToLocal](int32 Slot) { return SlotToLocal[Slot]; },
+			Ray, Query.Origin, NormDir, Query.MaxDistance, ParallelTolerance, IndexedBest, IndexedBestIndex);
+	}
+
+	const FArmaSnapshotWall* Wall = nullptr;
+	if (IndexedBestIndex != INDEX_NONE)
+	{
+		Hit.Distance = IndexedBest;
+		Wall = &Indexed->Info[IndexedBestIndex];
+	}
+	else if (GrowingBestIndex != INDEX_NONE)
+	{
+		Hit.Distance = GrowingBest;
+		Wall = &Growing.Info[GrowingBestIndex];
+	}
+
+	if (Wall)
+	{
+		INC_DWORD_STAT(STAT_ArmaRayHits);
+		// Same convention as UArmaWallRegistry::ComputeWallSide
+		const FVector2D WallDir = (Wall->End - Wall->Start).GetSafeNormal();
+		const FVector2D Normal(-WallDir.Y, WallDir.X);
+		Hit.Side = FVector2D::DotProduct(Wall->Start - Query.Origin, Normal);
+		Hit.Wall = Wall->Handle;
+		Hit.WallType = Wall->WallType;
+		Hit.OwnerActor = Wall->OwnerActor;
+	}
+	return Hit;
+}
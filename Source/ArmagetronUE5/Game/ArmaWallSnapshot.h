@@ -0,0 +1,146 @@
+// ArmaWallSnapshot.h - Immutable, shareable copies of the wall registry for worker threads
+// While a reader is registered the registry publishes one snapshot per tick; tasks hold a
+// shared pointer to it and read without locks while the game thread keeps mutating the live registry
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Core/ArmaSpatialHash.h"
+#include "Core/ArmaAxisWallIndex.h"
+#include "Core/ArmaWallKernel.h"
+#include "UObject/ObjectKey.h"
+#include "ArmaWallRegistry.h"
+
+/**
+ * What a snapshot keeps about a wall - no UObject pointers are dereferenced off the game thread
+ */
+struct FArmaSnapshotWall
+{
+	FVector2D Start = FVector2D::ZeroVector;
+	FVector2D End = FVector2D::ZeroVector;
+	EArmaWallType WallType = EArmaWallType::Cycle;
+	AActor* OwnerActor = nullptr;		// Compared only, never dereferenced by readers
+	float CreationTime = 0.0f;
+	FArmaWallHandle Handle;
+};
+
+/**
+ * FArmaWallSnapshot - One published generation of the wall set
+ * Structurally shared: the static/finalized layer (with its spatial index) only changes
+ * when a wall is finalized or removed, so consecutive generations point at the same
+ * immutable copy and only the growing layer (one wall per cycle) is copied every tick.
+ *
+ * Everything is const after UArmaWallRegistry::PublishSnapshot returns. Get the pointer
+ * on the game thread (UArmaWallRegistry::GetSnapshot) and hand it to the tasks.
+ */
+class ARMAGETRONUE5_API FArmaWallSnapshot
+{
+public:
+	uint64 GetGeneration() const { return Generation; }
+	float GetTime() const { return Time; }
+	int32 Num() const;
+
+	// Same rules as UArmaWallRegistry::RaycastWalls, evaluated at the snapshot's time
+	FArmaRayHit Raycast(const FArmaRayQuery& Query) const;
+
+private:
+	friend class UArmaWallRegistry;
+
+	struct FLayer
+	{
+		FArmaWallHotStore Hot;
+		TArray<FArmaSnapshotWall> Info;		// Same indices as Hot
+
+		int32 Add(const FArmaRegisteredWall& Wall, int32 OwnerTag);
+	};
+
+	// Static and finalized walls plus copies of the registry's indices over them
+	struct FIndexedLayer : FLayer
+	{
+		FArmaSpatialHash Hash;
+		FArmaAxisWallIndex AxisIndex;
+		TArray<int32> GenericSlots;
+		TArray<int32> StaticSlots;
+		TArray<int32> SlotToLocal;			// Registry slot -> index in this layer
+	};
+
+	TSharedPtr<const FIndexedLayer, ESPMode::ThreadSafe> Indexed;
+	TSharedPtr<const TMap<TObjectKey<AActor>, int32>, ESPMode::ThreadSafe> OwnerTags;
+	FLayer Growing;
+
+	uint64 Generation = 0;
+	float Time = 0.0f;
+	float ParallelTolerance = 5.0f;
+
+	int32 GetOwnerTag(AActor* Owner) const;
+};
+
+namespace ArmaWallQuery
+{
+	/**
+	 * Ray against static + finalized walls through their indices, keeping the closest hit
+	 * Shared by the live registry and its snapshots. SlotToIndex maps an index key
+	 * (registry slot) to a hot-store index.
+	 */
+	template<typename GenericRangeType, typename StaticRangeType, typename SlotToIndexType>
+	void CastIndexedWalls(const FArmaWallHotStore& Store, const FArmaSpatialHash& Hash, const FArmaAxisWallIndex& AxisIndex,
+		const GenericRangeType& GenericSlots, const StaticRangeType& StaticSlots, SlotToIndexType&& SlotToIndex,
+		const ArmaWallKernel::FRay& Ray, FVector2D Origin, FVector2D NormDir, float MaxDistance, float ParallelTolerance,
+		float& InOutBest, int32& InOutBestIndex)
+	{
+		ArmaWallKernel::FCandidateBatch Batch(Store, Ray);
+		Batch.Best = InOutBest;
+		Batch.BestIndex = InOutBestIndex;
+
+		// Static layer: a handful of arena-long walls, tested directly
+		for (int32 Slot : StaticSlots)
+		{
+			Batch.Add(SlotToIndex(Slot));
+		}
+		Batch.Flush();
+
+		if (FArmaAxisWallIndex::ClassifyRay(NormDir) != EArmaAxisAlignment::None)
+		{
+			// Axis-aligned ray (every cycle ray): the few non-axis walls are scanned directly,
+			// the rest come from two range lookups in the sorted interval index
+			for (int32 Slot : GenericSlots)
+			{
+				Batch.Add(SlotToIndex(Slot));
+			}
+
+			AxisIndex.TraverseRay(Origin, NormDir, MaxDistance, ParallelTolerance, [&](int32 Slot, float MinDistance)
+			{
+				if (MinDistance >= Batch.Best)
+				{
+					return true;  // Perpendicular walls come in distance order - nothing closer remains
+				}
+				Batch.Add(SlotToIndex(Slot));
+				return false;
+			});
+			Batch.Flush();
+		}
+		else
+		{
+			// Walk only the hash cells the ray crosses. A wall spanning several cells is
+			// tested once; we can stop as soon as the best hit lies inside the current cell.
+			TSet<int32, DefaultKeyFuncs<int32>, TInlineSetAllocator<64>> TestedWalls;
+			Hash.TraverseRay(Origin, NormDir, MaxDistance, [&](TConstArrayView<int32> CellWalls, float CellExitDistance)
+			{
+				for (int32 Slot : CellWalls)
+				{
+					bool bAlreadyTested = false;
+					TestedWalls.Add(Slot, &bAlreadyTested);
+					if (!bAlreadyTested)
+					{
+						Batch.Add(SlotToIndex(Slot));
+					}
+				}
+				Batch.Flush();
+				return Batch.Best <= CellExitDistance;
+			});
+		}
+
+		InOutBest = Batch.Best;
+		InOutBestIndex = Batch.BestIndex;
+	}
+}
@@ -0,0 +1,171 @@
+// ArmaSimBot.cpp - Cycle AI that plays through FArmaSimWorld
+
+#include "ArmaSimBot.h"
+#include "ArmaSimWorld.h"
+
+void FArmaSimBot::Reset(double Time)
+{
+	FrontSensor = LeftSensor = RightSensor = FArmaSimBotSensor();
+	Mode = EMode::Survive;
+	PendingTurn = 0;
+	NextThinkTime = Time + Params.ThinkInterval;
+}
+
+void FArmaSimBot::Update(FArmaSimWorld& World, int32 Cycle, FRandomStream& Random)
+{
+	if (!World.IsValidCycle(Cycle) || !World.GetCycle(Cycle).bAlive)
+	{
+		return;
+	}
+	const double Time = World.GetTime();
+
+	// AI thinking
+	if (Time >= NextThinkTime)
+	{
+		Think(World, Cycle, Random);
+		NextThinkTime = Time + Params.ThinkInterval;
+	}
+
+	// Execute pending turn after reaction delay
+	if (PendingTurn != 0 && Time >= TurnDecisionTime + Params.ReactionTime)
+	{
+		World.RequestTurn(Cycle, PendingTurn);
+		PendingTurn = 0;
+	}
+}
+
+void FArmaSimBot::Think(FArmaSimWorld& World, int32 Cycle, FRandomStream& Random)
+{
+	UpdateSensors(World, Cycle);
+
+	// State machine (simplified from Armagetron)
+	switch (Mode)
+	{
+	case EMode::Trace:
+		ThinkTrace(World, Cycle, Random);
+		break;
+
+	case EMode::Survive:
+	default:
+		ThinkSurvive(World, Cycle, Random);
+		break;
+	}
+}
+
+void FArmaSimBot::UpdateSensors(FArmaSimWorld& World, int32 Cycle)
+{
+	// Front, left and right, all walls (own, other players' and rim) in one batch
+	const FArmaSimCycle& C = World.GetCycle(Cycle);
+	const FVector2D Forward = C.Direction;
+	const FVector2D Left(-Forward.Y, Forward.X);
+
+	const FArmaSimRay Rays[3] = {
+		FArmaSimRay(C.Position, Forward, Params.SensorRange, Cycle, Params.OwnWallGrace),
+		FArmaSimRay(C.Position, Left, Params.SensorRange * 0.5f, Cycle, Params.OwnWallGrace),
+		FArmaSimRay(C.Position, -Left, Params.SensorRange * 0.5f, Cycle, Params.OwnWallGrace)
+	};
+	FArmaSimHit Hits[3];
+	World.GetWalls().CastRays(Rays, Hits);
+
+	FArmaSimBotSensor* Sensors[3] = { &FrontSensor, &LeftSensor, &RightSensor };
+	for (int32 i = 0; i < 3; i++)
+	{
+		FArmaSimBotSensor& Sensor = *Sensors[i];
+		Sensor = FArmaSimBotSensor();
+		if (Hits[i].IsHit())
+		{
+			Sensor.Distance = Hits[i].Distance;
+			Sensor.HitPoint = Rays[i].Origin + Rays[i].Direction * Hits[i].Distance;
+			Sensor.bHit = true;
+			Sensor.bOwnWall = Hits[i].Owner == Cycle;
+			Sensor.bRim = Hits[i].bRim;
+		}
+	}
+}
+
+void FArmaSimBot::ThinkSurvive(FArmaSimWorld& World, int32 Cycle, FRandomStream& Random)
+{
+	// Emergency check first - is there a wall very close ahead?
+	if (FrontSensor.bHit && FrontSensor.Distance < Params.EmergencyDistance)
+	{
+		EmergencySurvive(World, Cycle, Random);
+		return;
+	}
+
+	// Proactive avoidance - turn before we get too close (3 think intervals ahead)
+	const float TurnThreshold = World.GetCycle(Cycle).Speed * Params.ThinkInterval * 3.0f;
+	if (FrontSensor.bHit && FrontSensor.Distance < TurnThreshold)
+	{
+		// Wall ahead, pick the side with more room
+		PlanTurn(World.GetTime(), LeftSensor.Distance > RightSensor.Distance ? -1 : 1);
+	}
+}
+
+void FArmaSimBot::ThinkTrace(FArmaSimWorld& World, int32 Cycle, FRandomStream& Random)
+{
+	// Trace mode: follow along a wall on one side
+	// From Armagetron: used to grind walls for speed
+
+	// Emergency check
+	if (FrontSensor.bHit && FrontSensor.Distance < Params.EmergencyDistance)
+	{
+		EmergencySurvive(World, Cycle, Random, TraceSide);
+		return;
+	}
+
+	// Check if we're still near the wall we're tracing
+	const FArmaSimBotSensor& TracedSensor = TraceSide > 0 ? RightSensor : LeftSensor;
+	if (!TracedSensor.bHit || TracedSensor.Distance > Params.SensorRange * 0.5f)
+	{
+		// Lost the wall, switch to survive
+		Mode = EMode::Survive;
+		return;
+	}
+
+	// If wall ahead, turn in trace direction
+	if (FrontSensor.bHit && FrontSensor.Distance < World.GetCycle(Cycle).Speed * Params.ThinkInterval * 5.0f)
+	{
+		PlanTurn(World.GetTime(), TraceSide);
+	}
+}
+
+void FArmaSimBot::EmergencySurvive(FArmaSimWorld& World, int32 Cycle, FRandomStream& Random, int32 PreferredDirection)
+{
+	// Emergency! Pick the safest direction to turn
+	const float LeftSpace = LeftSensor.Distance;
+	const float RightSpace = RightSensor.Distance;
+	const float FrontSpace = FrontSensor.Distance;
+
+	int32 TurnDirection;
+	if (LeftSpace > RightSpace * 1.5f && LeftSpace > FrontSpace)
+	{
+		// One side is clearly better, go that way
+		TurnDirection = -1;
+	}
+	else if (RightSpace > LeftSpace * 1.5f && RightSpace > FrontSpace)
+	{
+		TurnDirection = 1;
+	}
+	else if (PreferredDirection != 0)
+	{
+		// Use the preferred direction if no clear winner
+		TurnDirection = PreferredDirection;
+	}
+	else
+	{
+		TurnDirection = Random.FRand() > 0.5f ? 1 : -1;
+	}
+
+	// Execute immediately in emergency (bypass reaction time)
+	World.RequestTurn(Cycle, TurnDirection);
+	PendingTurn = 0;
+}
+
+void FArmaSimBot::PlanTurn(double Time, int32 Direction)
+{
+	if (PendingTurn == 0)
+	{
+		PendingTurn = Direction;
+		TurnDecisionTime = Time;
+	}
+}
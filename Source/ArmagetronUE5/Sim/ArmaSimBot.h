@@ -0,0 +1,97 @@
+// ArmaSimBot.h - Cycle AI that plays through FArmaSimWorld
+// The decision making of AArmaAICycle (based on Armagetron's gAIPlayer), on simulation
+// state only, so the same bot drives AI pawns in a world and headless matches.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Math/RandomStream.h"
+
+class FArmaSimWorld;
+
+/**
+ * Tunables of one bot (the AArmaAICycle properties of the same names)
+ */
+struct FArmaSimBotParams
+{
+	float ThinkInterval = 0.1f;			// How often to make decisions (sg_delayCycle)
+	float SensorRange = 500.0f;			// How far to look ahead; the side sensors see half as far
+	float EmergencyDistance = 100.0f;	// Distance to trigger an emergency turn
+	float ReactionTime = 0.15f;			// Delay before a planned turn is made (AI_REACTION)
+	float OwnWallGrace = 0.3f;			// Own walls younger than this are invisible to the sensors
+
+	// Higher IQ thinks and reacts faster (100 = as given)
+	void ApplyIQ(int32 IQ)
+	{
+		const float IQFactor = FMath::Clamp(IQ / 100.0f, 0.1f, 2.0f);
+		ReactionTime /= IQFactor;
+		ThinkInterval /= IQFactor;
+	}
+};
+
+/**
+ * What one sensor ray saw (gAISensor)
+ */
+struct FArmaSimBotSensor
+{
+	float Distance = 9999.0f;
+	FVector2D HitPoint = FVector2D::ZeroVector;
+	bool bHit = false;
+	bool bOwnWall = false;
+	bool bRim = false;
+};
+
+/**
+ * FArmaSimBot - Survive/Trace state machine for one simulation cycle
+ * Every ThinkInterval it casts a front and two side sensors through the world's wall
+ * backend and plans a turn, which is requested ReactionTime later. Emergencies turn at
+ * once. Random choices come from the caller's stream, so a seeded run replays exactly.
+ */
+class ARMAGETRONUE5_API FArmaSimBot
+{
+public:
+	enum class EMode : uint8
+	{
+		Survive,	// Just try to stay alive
+		Trace,		// Follow a wall on TraceSide (grinding it for speed)
+	};
+
+	FArmaSimBotParams Params;
+
+	// Forget plans and sensors after a (re)spawn; the first think is one interval after Time
+	void Reset(double Time);
+
+	// Think when due and make the planned turn once the reaction time has passed
+	void Update(FArmaSimWorld& World, int32 Cycle, FRandomStream& Random);
+
+	// Follow the wall on Side (-1 left, 1 right) until it is lost
+	void StartTrace(int32 Side) { Mode = EMode::Trace; TraceSide = Side < 0 ? -1 : 1; }
+
+	EMode GetMode() const { return Mode; }
+	const FArmaSimBotSensor& GetFrontSensor() const { return FrontSensor; }
+	const FArmaSimBotSensor& GetLeftSensor() const { return LeftSensor; }
+	const FArmaSimBotSensor& GetRightSensor() const { return RightSensor; }
+
+private:
+	void Think(FArmaSimWorld& World, int32 Cycle, FRandomStream& Random);
+	void UpdateSensors(FArmaSimWorld& World, int32 Cycle);
+	void ThinkSurvive(FArmaSimWorld& World, int32 Cycle, FRandomStream& Random);
+	void ThinkTrace(FArmaSimWorld& World, int32 Cycle, FRandomStream& Random);
+
+	// Emergency survival - turn away from imminent collision right now
+	void EmergencySurvive(FArmaSimWorld& World, int32 Cycle, FRandomStream& Random, int32 PreferredDirection = 0);
+
+	// Plan a turn unless one is already planned
+	void PlanTurn(double Time, int32 Direction);
+
+	FArmaSimBotSensor FrontSensor;
+	FArmaSimBotSensor LeftSensor;
+	FArmaSimBotSensor RightSensor;
+
+	EMode Mode = EMode::Survive;
+	int32 TraceSide = 1;
+
+	double NextThinkTime = 0.0;
+	int32 PendingTurn = 0;				// -1 left, 1 right, 0 none
+	double TurnDecisionTime = 0.0;
+};
@@ -0,0 +1,287 @@
+// ArmaSimWalls.cpp - Standalone wall backend for the simulation core
+
+#include "ArmaSimWalls.h"
+
+void FArmaSimWallList::AddRim(float HalfWidth, float HalfHeight)
+{
+	const FVector2D Corners[4] = {
+		FVector2D(-HalfWidth, -HalfHeight),
+		FVector2D(HalfWidth, -HalfHeight),
+		FVector2D(HalfWidth, HalfHeight),
+		FVector2D(-HalfWidth, HalfHeight)
+	};
+	for (int32 i = 0; i < 4; i++)
+	{
+		AddDense(Corners[i], Corners[(i + 1) % 4], INDEX_NONE, true);
+	}
+	ForeignChangeStamp++;
+}
+
+void FArmaSimWallList::Reset()
+{
+	HotWalls.Reset();
+	Walls.Reset();
+	IdToDense.Reset();
+	FreeIds.Reset();
+	NextExpireTime = MAX_dbl;
+	ForeignChangeStamp++;
+}
+
+void FArmaSimWallList::SetTime(double InTime)
+{
+	Time = InTime;
+	if (Time >= NextExpireTime)
+	{
+		RemoveExpiredWalls();
+	}
+}
+
+int32 FArmaSimWallList::AddDense(FVector2D Start, FVector2D End, int32 Owner, bool bRim)
+{
+	int32 Id;
+	if (FreeIds.Num() > 0)
+	{
+		Id = FreeIds.Pop(EAllowShrinking::No);
+	}
+	else
+	{
+		Id = IdToDense.Add(INDEX_NONE);
+	}
+
+	FWall& Wall = Walls.AddDefaulted_GetRef();
+	Wall.Start = Start;
+	Wall.End = End;
+	Wall.Owner = Owner;
+	Wall.Id = Id;
+	Wall.CreationTime = (float)Time;
+	Wall.bRim = bRim;
+
+	// Owner tag 0 means no owner, so cycle N is tagged N + 1
+	const int32 DenseIndex = HotWalls.Add(Start, End, bRim, Owner + 1, Wall.CreationTime);
+	check(DenseIndex == Walls.Num() - 1);
+	IdToDense[Id] = DenseIndex;
+	return Id;
+}
+
+void FArmaSimWallList::RemoveAt(int32 DenseIndex)
+{
+	IdToDense[Walls[DenseIndex].Id] = INDEX_NONE;
+	FreeIds.Add(Walls[DenseIndex].Id);
+
+	HotWalls.RemoveAtSwap(DenseIndex);
+	Walls.RemoveAtSwap(DenseIndex, EAllowShrinking::No);
+	if (DenseIndex < Walls.Num())
+	{
+		IdToDense[Walls[DenseIndex].Id] = DenseIndex;
+	}
+}
+
+int32 FArmaSimWallList::AddWall(int32 Owner, FVector2D Start)
+{
+	return AddDense(Start, Start, Owner, false);
+}
+
+void FArmaSimWallList::UpdateWallEnd(int32 Wall, FVector2D End)
+{
+	const int32 DenseIndex = IdToDense.IsValidIndex(Wall) ? IdToDense[Wall] : INDEX_NONE;
+	if (DenseIndex != INDEX_NONE)
+	{
+		Walls[DenseIndex].End = End;
+		HotWalls.SetEnd(DenseIndex, End);
+	}
+}
+
+void FArmaSimWallList::UpdateWallStart(int32 Wall, FVector2D Start)
+{
+	const int32 DenseIndex = IdToDense.IsValidIndex(Wall) ? IdToDense[Wall] : INDEX_NONE;
+	if (DenseIndex != INDEX_NONE)
+	{
+		Walls[DenseIndex].Start = Start;
+		HotWalls.SetStart(DenseIndex, Start);
+	}
+}
+
+void FArmaSimWallList::FinalizeWall(int32 Wall, FVector2D End)
+{
+	// One flat list - finalizing is just the last end update
+	UpdateWallEnd(Wall, End);
+}
+
+int32 FArmaSimWallList::SplitWall(int32 Wall, FVector2D HoleStart, FVector2D HoleEnd)
+{
+	const int32 DenseIndex = IdToDense.IsValidIndex(Wall) ? IdToDense[Wall] : INDEX_NONE;
+	if (DenseIndex == INDEX_NONE)
+	{
+		return INDEX_NONE;
+	}
+
+	const FWall Original = Walls[DenseIndex];
+	UpdateWallEnd(Wall, HoleStart);
+
+	const int32 Far = AddDense(HoleEnd, Original.End, Original.Owner, false);
+	const int32 FarIndex = IdToDense[Far];
+	Walls[FarIndex].CreationTime = Original.CreationTime;
+	Walls[FarIndex].ExpireTime = Original.ExpireTime;
+	HotWalls.CreationTime[FarIndex] = Original.CreationTime;
+	return Far;
+}
+
+void FArmaSimWallList::RemoveWall(int32 Wall)
+{
+	const int32 DenseIndex = IdToDense.IsValidIndex(Wall) ? IdToDense[Wall] : INDEX_NONE;
+	if (DenseIndex != INDEX_NONE)
+	{
+		RemoveAt(DenseIndex);
+	}
+}
+
+void FArmaSimWallList::RemoveWallsByOwner(int32 Owner)
+{
+	for (int32 i = Walls.Num() - 1; i >= 0; i--)
+	{
+		if (!Walls[i].bRim && Walls[i].Owner == Owner)
+		{
+			RemoveAt(i);
+		}
+	}
+}
+
+void FArmaSimWallList::ExpireWallsByOwner(int32 Owner, float Delay)
+{
+	const double ExpireTime = Time + FMath::Max(Delay, 0.0f);
+	for (FWall& Wall : Walls)
+	{
+		if (!Wall.bRim && Wall.Owner == Owner)
+		{
+			Wall.ExpireTime = ExpireTime;
+		}
+	}
+	NextExpireTime = FMath::Min(NextExpireTime, ExpireTime);
+}
+
+void FArmaSimWallList::RemoveExpiredWalls()
+{
+	NextExpireTime = MAX_dbl;
+	for (int32 i = Walls.Num() - 1; i >= 0; i--)
+	{
+		if (Walls[i].ExpireTime < 0.0)
+		{
+			continue;
+		}
+		if (Walls[i].ExpireTime <= Time)
+		{
+			RemoveAt(i);
+			ForeignChangeStamp++;
+		}
+		else
+		{
+			NextExpireTime = FMath::Min(NextExpireTime, Walls[i].ExpireTime);
+		}
+	}
+}
+
+void FArmaSimWallList::CastRays(TConstArrayView<FArmaSimRay> Rays, TArrayView<FArmaSimHit> OutHits)
+{
+	check(Rays.Num() == OutHits.Num());
+
+	TArray<ArmaWallKernel::FRay, TInlineAllocator<16>> KernelRays;
+	TArray<float, TInlineAllocator<16>> Best;
+	TArray<int32, TInlineAllocator<16>> BestIndex;
+	for (const FArmaSimRay& Ray : Rays)
+	{
+		const int32 IgnoreTag = Ray.IgnoreOwner != INDEX_NONE ? Ray.IgnoreOwner + 1 : INDEX_NONE;
+		KernelRays.Add(ArmaWallKernel::MakeRay(Ray.Origin, Ray.Direction, Ray.MaxDistance, IgnoreTag, (float)Time, Ray.GraceTime, ParallelTolerance));
+		Best.Add(MAX_FLT);
+		BestIndex.Add(INDEX_NONE);
+	}
+
+	ArmaWallKernel::TestRangeMulti(HotWalls, 0, HotWalls.Num(), KernelRays, Best, BestIndex);
+
+	for (int32 i = 0; i < Rays.Num(); i++)
+	{
+		FArmaSimHit& Hit = OutHits[i];
+		Hit = FArmaSimHit();
+		if (BestIndex[i] == INDEX_NONE)
+		{
+			continue;
+		}
+
+		const FWall& Wall = Walls[BestIndex[i]];
+		const FVector2D WallDir = (Wall.End - Wall.Start).GetSafeNormal();
+		const FVector2D WallNormal(-WallDir.Y, WallDir.X);
+
+		Hit.Distance = Best[i];
+		Hit.Side = FVector2D::DotProduct(Wall.Start - Rays[i].Origin, WallNormal);
+		Hit.Wall = Wall.Id;
+		Hit.Owner = Wall.Owner;
+		Hit.bRim = Wall.bRim;
+	}
+}
+
+FArmaSimSideWalls FArmaSimWallList::FindNearestSideWalls(FVector2D Position, FVector2D Direction, float MaxDistance, int32 IgnoreOwner, float GraceTime)
+{
+	FArmaSimSideWalls Result;
+
+	const FVector2D Forward = Direction.GetSafeNormal();
+	if (Forward.IsZero() || MaxDistance <= 0.0f)
+	{
+		return Result;
+	}
+	const FVector2D Left(-Forward.Y, Forward.X);
+	const float Slope = FMath::Sqrt(1.0f - ArmaWallKernel::SideConeCos * ArmaWallKernel::SideConeCos) / ArmaWallKernel::SideConeCos;
+	const FBox2D Box(Position - FVector2D(MaxDistance, MaxDistance), Position + FVector2D(MaxDistance, MaxDistance));
+
+	for (const FWall& Wall : Walls)
+	{
+		// Only cycle walls accelerate; own fresh walls don't count
+		if (Wall.bRim || (Wall.Owner == IgnoreOwner && Time - Wall.CreationTime < GraceTime))
+		{
+			continue;
+		}
+		if (FMath::Max(Wall.Start.X, Wall.End.X) < Box.Min.X || FMath::Min(Wall.Start.X, Wall.End.X) > Box.Max.X
+			|| FMath::Max(Wall.Start.Y, Wall.End.Y) < Box.Min.Y || FMath::Min(Wall.Start.Y, Wall.End.Y) > Box.Max.Y)
+		{
+			continue;
+		}
+
+		// Wall endpoints in the cycle's frame: X forward, Y to the left
+		const FVector2D RelStart = Wall.Start - Position;
+		const FVector2D RelEnd = Wall.End - Position;
+		const FVector2D A(FVector2D::DotProduct(RelStart, Forward), FVector2D::DotProduct(RelStart, Left));
+		const FVector2D B(FVector2D::DotProduct(RelEnd, Forward), FVector2D::DotProduct(RelEnd, Left));
+
+		const float LeftDist = ArmaWallKernel::DistanceInSideCone(A, B, Slope);
+		if (LeftDist < MaxDistance && LeftDist < Result.LeftDistance)
+		{
+			Result.LeftDistance = LeftDist;
+		}
+
+		// Mirror across the travel line for the right side
+		const float RightDist = ArmaWallKernel::DistanceInSideCone(FVector2D(A.X, -A.Y), FVector2D(B.X, -B.Y), Slope);
+		if (RightDist < MaxDistance && RightDist < Result.RightDistance)
+		{
+			Result.RightDistance = RightDist;
+		}
+	}
+
+	return Result;
+}
+
+void FArmaSimWallList::FindCycleWallsInRange(FVector2D Center, float Radius, TArray<FArmaSimWallInRange>& OutWalls)
+{
+	for (const FWall& Wall : Walls)
+	{
+		double T0, T1;
+		if (Wall.bRim || !ArmaWallKernel::ClipSegmentToCircle(Wall.Start, Wall.End, Center, Radius, T0, T1))
+		{
+			continue;
+		}
+
+		const double Length = (Wall.End - Wall.Start).Size();
+		FArmaSimWallInRange& Found = OutWalls.AddDefaulted_GetRef();
+		Found.Wall = Wall.Id;
+		Found.Owner = Wall.Owner;
+		Found.BeginDist = (float)(T0 * Length);
+		Found.EndDist = (float)(T1 * Length);
+	}
+}
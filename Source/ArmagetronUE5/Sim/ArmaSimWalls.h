@@ -0,0 +1,187 @@
+// ArmaSimWalls.h - The walls the simulation core collides against
+// The simulation names walls by small integer ids its backend hands out and cycles by
+// their simulation index, so it never sees an actor. In a world the backend is the wall
+// registry; headless runs and tests use FArmaSimWallList.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Core/ArmaWallKernel.h"
+
+/**
+ * One ray cast by the simulation
+ */
+struct FArmaSimRay
+{
+	FVector2D Origin = FVector2D::ZeroVector;
+	FVector2D Direction = FVector2D(1.0, 0.0);	// Normalized
+	float MaxDistance = 0.0f;
+	int32 IgnoreOwner = INDEX_NONE;				// This cycle's walls younger than GraceTime are skipped
+	float GraceTime = 0.0f;
+
+	FArmaSimRay() {}
+	FArmaSimRay(FVector2D InOrigin, FVector2D InDirection, float InMaxDistance, int32 InIgnoreOwner, float InGraceTime)
+		: Origin(InOrigin), Direction(InDirection), MaxDistance(InMaxDistance), IgnoreOwner(InIgnoreOwner), GraceTime(InGraceTime) {}
+};
+
+/**
+ * Closest wall along an FArmaSimRay
+ */
+struct FArmaSimHit
+{
+	float Distance = MAX_FLT;		// MAX_FLT if nothing was hit
+	float Side = 0.0f;				// Signed distance of the ray origin from the wall line (positive = left of Start->End)
+	int32 Wall = INDEX_NONE;		// Backend id of the wall
+	int32 Owner = INDEX_NONE;		// Cycle that laid it, INDEX_NONE for rim walls
+	bool bRim = false;
+
+	bool IsHit() const { return Distance < MAX_FLT; }
+};
+
+/**
+ * Nearest cycle walls beside a cycle (wall acceleration)
+ */
+struct FArmaSimSideWalls
+{
+	float LeftDistance = MAX_FLT;	// MAX_FLT if no wall within range
+	float RightDistance = MAX_FLT;
+};
+
+/**
+ * A cycle wall passing through a circle (explosions)
+ */
+struct FArmaSimWallInRange
+{
+	int32 Wall = INDEX_NONE;
+	int32 Owner = INDEX_NONE;
+	float BeginDist = 0.0f;			// Stretch inside the circle, along the wall from its start
+	float EndDist = 0.0f;
+};
+
+/**
+ * IArmaSimWalls - Wall storage and queries behind FArmaSimWorld
+ * Same rules as the registry: walls shorter than 1 unit are never hit, a cycle's own
+ * walls younger than the ray's grace time are skipped, and a ray running along a
+ * parallel wall hits its start.
+ */
+class ARMAGETRONUE5_API IArmaSimWalls
+{
+public:
+	virtual ~IArmaSimWalls() {}
+
+	// Simulation clock, for grace times and stay-up delays
+	virtual void SetTime(double Time) = 0;
+
+	// Start a cycle's growing wall at Start, returns its id
+	virtual int32 AddWall(int32 Owner, FVector2D Start) = 0;
+
+	// Move a wall's end (growing walls) or start (WALLS_LENGTH tail)
+	virtual void UpdateWallEnd(int32 Wall, FVector2D End) = 0;
+	virtual void UpdateWallStart(int32 Wall, FVector2D Start) = 0;
+
+	// Set a growing wall's final end, after a turn or death (or pull a finalized wall's end back)
+	virtual void FinalizeWall(int32 Wall, FVector2D End) = 0;
+
+	// Cut the stretch between HoleStart and HoleEnd out of a finalized wall: it now ends at
+	// HoleStart, and the rest becomes a new wall (returned) with the same owner, age and expiry
+	virtual int32 SplitWall(int32 Wall, FVector2D HoleStart, FVector2D HoleEnd) = 0;
+
+	virtual void RemoveWall(int32 Wall) = 0;
+	virtual void RemoveWallsByOwner(int32 Owner) = 0;
+
+	// Let every wall of a cycle fall Delay seconds from now (sg_wallsStayUpDelay)
+	virtual void ExpireWallsByOwner(int32 Owner, float Delay) = 0;
+
+	// Independent rays; OutHits has one entry per ray
+	virtual void CastRays(TConstArrayView<FArmaSimRay> Rays, TArrayView<FArmaSimHit> OutHits) = 0;
+
+	// A cycle's forward ray, asked once per step - backends may answer it from a per-cycle cache
+	virtual FArmaSimHit CastForwardRay(int32 Cycle, const FArmaSimRay& Ray)
+	{
+		FArmaSimHit Hit;
+		CastRays(MakeArrayView(&Ray, 1), MakeArrayView(&Hit, 1));
+		return Hit;
+	}
+
+	// Drop whatever CastForwardRay remembers about a cycle (it was respawned or removed)
+	virtual void ForgetCycle(int32 Cycle) {}
+
+	// Changes whenever walls change other than through the calls above (rim and static
+	// walls, expiry, clearing); the simulation's impact predictions are redone then
+	virtual uint32 GetForeignChangeStamp() const { return 0; }
+
+	// Rays hit parallel walls up to this far to the side of their line, so whatever
+	// could change a ray's answer lies within this distance of it
+	virtual float GetParallelTolerance() const { return 0.0f; }
+
+	// Nearest cycle wall on each side within MaxDistance, measured inside the side cones
+	virtual FArmaSimSideWalls FindNearestSideWalls(FVector2D Position, FVector2D Direction, float MaxDistance, int32 IgnoreOwner, float GraceTime) = 0;
+
+	// Every cycle wall passing within Radius of Center, once, with the stretch inside the circle
+	virtual void FindCycleWallsInRange(FVector2D Center, float Radius, TArray<FArmaSimWallInRange>& OutWalls) = 0;
+};
+
+/**
+ * FArmaSimWallList - Self-contained wall backend: the SoA hot store, brute-force kernel casts
+ * Enough for headless matches and rule tests with tens of cycles; no UObject anywhere.
+ */
+class ARMAGETRONUE5_API FArmaSimWallList : public IArmaSimWalls
+{
+public:
+	// Four rim walls around [-HalfWidth, HalfWidth] x [-HalfHeight, HalfHeight]
+	void AddRim(float HalfWidth, float HalfHeight);
+
+	// Drop every wall, rim included
+	void Reset();
+
+	int32 Num() const { return Walls.Num(); }
+
+	// IArmaSimWalls interface
+	virtual void SetTime(double InTime) override;
+	virtual int32 AddWall(int32 Owner, FVector2D Start) override;
+	virtual void UpdateWallEnd(int32 Wall, FVector2D End) override;
+	virtual void UpdateWallStart(int32 Wall, FVector2D Start) override;
+	virtual void FinalizeWall(int32 Wall, FVector2D End) override;
+	virtual int32 SplitWall(int32 Wall, FVector2D HoleStart, FVector2D HoleEnd) override;
+	virtual void RemoveWall(int32 Wall) override;
+	virtual void RemoveWallsByOwner(int32 Owner) override;
+	virtual void ExpireWallsByOwner(int32 Owner, float Delay) override;
+	virtual void CastRays(TConstArrayView<FArmaSimRay> Rays, TArrayView<FArmaSimHit> OutHits) override;
+	virtual FArmaSimSideWalls FindNearestSideWalls(FVector2D Position, FVector2D Direction, float MaxDistance, int32 IgnoreOwner, float GraceTime) override;
+	virtual void FindCycleWallsInRange(FVector2D Center, float Radius, TArray<FArmaSimWallInRange>& OutWalls) override;
+	virtual uint32 GetForeignChangeStamp() const override { return ForeignChangeStamp; }
+	virtual float GetParallelTolerance() const override { return ParallelTolerance; }
+
+private:
+	// Cold side of a wall, same dense index as the hot store
+	struct FWall
+	{
+		FVector2D Start = FVector2D::ZeroVector;
+		FVector2D End = FVector2D::ZeroVector;
+		int32 Owner = INDEX_NONE;
+		int32 Id = INDEX_NONE;
+		float CreationTime = 0.0f;
+		double ExpireTime = -1.0;	// < 0 = never
+		bool bRim = false;
+	};
+
+	int32 AddDense(FVector2D Start, FVector2D End, int32 Owner, bool bRim);
+	void RemoveAt(int32 DenseIndex);
+	void RemoveExpiredWalls();
+
+	FArmaWallHotStore HotWalls;
+	TArray<FWall> Walls;
+
+	// Id -> dense index, INDEX_NONE for free ids
+	TArray<int32> IdToDense;
+	TArray<int32> FreeIds;
+
+	double Time = 0.0;
+	double NextExpireTime = MAX_dbl;
+
+	// Rim, Reset and expiry
+	uint32 ForeignChangeStamp = 0;
+
+	// Rays running within this distance of a parallel wall hit its start (as in the registry)
+	static constexpr float ParallelTolerance = 5.0f;
+};
@@ -0,0 +1,1093 @@
+// ArmaSimWorld.cpp - Engine-independent cycle simulation implementation
+// Rules ported from gCycleMovement: the step order and constants match what
+// AArmaCyclePawn did in its own Tick before the simulation moved here
+
+#include "ArmaSimWorld.h"
+#include "ArmagetronUE5.h"
+
+namespace
+{
+	// Forward ray look-ahead beyond the step's move
+	const float ProbeLookahead = 50.0f;
+
+	// Impact prediction: how far ahead the long ray looks (in seconds at MaxSpeed) and
+	// the width of the speed bands it is scheduled for
+	const float ImpactHorizonTime = 0.5f;
+	const float ImpactSpeedBand = 100.0f;
+
+	int32 GetSpeedBand(float Speed)
+	{
+		return FMath::FloorToInt(Speed / ImpactSpeedBand);
+	}
+}
+
+int32 FArmaSimWorld::AddCycle(const FArmaSimCycleParams& InParams)
+{
+	int32 Cycle;
+	if (FreeCycles.Num() > 0)
+	{
+		Cycle = FreeCycles.Pop(EAllowShrinking::No);
+	}
+	else
+	{
+		Cycle = Cycles.AddDefaulted();
+		Params.AddDefaulted();
+		Trails.AddDefaulted();
+		Impacts.AddDefaulted();
+	}
+
+	Cycles[Cycle] = FArmaSimCycle();
+	Cycles[Cycle].bInUse = true;
+	Params[Cycle] = InParams;
+	Trails[Cycle].Reset();
+	Impacts[Cycle] = FImpact();
+	return Cycle;
+}
+
+void FArmaSimWorld::RemoveCycle(int32 Cycle)
+{
+	if (!IsValidCycle(Cycle))
+	{
+		return;
+	}
+
+	Walls.RemoveWallsByOwner(Cycle);
+	Walls.ForgetCycle(Cycle);
+	InvalidateImpactsOnOwner(Cycle);
+	Trails[Cycle].Reset();
+	Cycles[Cycle] = FArmaSimCycle();
+	Impacts[Cycle] = FImpact();
+	FreeCycles.Add(Cycle);
+}
+
+void FArmaSimWorld::SetParams(int32 Cycle, const FArmaSimCycleParams& InParams)
+{
+	if (IsValidCycle(Cycle))
+	{
+		Params[Cycle] = InParams;
+		Cycles[Cycle].Rubber = FMath::Min(Cycles[Cycle].Rubber, InParams.MaxRubber);
+
+		// The grace time decides which own walls the prediction saw
+		Impacts[Cycle].bValid = false;
+	}
+}
+
+void FArmaSimWorld::SetTime(double InTime)
+{
+	// Predictions are scheduled in absolute time; they'd come due late if it went back
+	if (InTime < Time - UE_KINDA_SMALL_NUMBER)
+	{
+		InvalidateAllImpacts();
+	}
+	Time = InTime;
+}
+
+void FArmaSimWorld::SpawnCycle(int32 Cycle, FVector2D Position, FVector2D Direction)
+{
+	if (!IsValidCycle(Cycle))
+	{
+		return;
+	}
+	const FArmaSimCycleParams& P = Params[Cycle];
+
+	// The old trail goes with the old life
+	Walls.RemoveWallsByOwner(Cycle);
+	Walls.ForgetCycle(Cycle);
+	InvalidateImpactsOnOwner(Cycle);
+	Trails[Cycle].Reset();
+	Impacts[Cycle] = FImpact();
+
+	FArmaSimCycle& C = Cycles[Cycle];
+	C = FArmaSimCycle();
+	C.bInUse = true;
+	C.bAlive = true;
+	C.Position = Position;
+	C.Direction = Direction.IsNearlyZero() ? FVector2D(1.0, 0.0) : Direction.GetSafeNormal();
+	C.Speed = P.BaseSpeed;
+	C.Rubber = P.MaxRubber;
+	C.SpawnTime = Time;
+
+	// First turn is allowed right away
+	C.LastTurnTime = Time - P.TurnDelay;
+	C.LastTurnPosition = Position;
+
+	StartNewWall(Cycle);
+}
+
+bool FArmaSimWorld::IsVulnerable(int32 Cycle) const
+{
+	const FArmaSimCycle& C = Cycles[Cycle];
+	return C.bAlive && (Time - C.SpawnTime) > Params[Cycle].SpawnInvulnerabilityTime;
+}
+
+bool FArmaSimWorld::CanTurn(int32 Cycle) const
+{
+	// ========== TURN DELAY (sg_delayCycle) ==========
+	const FArmaSimCycle& C = Cycles[Cycle];
+	return C.PendingTurns.IsEmpty() && (Time - C.LastTurnTime) >= Params[Cycle].TurnDelay;
+}
+
+float FArmaSimWorld::GetDistanceSinceLastTurn(int32 Cycle) const
+{
+	// The closer we are to the last turn, the closer we may get to walls (dig mechanic)
+	const FArmaSimCycle& C = Cycles[Cycle];
+	return (C.Position - C.LastTurnPosition).Size();
+}
+
+void FArmaSimWorld::RequestTurn(int32 Cycle, int32 Direction, double TurnTime)
+{
+	if (!IsValidCycle(Cycle) || !Cycles[Cycle].bAlive || Direction == 0)
+	{
+		return;
+	}
+	const int8 Turn = Direction < 0 ? -1 : 1;
+
+	// ========== TURN QUEUEING (like original gCycleMovement::DoTurn) ==========
+	// Turn now if it's meant for now and we can, otherwise queue it for its time; the
+	// simulation can't turn in the past, and the queue stays in time order
+	if (TurnTime <= Time && CanTurn(Cycle))
+	{
+		ExecuteTurn(Cycle, Turn);
+		return;
+	}
+
+	FArmaSimCycle& C = Cycles[Cycle];
+	TurnTime = FMath::Max(TurnTime, Time);
+	if (!C.PendingTurns.IsEmpty())
+	{
+		TurnTime = FMath::Max(TurnTime, C.PendingTurns.Last().Time);
+	}
+
+	const int32 TurnMemory = FMath::Clamp(Params[Cycle].TurnMemory, 1, (int32)FArmaSimCycle::MaxTurnMemory);
+	if (C.PendingTurns.Num() < TurnMemory)
+	{
+		C.PendingTurns.Push(TurnTime, Turn);
+	}
+	else if (C.PendingTurns.Last().Direction != Turn)
+	{
+		// Opposite turns cancel out
+		C.PendingTurns.PopLast();
+	}
+}
+
+double FArmaSimWorld::GetNextTurnTime(int32 Cycle) const
+{
+	const FArmaSimCycle& C = Cycles[Cycle];
+	if (!C.bAlive || C.PendingTurns.IsEmpty())
+	{
+		return MAX_dbl;
+	}
+	return FMath::Max(C.PendingTurns.First().Time, C.LastTurnTime + Params[Cycle].TurnDelay);
+}
+
+void FArmaSimWorld::ProcessPendingTurns(int32 Cycle)
+{
+	// ========== EXECUTE QUEUED TURNS (like original gCycleMovement::Timestep) ==========
+	// Step ends a sub-step at each turn's time, so the turn is made right where it was meant
+	while (GetNextTurnTime(Cycle) <= Time)
+	{
+		ExecuteTurn(Cycle, Cycles[Cycle].PendingTurns.PopFirst().Direction);
+	}
+}
+
+void FArmaSimWorld::ExecuteTurn(int32 Cycle, int32 Direction)
+{
+	FArmaSimCycle& C = Cycles[Cycle];
+	const FArmaSimCycleParams& P = Params[Cycle];
+
+	// ========== DIGGING MECHANIC (Armagetron advanced technique) ==========
+	// Turning while grinding a wall is allowed but costs extra rubber; the gap opens
+	// on the side we turn away from
+	const float DigDistance = P.MinWallDistance * 5.0f;
+	if (C.bGrinding && C.DistanceToWall < DigDistance)
+	{
+		const float DiggingCost = P.DiggingRubberMultiplier * (DigDistance - C.DistanceToWall);
+		C.Rubber = FMath::Max(0.0f, C.Rubber - DiggingCost);
+
+		float& Gap = Direction < 0 ? C.GapRight : C.GapLeft;
+		Gap = FMath::Max(Gap, C.DistanceToWall);
+	}
+
+	// ========== TURN SPEED FACTOR (sg_cycleTurnSpeedFactor) ==========
+	C.Speed *= P.TurnSpeedFactor;
+
+	// Turn time and position for the grace period and dig mechanic
+	C.LastTurnTime = Time;
+	C.LastTurnPosition = C.Position;
+
+	FinalizeCurrentWall(Cycle);
+
+	// 90 degrees left (counter-clockwise seen from above) or right
+	FVector2D NewDir;
+	if (FMath::Abs(C.Direction.X) > 0.5f)
+	{
+		NewDir = FVector2D(0.0, Direction < 0 ? -C.Direction.X : C.Direction.X);
+	}
+	else
+	{
+		NewDir = FVector2D(Direction < 0 ? C.Direction.Y : -C.Direction.Y, 0.0);
+	}
+	C.Direction = NewDir.GetSafeNormal();
+	Impacts[Cycle].bValid = false;
+
+	StartNewWall(Cycle);
+}
+
+void FArmaSimWorld::Kill(int32 Cycle, EArmaSimDeathCause Cause, int32 Killer)
+{
+	if (!IsValidCycle(Cycle) || !Cycles[Cycle].bAlive)
+	{
+		return;
+	}
+
+	FArmaSimCycle& C = Cycles[Cycle];
+	C.bAlive = false;
+	C.Speed = 0.0f;
+	Impacts[Cycle].bValid = false;
+
+	FinalizeCurrentWall(Cycle);
+
+	// The trail falls after WallsStayUpDelay, otherwise it stands until the respawn
+	if (Params[Cycle].WallsStayUpDelay >= 0.0f)
+	{
+		Walls.ExpireWallsByOwner(Cycle, Params[Cycle].WallsStayUpDelay);
+	}
+
+	if (Params[Cycle].ExplosionRadius > 0.0f)
+	{
+		PendingBlasts.Add({ C.Position, Params[Cycle].ExplosionRadius });
+	}
+
+	FArmaSimEvent& Event = Events.AddDefaulted_GetRef();
+	Event.Type = FArmaSimEvent::EType::Died;
+	Event.Cause = Cause;
+	Event.Cycle = Cycle;
+	Event.Killer = Killer;
+	Event.Position = C.Position;
+	Event.Direction = C.Direction;
+}
+
+void FArmaSimWorld::FinalizeCurrentWall(int32 Cycle)
+{
+	FArmaSimCycle& C = Cycles[Cycle];
+	if (C.CurrentWall == INDEX_NONE)
+	{
+		return;
+	}
+
+	Trails[Cycle].Add(C.WallStart, C.Position, C.CurrentWall, (float)Time);
+	Walls.FinalizeWall(C.CurrentWall, C.Position);
+	C.CurrentWall = INDEX_NONE;
+}
+
+void FArmaSimWorld::BlowPendingHoles()
+{
+	for (int32 i = 0; i < PendingBlasts.Num(); i++)
+	{
+		BlowHoles(PendingBlasts[i].Center, PendingBlasts[i].Radius);
+	}
+	PendingBlasts.Reset();
+}
+
+void FArmaSimWorld::BlowHoles(FVector2D Center, float Radius)
+{
+	if (Radius <= 0.0f)
+	{
+		return;
+	}
+
+	// A growing wall through the blast is closed at its cycle first, so every wall
+	// holed below is a trail segment
+	for (int32 Cycle = 0; Cycle < Cycles.Num(); Cycle++)
+	{
+		const FArmaSimCycle& C = Cycles[Cycle];
+		double T0, T1;
+		if (C.bInUse && C.CurrentWall != INDEX_NONE
+			&& ArmaWallKernel::ClipSegmentToCircle(C.WallStart, C.Position, Center, Radius, T0, T1))
+		{
+			FinalizeCurrentWall(Cycle);
+			StartNewWall(Cycle);
+		}
+	}
+
+	BlastWalls.Reset();
+	Walls.FindCycleWallsInRange(Center, Radius, BlastWalls);
+	for (const FArmaSimWallInRange& Found : BlastWalls)
+	{
+		// Fresh growing walls have nothing to hole yet
+		const int32 Index = Trails.IsValidIndex(Found.Owner) ? Trails[Found.Owner].FindWall(Found.Wall) : INDEX_NONE;
+		if (Index == INDEX_NONE)
+		{
+			continue;
+		}
+
+		FArmaWallTrail& Trail = Trails[Found.Owner];
+		const FArmaTrailSegment& Segment = Trail[Index];
+		const double Length = Segment.EndOffset - Segment.StartOffset;
+		const bool bKeepsStart = Found.BeginDist > UE_KINDA_SMALL_NUMBER;
+		const bool bKeepsEnd = Found.EndDist < Length - UE_KINDA_SMALL_NUMBER;
+
+		if (bKeepsStart && bKeepsEnd)
+		{
+			const FVector2D HoleStart = FMath::Lerp(Segment.Start, Segment.End, Found.BeginDist / Length);
+			const FVector2D HoleEnd = FMath::Lerp(Segment.Start, Segment.End, Found.EndDist / Length);
+			Trail.Split(Index, Found.BeginDist, Found.EndDist, Walls.SplitWall(Found.Wall, HoleStart, HoleEnd));
+		}
+		else if (bKeepsStart)
+		{
+			Walls.FinalizeWall(Found.Wall, Trail.CutEnd(Index, Found.BeginDist));
+		}
+		else if (bKeepsEnd)
+		{
+			Walls.UpdateWallStart(Found.Wall, Trail.CutStart(Index, Found.EndDist));
+		}
+		else
+		{
+			Walls.RemoveWall(Found.Wall);
+			Trail.ClearWall(Index);
+		}
+		InvalidateImpactsOnWall(Found.Wall);
+	}
+}
+
+void FArmaSimWorld::StartNewWall(int32 Cycle)
+{
+	// The wall is in the backend from its first step, so others collide with it right away
+	// (in Armagetron, currentWall->PartialCopyIntoGrid() does this continuously)
+	FArmaSimCycle& C = Cycles[Cycle];
+	C.WallStart = C.Position;
+	C.CurrentWall = Walls.AddWall(Cycle, C.Position);
+}
+
+void FArmaSimWorld::Step(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ArmaSimStep);
+	ARMA_TRACE_SCOPE("Arma.SimStep");
+
+	// ========== TIMED TURNS ==========
+	// The step runs in spans that end at the next queued turn anyone can make, so every
+	// turn happens at its own time instead of at the step's
+	const double EndTime = Time + DeltaTime;
+	while (Time < EndTime)
+	{
+		double SpanEnd = EndTime;
+		for (int32 Cycle = 0; Cycle < Cycles.Num(); Cycle++)
+		{
+			const double TurnTime = GetNextTurnTime(Cycle);
+			if (TurnTime > Time && TurnTime < SpanEnd)
+			{
+				SpanEnd = TurnTime;
+			}
+		}
+
+		// ========== ADAPTIVE SUB-STEPS ==========
+		// Nobody travels more than MaxSubStepDistance per sub-step; at normal speeds that's one
+		const float SpanTime = (float)(SpanEnd - Time);
+		const int32 NumSubSteps = GetNumSubSteps(SpanTime);
+		for (int32 i = 0; i < NumSubSteps; i++)
+		{
+			SubStep(SpanTime / NumSubSteps);
+		}
+		Time = SpanEnd;
+		Walls.SetTime(Time);
+	}
+}
+
+int32 FArmaSimWorld::GetNumSubSteps(float DeltaTime) const
+{
+	float MaxDistance = 0.0f;
+	for (const FArmaSimCycle& C : Cycles)
+	{
+		if (C.bAlive)
+		{
+			MaxDistance = FMath::Max(MaxDistance, C.Speed * DeltaTime);
+		}
+	}
+	return FMath::Clamp(FMath::CeilToInt(MaxDistance / MaxSubStepDistance), 1, MaxSubSteps);
+}
+
+void FArmaSimWorld::SubStep(float DeltaTime)
+{
+	// Turns due by the start of the sub-step are made where the cycles are now
+	for (int32 Cycle = 0; Cycle < Cycles.Num(); Cycle++)
+	{
+		ProcessPendingTurns(Cycle);
+	}
+
+	// The clock reads the end of the sub-step while it runs
+	Time += DeltaTime;
+	Walls.SetTime(Time);
+
+	Moves.Reset();
+	for (int32 Cycle = 0; Cycle < Cycles.Num(); Cycle++)
+	{
+		FMove Move;
+		if (UpdateCycle(Cycle, DeltaTime, Move))
+		{
+			Moves.Add(Move);
+		}
+	}
+	if (Moves.Num() == 0)
+	{
+		BlowPendingHoles();
+		return;
+	}
+
+	// ========== FORWARD RAYS ==========
+	// Swept over the whole move, against the walls as they stood before anyone moved.
+	// Walls the backend changed on its own may be anywhere: every prediction is redone
+	const uint32 Stamp = Walls.GetForeignChangeStamp();
+	if (Stamp != ForeignChangeStamp)
+	{
+		ForeignChangeStamp = Stamp;
+		InvalidateAllImpacts();
+	}
+
+	Hits.SetNum(Moves.Num(), EAllowShrinking::No);
+	for (int32 i = 0; i < Moves.Num(); i++)
+	{
+		Hits[i] = CastForwardRay(Moves[i], DeltaTime);
+	}
+
+	// ========== CROSSINGS (time of impact) ==========
+	// The rays can't see the walls grown during this step. Where two moves cross, whoever
+	// gets to the crossing later hits the other's new wall there; a tie takes out both
+	ResolveCrossings();
+
+	for (int32 i = 0; i < Moves.Num(); i++)
+	{
+		ApplyMove(Moves[i], Hits[i]);
+	}
+
+	// ========== POST-MOVE SAFETY PROBES ==========
+	// Four cardinal probes per surviving cycle, from where it ended up, in one batch
+	const FVector2D ProbeDirs[4] = {
+		FVector2D(1, 0), FVector2D(-1, 0), FVector2D(0, 1), FVector2D(0, -1)
+	};
+
+	Moves.RemoveAll([this](const FMove& Move) { return !Cycles[Move.Cycle].bAlive; }, EAllowShrinking::No);
+	Rays.Reset();
+	for (const FMove& Move : Moves)
+	{
+		for (const FVector2D& Dir : ProbeDirs)
+		{
+			Rays.Emplace(Cycles[Move.Cycle].Position, Dir, Move.SafetyDistance, Move.Cycle, Params[Move.Cycle].OwnWallGrace);
+		}
+	}
+	Hits.SetNum(Rays.Num(), EAllowShrinking::No);
+	Walls.CastRays(Rays, Hits);
+
+	for (int32 i = 0; i < Moves.Num(); i++)
+	{
+		FinishMove(Moves[i], MakeArrayView(Hits.GetData() + i * 4, 4));
+	}
+
+	// ========== EXPLOSIONS ==========
+	// Every death of the sub-step is in, so the holes don't depend on the order
+	BlowPendingHoles();
+}
+
+bool FArmaSimWorld::UpdateCycle(int32 Cycle, float DeltaTime, FMove& OutMove)
+{
+	FArmaSimCycle& C = Cycles[Cycle];
+	const FArmaSimCycleParams& P = Params[Cycle];
+	if (!C.bInUse || !C.bAlive)
+	{
+		return false;
+	}
+
+	// ========== ARMAGETRON-STYLE SPEED DECAY ==========
+	// Speed decays toward base speed, quickly from below and slowly from above
+	const float SpeedDiff = P.BaseSpeed - C.Speed;
+	if (C.Speed < P.BaseSpeed)
+	{
+		C.Speed += SpeedDiff * P.SpeedDecayBelow * DeltaTime;
+	}
+	else if (C.Speed > P.BaseSpeed)
+	{
+		C.Speed += SpeedDiff * P.SpeedDecayAbove * DeltaTime;
+	}
+	C.Speed = FMath::Clamp(C.Speed, P.MinSpeed, P.MaxSpeed);
+
+	UpdateWallAcceleration(Cycle, DeltaTime);
+	UpdateRubber(Cycle, DeltaTime);
+	UpdateWallDecay(Cycle);
+
+	OutMove.Cycle = Cycle;
+	OutMove.Start = C.Position;
+	OutMove.MoveDistance = C.Speed * DeltaTime;
+	OutMove.ProbeDistance = OutMove.MoveDistance + ProbeLookahead;
+	OutMove.SafetyDistance = P.MinWallDistance * 2.0f;
+	return true;
+}
+
+void FArmaSimWorld::UpdateWallAcceleration(int32 Cycle, float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ArmaUpdateWallAcceleration);
+	ARMA_TRACE_SCOPE("Arma.UpdateWallAcceleration");
+
+	// ========== ARMAGETRON-STYLE WALL ACCELERATION ==========
+	// Acceleration = accel * (1/(dist+offset) - 1/(nearDist+offset)) per side
+	// Only CYCLE walls accelerate, not the rim
+	FArmaSimCycle& C = Cycles[Cycle];
+	const FArmaSimCycleParams& P = Params[Cycle];
+	const float NearCycle = P.WallAccelDistance;	// sg_nearCycle
+
+	const FArmaSimSideWalls SideWalls = Walls.FindNearestSideWalls(C.Position, C.Direction, NearCycle, Cycle, P.OwnWallGrace);
+	C.LeftWallDistance = SideWalls.LeftDistance;
+	C.RightWallDistance = SideWalls.RightDistance;
+
+	const bool bLeft = SideWalls.LeftDistance < NearCycle;
+	const bool bRight = SideWalls.RightDistance < NearCycle;
+	const float FarFactor = 1.0f / (NearCycle + P.WallAccelOffset);
+
+	float TotalAcceleration = 0.0f;
+	if (bLeft)
+	{
+		TotalAcceleration += P.WallAcceleration * (1.0f / (SideWalls.LeftDistance + P.WallAccelOffset) - FarFactor);
+	}
+	if (bRight)
+	{
+		TotalAcceleration += P.WallAcceleration * (1.0f / (SideWalls.RightDistance + P.WallAccelOffset) - FarFactor);
+	}
+
+	// Slingshot bonus when walls on both sides
+	if (bLeft && bRight)
+	{
+		TotalAcceleration *= P.SlingshotMultiplier;
+	}
+
+	// Not while grinding into a wall ahead
+	if (TotalAcceleration > 0.0f && !C.bGrinding)
+	{
+		C.Speed = FMath::Min(P.MaxSpeed, C.Speed + TotalAcceleration * DeltaTime);
+	}
+}
+
+void FArmaSimWorld::UpdateRubber(int32 Cycle, float DeltaTime)
+{
+	// Rubber regenerates when not grinding, fully in sg_rubberCycleTime
+	FArmaSimCycle& C = Cycles[Cycle];
+	const FArmaSimCycleParams& P = Params[Cycle];
+
+	if (!C.bGrinding && P.RubberRegenTime > 0.0f)
+	{
+		C.Rubber += (P.MaxRubber / P.RubberRegenTime) * DeltaTime;
+	}
+	C.Rubber = FMath::Clamp(C.Rubber, 0.0f, P.MaxRubber);
+}
+
+void FArmaSimWorld::UpdateWallDecay(int32 Cycle)
+{
+	// ========== WALL LENGTH DECAY (Armagetron WALLS_LENGTH) ==========
+	// When the trail is longer than allowed, its tail is eaten from the oldest end
+	FArmaSimCycle& C = Cycles[Cycle];
+	const FArmaSimCycleParams& P = Params[Cycle];
+	FArmaWallTrail& Trail = Trails[Cycle];
+
+	// The trail keeps its own running total - only the growing segment is measured here
+	const float CurrentSegLength = C.CurrentWall != INDEX_NONE ? (C.Position - C.WallStart).Size() : 0.0f;
+	C.TotalWallLength = Trail.GetLength() + CurrentSegLength;
+
+	if (P.MaxWallsLength <= 0.0f || C.TotalWallLength <= P.MaxWallsLength)
+	{
+		return;
+	}
+
+	float ExcessLength = C.TotalWallLength - P.MaxWallsLength;
+
+	// Remove every segment that lies entirely inside the excess (oldest first)
+	const int32 NumExpired = Trail.CountSegmentsWithin(ExcessLength);
+	for (int32 i = 0; i < NumExpired; i++)
+	{
+		ExcessLength -= Trail.GetOldestLength();
+		const int32 Wall = Trail.RemoveOldest().Wall;
+		if (Wall != INDEX_NONE)
+		{
+			Walls.RemoveWall(Wall);
+			InvalidateImpactsOnWall(Wall);
+		}
+	}
+
+	// Shrink the tail partially
+	if (ExcessLength > 0.0f)
+	{
+		if (!Trail.IsEmpty())
+		{
+			const FVector2D NewStart = Trail.TrimOldest(ExcessLength);
+			const int32 OldestWall = Trail.Oldest().Wall;
+			if (OldestWall != INDEX_NONE)
+			{
+				Walls.UpdateWallStart(OldestWall, NewStart);
+				InvalidateImpactsOnWall(OldestWall);
+			}
+		}
+		else if (C.CurrentWall != INDEX_NONE && CurrentSegLength > 0.0f)
+		{
+			// Only the growing segment is left - its start follows the cycle
+			C.WallStart += (C.Position - C.WallStart).GetSafeNormal() * FMath::Min(ExcessLength, CurrentSegLength);
+			Walls.UpdateWallStart(C.CurrentWall, C.WallStart);
+			InvalidateImpactsOnWall(C.CurrentWall);
+		}
+	}
+
+	C.TotalWallLength = P.MaxWallsLength;
+}
+
+void FArmaSimWorld::AddSpark(int32 Cycle, float HitDistance)
+{
+	const FArmaSimCycle& C = Cycles[Cycle];
+
+	FArmaSimEvent& Event = Events.AddDefaulted_GetRef();
+	Event.Type = FArmaSimEvent::EType::Spark;
+	Event.Cycle = Cycle;
+	Event.Position = C.Position + C.Direction * HitDistance;
+	Event.Direction = -C.Direction;
+}
+
+void FArmaSimWorld::FindCrossings(int32 A, int32 B, TArray<FCrossing>& OutCrossings) const
+{
+	const FMove& MoveA = Moves[A];
+	const FMove& MoveB = Moves[B];
+	const FArmaSimCycle& CycleA = Cycles[MoveA.Cycle];
+	const FArmaSimCycle& CycleB = Cycles[MoveB.Cycle];
+
+	// CycleA.Position + CycleA.Direction * S = CycleB.Position + CycleB.Direction * T
+	// Parallel moves never cross; the forward ray sees a wall ahead from the last step
+	const float Denom = FVector2D::CrossProduct(CycleA.Direction, CycleB.Direction);
+	if (FMath::Abs(Denom) < UE_KINDA_SMALL_NUMBER)
+	{
+		return;
+	}
+	const FVector2D Delta = CycleB.Position - CycleA.Position;
+	const float S = FVector2D::CrossProduct(Delta, CycleB.Direction) / Denom;
+	const float T = FVector2D::CrossProduct(Delta, CycleA.Direction) / Denom;
+
+	auto AddCrossing = [&](int32 Victim, int32 Grower, float VictimDistance, float GrowerDistance)
+	{
+		const FMove& VictimMove = Moves[Victim];
+		const FMove& GrowerMove = Moves[Grower];
+
+		// The grower's new wall runs from its position as far as it gets this step
+		if (VictimMove.MoveDistance <= 0.0f || Cycles[GrowerMove.Cycle].CurrentWall == INDEX_NONE
+			|| VictimDistance < 0.0f || VictimDistance > VictimMove.Reach || VictimDistance >= Hits[Victim].Distance
+			|| GrowerDistance <= 0.0f || GrowerDistance > GrowerMove.Reach)
+		{
+			return;
+		}
+
+		// Both move at constant speed through the step: compare when each gets there
+		const float VictimTime = VictimDistance / VictimMove.MoveDistance;
+		if (GrowerDistance / GrowerMove.MoveDistance > VictimTime)
+		{
+			return;
+		}
+
+		FCrossing& Crossing = OutCrossings.AddDefaulted_GetRef();
+		Crossing.Time = VictimTime;
+		Crossing.Victim = Victim;
+		Crossing.Grower = Grower;
+		Crossing.VictimDistance = VictimDistance;
+		Crossing.GrowerDistance = GrowerDistance;
+	};
+	AddCrossing(A, B, S, T);
+	AddCrossing(B, A, T, S);
+}
+
+void FArmaSimWorld::ResolveCrossings()
+{
+	const int32 NumMoves = Moves.Num();
+	for (int32 i = 0; i < NumMoves; i++)
+	{
+		Moves[i].Reach = FMath::Min(Moves[i].MoveDistance, Hits[i].Distance);
+	}
+
+	// ========== BROAD PHASE ==========
+	// Swept box of each move up to its reach, swept along X as the registry backend
+	// clusters its rays: a box only meets the boxes still open when it starts, then prune on Y
+	TArray<FBox2D, TInlineAllocator<64>> Boxes;
+	TArray<int32, TInlineAllocator<64>> SortedByMinX;
+	for (int32 i = 0; i < NumMoves; i++)
+	{
+		const FMove& Move = Moves[i];
+		FBox2D Box(ForceInit);
+		Box += Move.Start;
+		Box += Move.Start + Cycles[Move.Cycle].Direction * Move.Reach;
+		Boxes.Add(Box);
+		SortedByMinX.Add(i);
+	}
+	SortedByMinX.Sort([&Boxes](int32 A, int32 B)
+	{
+		return Boxes[A].Min.X < Boxes[B].Min.X || (Boxes[A].Min.X == Boxes[B].Min.X && A < B);
+	});
+
+	Crossings.Reset();
+	TArray<int32, TInlineAllocator<64>> Active;
+	for (int32 Move : SortedByMinX)
+	{
+		const FBox2D& Box = Boxes[Move];
+		Active.RemoveAllSwap([&](int32 Other) { return Boxes[Other].Max.X < Box.Min.X; }, EAllowShrinking::No);
+
+		for (int32 Other : Active)
+		{
+			if (Boxes[Other].Min.Y <= Box.Max.Y && Box.Min.Y <= Boxes[Other].Max.Y)
+			{
+				FindCrossings(FMath::Min(Move, Other), FMath::Max(Move, Other), Crossings);
+			}
+		}
+		Active.Add(Move);
+	}
+
+	// ========== EARLIEST FIRST ==========
+	// A cycle stopped at a crossing lays no wall past it and reaches nothing beyond it, so
+	// a later crossing only counts if both moves still get that far. Crossings at the
+	// same time can't stop each other, which keeps ties (and the result) independent of order
+	Crossings.Sort([](const FCrossing& A, const FCrossing& B)
+	{
+		if (A.Time != B.Time)
+		{
+			return A.Time < B.Time;
+		}
+		return A.Victim < B.Victim || (A.Victim == B.Victim && A.Grower < B.Grower);
+	});
+
+	for (const FCrossing& Crossing : Crossings)
+	{
+		FMove& Victim = Moves[Crossing.Victim];
+		if (Crossing.VictimDistance > Victim.Reach || Crossing.GrowerDistance > Moves[Crossing.Grower].Reach)
+		{
+			continue;
+		}
+		Victim.Reach = Crossing.VictimDistance;
+
+		const FArmaSimCycle& VictimCycle = Cycles[Victim.Cycle];
+		const FArmaSimCycle& GrowerCycle = Cycles[Moves[Crossing.Grower].Cycle];
+		FArmaSimHit& Hit = Hits[Crossing.Victim];
+		Hit.Distance = Crossing.VictimDistance;
+		Hit.Side = FVector2D::CrossProduct(GrowerCycle.Direction, VictimCycle.Position - GrowerCycle.Position);
+		Hit.Wall = GrowerCycle.CurrentWall;
+		Hit.Owner = Moves[Crossing.Grower].Cycle;
+		Hit.bRim = false;
+	}
+}
+
+void FArmaSimWorld::ApplyMove(const FMove& Move, const FArmaSimHit& Hit)
+{
+	const int32 Cycle = Move.Cycle;
+	FArmaSimCycle& C = Cycles[Cycle];
+	const FArmaSimCycleParams& P = Params[Cycle];
+
+	const float DesiredMoveDistance = Move.MoveDistance;
+	float ClosestHitDist = Hit.Distance;
+	C.DistanceToWall = ClosestHitDist;
+
+	const bool bInTurnGrace = IsInTurnGrace(Cycle);
+
+	// ========== WALL SIDE TRACKING (prevent going through walls) ==========
+	// Remember which side of the wall ahead we're on; switching sides means crossing it
+	const bool bHitWall = Hit.IsHit();
+	if (bHitWall && Hit.Wall != INDEX_NONE)
+	{
+		if (C.SideTrackedWall != Hit.Wall)
+		{
+			C.SideTrackedWall = Hit.Wall;
+			C.WallSide = Hit.Side;
+		}
+		else if (C.WallSide * Hit.Side < 0.0f && IsVulnerable(Cycle) && !bInTurnGrace)
+		{
+			// Trying to cross through the wall - treat it as touching it
+			ClosestHitDist = 0.0f;
+		}
+		else
+		{
+			C.WallSide = Hit.Side;
+		}
+	}
+	else if (!bHitWall)
+	{
+		C.SideTrackedWall = INDEX_NONE;
+		C.WallSide = 0.0f;
+	}
+
+	// ========== PERFECT TURN PROTECTION (sg_rubberCycleMinAdjust) ==========
+	// Right after a turn we may get closer to walls than MinWallDistance:
+	// maxStop = (distSinceLastTurn + space) * (1 - sg_rubberCycleMinAdjust)
+	const float DistSinceTurn = GetDistanceSinceLastTurn(Cycle);
+	float EffectiveMinDistance = P.MinWallDistance;
+	if (bInTurnGrace || DistSinceTurn < 50.0f)
+	{
+		const float MaxStop = (DistSinceTurn + ClosestHitDist) * (1.0f - P.RubberMinAdjust);
+		EffectiveMinDistance = FMath::Max(0.1f, FMath::Min(MaxStop, P.MinWallDistance));
+
+		// Pixel-perfect turn right at the wall - almost no minimum
+		if (DistSinceTurn < 5.0f)
+		{
+			EffectiveMinDistance = 0.01f;
+		}
+	}
+
+	// ========== MOVEMENT WITH COLLISION RESPONSE ==========
+	float ActualMoveDistance = DesiredMoveDistance;
+	if (bHitWall && ClosestHitDist < DesiredMoveDistance + EffectiveMinDistance)
+	{
+		C.bGrinding = true;
+
+		// How far past the safe distance would we go?
+		const float SafeDistance = ClosestHitDist - EffectiveMinDistance;
+		if (SafeDistance < 0.0f)
+		{
+			// Already too close
+			if (C.Rubber > 0.0f)
+			{
+				// Rubber holds us at the minimum distance; digging (turn grace) is cheaper
+				// and still lets us squeeze forward
+				const float RubberMultiplier = bInTurnGrace ? 0.1f : 2.0f;
+				C.Rubber = FMath::Max(0.0f, C.Rubber - FMath::Abs(SafeDistance) * RubberMultiplier);
+				ActualMoveDistance = bInTurnGrace ? DesiredMoveDistance * 0.5f : 0.0f;
+
+				if (ClosestHitDist < 30.0f)
+				{
+					AddSpark(Cycle, ClosestHitDist);
+				}
+			}
+			else if (IsVulnerable(Cycle) && !bInTurnGrace)
+			{
+				Kill(Cycle, EArmaSimDeathCause::Wall, Hit.Owner);
+				return;
+			}
+			else if (bInTurnGrace)
+			{
+				// No rubber, but just turned - keep crawling
+				ActualMoveDistance = DesiredMoveDistance * 0.3f;
+			}
+		}
+		else if (SafeDistance < DesiredMoveDistance)
+		{
+			// We can move some, but not the full distance
+			if (C.Rubber > 0.0f)
+			{
+				const float Overshoot = DesiredMoveDistance - SafeDistance;
+				const float RubberMultiplier = bInTurnGrace ? 0.1f : 0.3f;
+				C.Rubber = FMath::Max(0.0f, C.Rubber - Overshoot * RubberMultiplier);
+				ActualMoveDistance = SafeDistance;
+
+				if (ClosestHitDist < 30.0f)
+				{
+					AddSpark(Cycle, ClosestHitDist);
+				}
+			}
+			else if (IsVulnerable(Cycle) && SafeDistance <= 0.0f && !bInTurnGrace)
+			{
+				Kill(Cycle, EArmaSimDeathCause::Wall, Hit.Owner);
+				return;
+			}
+			else
+			{
+				ActualMoveDistance = FMath::Max(0.0f, SafeDistance);
+			}
+		}
+	}
+	else
+	{
+		C.bGrinding = false;
+	}
+
+	// ========== MOVE ==========
+	C.Position += C.Direction * ActualMoveDistance;
+}
+
+void FArmaSimWorld::FinishMove(const FMove& Move, TConstArrayView<FArmaSimHit> SafetyHits)
+{
+	const int32 Cycle = Move.Cycle;
+	FArmaSimCycle& C = Cycles[Cycle];
+	const FArmaSimCycleParams& P = Params[Cycle];
+	const bool bInTurnGrace = IsInTurnGrace(Cycle);
+
+	// The growing wall reaches the new position either way (a kill below finalizes it there):
+	// predictions whose corridor it grows into are redone
+	if (C.CurrentWall != INDEX_NONE)
+	{
+		InvalidateImpactsInCorridor(Cycle, Move.Start, C.Position);
+	}
+
+	// ========== POST-MOVEMENT COLLISION CHECK (Safety Net) ==========
+	// Too close to a wall in any cardinal direction after moving: rubber or death
+	for (const FArmaSimHit& Nearby : SafetyHits)
+	{
+		if (Nearby.Distance < P.MinWallDistance && Nearby.bRim)
+		{
+			if (C.Rubber > 0.0f)
+			{
+				C.Rubber = FMath::Max(0.0f, C.Rubber - 5.0f);
+			}
+			else if (IsVulnerable(Cycle) && !bInTurnGrace)
+			{
+				Kill(Cycle, EArmaSimDeathCause::Contact, Nearby.Owner);
+				return;
+			}
+		}
+		else if (Nearby.Distance < 1.0f && Nearby.Owner != Cycle)
+		{
+			// Practically inside someone else's wall
+			if (C.Rubber > 0.0f)
+			{
+				C.Rubber = FMath::Max(0.0f, C.Rubber - 20.0f);
+			}
+			else if (IsVulnerable(Cycle))
+			{
+				Kill(Cycle, EArmaSimDeathCause::Contact, Nearby.Owner);
+				return;
+			}
+		}
+	}
+
+	// The growing wall follows the cycle
+	if (C.CurrentWall != INDEX_NONE)
+	{
+		Walls.UpdateWallEnd(C.CurrentWall, C.Position);
+	}
+}
+
+// ========== IMPACT PREDICTION ==========
+
+FArmaSimHit FArmaSimWorld::CastForwardRay(const FMove& Move, float DeltaTime)
+{
+	const int32 Cycle = Move.Cycle;
+	const FArmaSimCycle& C = Cycles[Cycle];
+	FImpact& Impact = Impacts[Cycle];
+
+	if (Impact.bValid && Time < Impact.ValidUntil)
+	{
+		// Speed left the band the schedule was made for (decay, wall acceleration, a pawn
+		// setting it): reschedule from here, the hit itself still stands
+		if (Impact.SpeedBand != GetSpeedBand(C.Speed))
+		{
+			ScheduleImpact(Cycle, DeltaTime);
+		}
+
+		if (Time < Impact.DueTime)
+		{
+			INC_DWORD_STAT(STAT_ArmaForwardRaysSkipped);
+			return FArmaSimHit();
+		}
+
+		// Due: the prediction answers while its hit is still ahead
+		const float Remaining = Impact.Hit.Distance - FVector2D::DotProduct(C.Position - Impact.Origin, Impact.Direction);
+		if (Impact.Hit.IsHit() && Remaining >= 0.0f)
+		{
+			INC_DWORD_STAT(STAT_ArmaForwardRaysSkipped);
+			FArmaSimHit Hit;
+			if (Remaining <= Move.ProbeDistance)
+			{
+				Hit = Impact.Hit;
+				Hit.Distance = Remaining;
+			}
+			return Hit;
+		}
+	}
+
+	// New prediction: one ray as far as the cycle gets in ImpactHorizonTime at full speed
+	const FArmaSimCycleParams& P = Params[Cycle];
+	const float Horizon = FMath::Max(Move.ProbeDistance, P.MaxSpeed * ImpactHorizonTime);
+	const FArmaSimRay Ray(C.Position, C.Direction, Horizon, Cycle, P.OwnWallGrace);
+
+	Impact.Origin = C.Position;
+	Impact.Direction = C.Direction;
+	Impact.Horizon = Horizon;
+	Impact.Hit = Walls.CastForwardRay(Cycle, Ray);
+	Impact.ValidUntil = GetHiddenOwnWallsVisibleTime(Cycle);
+	Impact.bValid = true;
+
+	Impact.Corridor = FBox2D(ForceInit);
+	Impact.Corridor += C.Position;
+	Impact.Corridor += C.Position + C.Direction * FMath::Min(Impact.Hit.Distance, Horizon);
+	// Padded like the backend's own ray queries: walls that close to the line are hit too
+	Impact.Corridor = Impact.Corridor.ExpandBy(Walls.GetParallelTolerance());
+
+	ScheduleImpact(Cycle, DeltaTime);
+
+	// This step's ray is the first ProbeDistance of it
+	return Impact.Hit.Distance <= Move.ProbeDistance ? Impact.Hit : FArmaSimHit();
+}
+
+void FArmaSimWorld::ScheduleImpact(int32 Cycle, float DeltaTime)
+{
+	// A sub-step's ray reaches ProbeLookahead past where the cycle ends it. At no more than
+	// the band's top speed it can't touch the hit (or the end of the horizon) before
+	// DueTime, counted from the start of this move
+	const FArmaSimCycle& C = Cycles[Cycle];
+	FImpact& Impact = Impacts[Cycle];
+
+	Impact.SpeedBand = GetSpeedBand(C.Speed);
+	const float TopSpeed = (Impact.SpeedBand + 1) * ImpactSpeedBand;
+
+	const float Travelled = FVector2D::DotProduct(C.Position - Impact.Origin, Impact.Direction);
+	const float Remaining = FMath::Min(Impact.Hit.Distance, Impact.Horizon) - Travelled;
+	Impact.DueTime = (Time - DeltaTime) + (Remaining - ProbeLookahead) / TopSpeed;
+}
+
+double FArmaSimWorld::GetHiddenOwnWallsVisibleTime(int32 Cycle) const
+{
+	// Every wall was started when the one before it was finalized (the trail's times) or at
+	// the spawn, and the cycle's rays skip it for OwnWallGrace after that
+	const FArmaWallTrail& Trail = Trails[Cycle];
+	const double Grace = Params[Cycle].OwnWallGrace;
+
+	double Oldest = Cycles[Cycle].SpawnTime;
+	for (int32 i = Trail.Num() - 1; i >= 0 && Time - Trail[i].CreationTime < Grace; i--)
+	{
+		Oldest = Trail[i].CreationTime;
+	}
+	return Time - Oldest < Grace ? Oldest + Grace : MAX_dbl;
+}
+
+void FArmaSimWorld::InvalidateImpactsOnWall(int32 Wall)
+{
+	if (Wall == INDEX_NONE)
+	{
+		return;
+	}
+	for (FImpact& Impact : Impacts)
+	{
+		if (Impact.bValid && Impact.Hit.Wall == Wall)
+		{
+			Impact.bValid = false;
+		}
+	}
+}
+
+void FArmaSimWorld::InvalidateImpactsOnOwner(int32 Owner)
+{
+	for (FImpact& Impact : Impacts)
+	{
+		if (Impact.bValid && Impact.Hit.Owner == Owner)
+		{
+			Impact.bValid = false;
+		}
+	}
+}
+
+void FArmaSimWorld::InvalidateImpactsInCorridor(int32 Grower, FVector2D Start, FVector2D End)
+{
+	FBox2D Growth(ForceInit);
+	Growth += Start;
+	Growth += End;
+
+	// The grower's own corridor points away from its growing wall
+	for (int32 Cycle = 0; Cycle < Impacts.Num(); Cycle++)
+	{
+		FImpact& Impact = Impacts[Cycle];
+		if (Impact.bValid && Cycle != Grower && Impact.Corridor.Intersect(Growth))
+		{
+			Impact.bValid = false;
+		}
+	}
+}
+
+void FArmaSimWorld::InvalidateAllImpacts()
+{
+	for (FImpact& Impact : Impacts)
+	{
+		Impact.bValid = false;
+	}
+}
@@ -0,0 +1,378 @@
+// ArmaSimWorld.h - Engine-independent cycle simulation
+// Speed decay, rubber, wall acceleration, turn queueing and wall collision for any number
+// of cycles, on plain structs. No UObject, world or actor is involved: AArmaCyclePawn
+// only presents what it computes, and headless runs and tests step it directly.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ArmaSimWalls.h"
+#include "ArmaWallTrail.h"
+
+/**
+ * Tunables of one cycle (the AArmaCyclePawn properties of the same names)
+ */
+struct FArmaSimCycleParams
+{
+	// Movement
+	float BaseSpeed = 800.0f;
+	float MinSpeed = 100.0f;
+	float MaxSpeed = 2000.0f;
+	float TurnSpeedFactor = 0.95f;		// sg_cycleTurnSpeedFactor
+	float SpeedDecayBelow = 5.0f;		// sg_speedCycleDecayBelow
+	float SpeedDecayAbove = 0.1f;		// sg_speedCycleDecayAbove
+	float TurnDelay = 0.1f;				// sg_delayCycle
+	int32 TurnMemory = 3;				// sg_cycleTurnMemory
+
+	// Rubber
+	float MaxRubber = 100.0f;
+	float RubberRegenTime = 10.0f;		// sg_rubberCycleTime - seconds to regenerate fully
+	float MinWallDistance = 1.0f;		// sg_rubberCycleMinDistance
+	float RubberMinAdjust = 0.05f;		// sg_rubberCycleMinAdjust
+	float TurnGracePeriod = 0.15f;
+	float DiggingRubberMultiplier = 3.0f;
+
+	// Wall acceleration
+	float WallAcceleration = 50000.0f;	// sg_accelerationCycle
+	float WallAccelDistance = 400.0f;	// sg_nearCycle
+	float WallAccelOffset = 10.0f;		// sg_accelerationCycleOffs
+	float SlingshotMultiplier = 2.0f;
+
+	// Own walls younger than this are ignored by the cycle's rays and side query
+	float OwnWallGrace = 0.3f;
+
+	// Respawn and walls
+	float SpawnInvulnerabilityTime = 2.0f;
+	float MaxWallsLength = -1.0f;		// WALLS_LENGTH, <= 0 = infinite
+	float WallsStayUpDelay = -1.0f;		// sg_wallsStayUpDelay, < 0 = until respawn
+	float ExplosionRadius = 0.0f;		// sg_explosionRadius - holes the walls around where the cycle dies, 0 = none
+};
+
+/**
+ * Why a cycle died
+ */
+enum class EArmaSimDeathCause : uint8
+{
+	Killed,			// From outside the simulation (FArmaSimWorld::Kill)
+	Wall,			// Ran into a wall with no rubber left
+	Contact,		// Ended a step touching a rim wall or another cycle's wall
+};
+
+/**
+ * Something presentation cares about, collected during a step
+ */
+struct FArmaSimEvent
+{
+	enum class EType : uint8
+	{
+		Died,
+		Spark,		// Rubber scraping a wall: Position is the contact point, Direction the normal
+	};
+
+	EType Type = EType::Died;
+	EArmaSimDeathCause Cause = EArmaSimDeathCause::Killed;
+	int32 Cycle = INDEX_NONE;
+	int32 Killer = INDEX_NONE;		// Died: the cycle whose wall it was, INDEX_NONE for rim walls and the boundary
+	FVector2D Position = FVector2D::ZeroVector;
+	FVector2D Direction = FVector2D::ZeroVector;
+};
+
+/**
+ * A cycle's requested turns, oldest first, each with the time it is to happen
+ * Fixed ring of Capacity entries (the most sg_cycleTurnMemory can be), so queueing and
+ * taking a turn never allocate or shift.
+ */
+struct FArmaSimTurnQueue
+{
+	static constexpr int32 Capacity = 8;
+
+	struct FTurn
+	{
+		double Time = 0.0;
+		int8 Direction = 0;			// -1 = left, +1 = right
+	};
+
+	int32 Num() const { return Count; }
+	bool IsEmpty() const { return Count == 0; }
+
+	const FTurn& First() const { return Turns[Head]; }
+	const FTurn& Last() const { return Turns[(Head + Count - 1) & (Capacity - 1)]; }
+
+	void Push(double Time, int8 Direction)
+	{
+		check(Count < Capacity);
+		FTurn& Turn = Turns[(Head + Count) & (Capacity - 1)];
+		Turn.Time = Time;
+		Turn.Direction = Direction;
+		Count++;
+	}
+
+	FTurn PopFirst()
+	{
+		const FTurn Turn = Turns[Head];
+		Head = (Head + 1) & (Capacity - 1);
+		Count--;
+		return Turn;
+	}
+
+	void PopLast() { Count--; }
+
+private:
+	static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+	FTurn Turns[Capacity];
+	uint8 Head = 0;
+	uint8 Count = 0;
+};
+
+/**
+ * Per-cycle state, kept small and contiguous so a step walks it linearly
+ */
+struct FArmaSimCycle
+{
+	static constexpr int32 MaxTurnMemory = FArmaSimTurnQueue::Capacity;
+
+	FVector2D Position = FVector2D::ZeroVector;
+	FVector2D Direction = FVector2D(1.0, 0.0);
+
+	float Speed = 0.0f;
+	float Rubber = 0.0f;
+	float DistanceToWall = 9999.0f;		// Last forward hit
+	float WallSide = 0.0f;				// Side of SideTrackedWall we were on (prevents crossing it)
+	int32 SideTrackedWall = INDEX_NONE;
+
+	float LeftWallDistance = MAX_FLT;	// Side query of the last step (MAX_FLT = nothing in range)
+	float RightWallDistance = MAX_FLT;
+	float GapLeft = 0.0f;				// Gaps opened by dig turns
+	float GapRight = 0.0f;
+
+	double SpawnTime = 0.0;
+	double LastTurnTime = 0.0;
+	FVector2D LastTurnPosition = FVector2D::ZeroVector;
+
+	// Growing wall, from WallStart to Position
+	int32 CurrentWall = INDEX_NONE;
+	FVector2D WallStart = FVector2D::ZeroVector;
+	float TotalWallLength = 0.0f;
+
+	// Turns waiting for their time or the turn delay
+	FArmaSimTurnQueue PendingTurns;
+
+	bool bInUse = false;
+	bool bAlive = false;
+	bool bGrinding = false;
+};
+
+/**
+ * FArmaSimWorld - Steps every cycle against an IArmaSimWalls backend
+ * A step first advances each live cycle on its own (speed decay, wall acceleration,
+ * rubber, WALLS_LENGTH) and collects its move, then resolves all moves in
+ * cycle order: every forward ray is cast against the walls as they stood before anyone
+ * moved, then the post-move probes are cast as one batch. So the outcome depends only on
+ * the state and the inputs, never on who was updated first.
+ *
+ * Collision is swept: the forward ray covers the whole move, and moves that cross in the
+ * same step are resolved by time of impact - whoever passes the crossing later hits the
+ * other's new wall there. Crossings are applied earliest first, so a cycle stopped by one
+ * grows no wall past it and reaches none beyond it. A step in which the fastest cycle would travel more than
+ * MaxSubStepDistance is split into sub-steps, so speed, rubber and the walls grown by
+ * others stay accurate at low frame rates while normal steps pay nothing extra. Rim
+ * walls bound the arena; there is no position clamp.
+ *
+ * Turns carry the time they were input. A step also ends a sub-step at every queued
+ * turn's time (or the end of its turn delay), so the turn is made exactly there and the
+ * step continues from it - the corner is where the player pressed, whatever the step rate.
+ *
+ * Forward rays are scheduled. Between turns a cycle runs a straight line, so one long
+ * ray predicts its next impact, and the step-length ray is only cast again once the
+ * look-ahead could reach it at the top of the cycle's current speed band. Until then the
+ * ray is skipped; after that the prediction answers it for as long as it holds. A turn,
+ * a new speed band, a wall growing into the corridor ahead, the predicted wall being
+ * removed or shortened, or a wall change the backend reports as foreign
+ * (GetForeignChangeStamp) casts a new prediction.
+ */
+class ARMAGETRONUE5_API FArmaSimWorld
+{
+public:
+	explicit FArmaSimWorld(IArmaSimWalls& InWalls) : Walls(InWalls) {}
+
+	// Add a cycle (not spawned yet), returns its index
+	int32 AddCycle(const FArmaSimCycleParams& Params);
+
+	// Remove a cycle and its walls; the index may be reused
+	void RemoveCycle(int32 Cycle);
+
+	// Put a cycle at Position, alive, with a fresh trail (clears any walls it had)
+	void SpawnCycle(int32 Cycle, FVector2D Position, FVector2D Direction);
+
+	// Turn at TurnTime, or as soon after as the turn delay allows (Direction < 0 = left, > 0 = right).
+	// A time the simulation has already passed means now; if the cycle can turn now, it does
+	void RequestTurn(int32 Cycle, int32 Direction, double TurnTime);
+	void RequestTurn(int32 Cycle, int32 Direction) { RequestTurn(Cycle, Direction, Time); }
+
+	// Kill a live cycle; Killer is credited in the Died event. Its explosion is blown at the
+	// end of the (current or next) sub-step, after every move, so holes don't depend on who died first
+	void Kill(int32 Cycle, EArmaSimDeathCause Cause = EArmaSimDeathCause::Killed, int32 Killer = INDEX_NONE);
+
+	// Blow a hole into every cycle wall within Radius of Center (gExplosion): walls are cut
+	// back, split around the hole or removed, and the trails follow
+	void BlowHoles(FVector2D Center, float Radius);
+
+	// Advance every cycle by DeltaTime, in sub-steps if anyone is fast enough to need them
+	// and split at the time of every queued turn
+	void Step(float DeltaTime);
+
+	// Farthest a cycle moves in one sub-step
+	static constexpr float MaxSubStepDistance = 50.0f;
+	static constexpr int32 MaxSubSteps = 32;
+
+	double GetTime() const { return Time; }
+	void SetTime(double InTime);
+
+	bool IsValidCycle(int32 Cycle) const { return Cycles.IsValidIndex(Cycle) && Cycles[Cycle].bInUse; }
+	int32 GetNumCycles() const { return Cycles.Num(); }
+
+	const FArmaSimCycle& GetCycle(int32 Cycle) const { return Cycles[Cycle]; }
+	FArmaSimCycle& GetCycle(int32 Cycle) { return Cycles[Cycle]; }
+
+	const FArmaSimCycleParams& GetParams(int32 Cycle) const { return Params[Cycle]; }
+	void SetParams(int32 Cycle, const FArmaSimCycleParams& InParams);
+
+	const FArmaWallTrail& GetTrail(int32 Cycle) const { return Trails[Cycle]; }
+
+	bool IsVulnerable(int32 Cycle) const;
+	bool CanTurn(int32 Cycle) const;
+	float GetDistanceSinceLastTurn(int32 Cycle) const;
+
+	// Events since the last ClearEvents
+	TConstArrayView<FArmaSimEvent> GetEvents() const { return Events; }
+	void ClearEvents() { Events.Reset(); }
+
+	IArmaSimWalls& GetWalls() const { return Walls; }
+
+private:
+	// A cycle's intended move for this step
+	struct FMove
+	{
+		int32 Cycle = INDEX_NONE;
+		float MoveDistance = 0.0f;		// How far the cycle wants to travel
+		float ProbeDistance = 0.0f;		// Length of the forward ray (move plus look-ahead)
+		float SafetyDistance = 0.0f;	// Length of the post-move probes
+		float Reach = 0.0f;				// How far it gets before walls (and crossings applied so far) stop it
+		FVector2D Start = FVector2D::ZeroVector;	// Where the move (and this step's wall growth) starts
+	};
+
+	// A cycle's predicted forward hit, from one long ray down its straight
+	struct FImpact
+	{
+		FVector2D Origin = FVector2D::ZeroVector;
+		FVector2D Direction = FVector2D::ZeroVector;
+		float Horizon = 0.0f;			// Length of the ray; a miss means nothing this close
+		FArmaSimHit Hit;				// Distance measured from Origin
+		FBox2D Corridor = FBox2D(ForceInit);	// Origin to the hit (or the horizon), padded by the backend's parallel tolerance
+		double DueTime = 0.0;			// The forward ray isn't needed before this
+		double ValidUntil = MAX_dbl;	// Own walls hidden by the grace time show up then
+		int32 SpeedBand = 0;			// DueTime assumes the top speed of this band
+		bool bValid = false;
+	};
+
+	// One sub-step: update, forward rays, crossings, moves, probes
+	void SubStep(float DeltaTime);
+
+	// How many sub-steps the rest of a step needs at current speeds
+	int32 GetNumSubSteps(float DeltaTime) const;
+
+	// When a cycle's oldest queued turn can be made, MAX_dbl if none is queued
+	double GetNextTurnTime(int32 Cycle) const;
+
+	// Per-cycle update before collision; false if the cycle doesn't move this step
+	bool UpdateCycle(int32 Cycle, float DeltaTime, FMove& OutMove);
+
+	// The forward hit of a move: skipped while no impact is due, answered by the prediction
+	// while it holds, otherwise a new prediction is cast
+	FArmaSimHit CastForwardRay(const FMove& Move, float DeltaTime);
+
+	// Reschedule an impact from the cycle's position at the start of the move
+	void ScheduleImpact(int32 Cycle, float DeltaTime);
+
+	// When the first of the cycle's walls its rays can't see yet becomes visible
+	double GetHiddenOwnWallsVisibleTime(int32 Cycle) const;
+
+	// Predictions that a wall change may have made wrong
+	void InvalidateImpactsOnWall(int32 Wall);
+	void InvalidateImpactsOnOwner(int32 Owner);
+	void InvalidateImpactsInCorridor(int32 Grower, FVector2D Start, FVector2D End);
+	void InvalidateAllImpacts();
+
+	// Two moves of this step crossing: Victim gets there after Grower has laid its wall
+	struct FCrossing
+	{
+		float Time = 0.0f;				// Fraction of the step at which Victim gets there
+		int32 Victim = INDEX_NONE;		// Indices into Moves
+		int32 Grower = INDEX_NONE;
+		float VictimDistance = 0.0f;	// Along each move from its start
+		float GrowerDistance = 0.0f;
+	};
+
+	// Where moves A and B cross within their reach: whoever gets there later hits the
+	// other's new wall, a tie gives both. Appended to OutCrossings
+	void FindCrossings(int32 A, int32 B, TArray<FCrossing>& OutCrossings) const;
+
+	// Pair up the moves whose swept segments' boxes overlap (sweep and prune along X),
+	// then apply their crossings in time-of-impact order, shortening Reach as they go
+	void ResolveCrossings();
+
+	// Make the queued turns that are due by now
+	void ProcessPendingTurns(int32 Cycle);
+	void ExecuteTurn(int32 Cycle, int32 Direction);
+	void UpdateWallAcceleration(int32 Cycle, float DeltaTime);
+	void UpdateRubber(int32 Cycle, float DeltaTime);
+	void UpdateWallDecay(int32 Cycle);
+
+	// Forward hit: side tracking, rubber and the move itself
+	void ApplyMove(const FMove& Move, const FArmaSimHit& Hit);
+
+	// Post-move probes, then the growing wall follows the cycle
+	void FinishMove(const FMove& Move, TConstArrayView<FArmaSimHit> SafetyHits);
+
+	// Close the growing wall at the cycle's position and add it to the trail
+	void FinalizeCurrentWall(int32 Cycle);
+	void StartNewWall(int32 Cycle);
+
+	bool IsInTurnGrace(int32 Cycle) const { return Time - Cycles[Cycle].LastTurnTime < Params[Cycle].TurnGracePeriod; }
+
+	void AddSpark(int32 Cycle, float HitDistance);
+
+	// Explosions of the cycles killed since the last call
+	void BlowPendingHoles();
+
+	IArmaSimWalls& Walls;
+	double Time = 0.0;
+
+	// Parallel arrays by cycle index: hot state, tunables, finalized trail, forward prediction
+	TArray<FArmaSimCycle> Cycles;
+	TArray<FArmaSimCycleParams> Params;
+	TArray<FArmaWallTrail> Trails;
+	TArray<FImpact> Impacts;
+	TArray<int32> FreeCycles;
+
+	// Backend's GetForeignChangeStamp when the predictions were last checked against it
+	uint32 ForeignChangeStamp = 0;
+
+	TArray<FArmaSimEvent> Events;
+
+	// Explosions waiting for the end of the sub-step
+	struct FBlast
+	{
+		FVector2D Center = FVector2D::ZeroVector;
+		float Radius = 0.0f;
+	};
+	TArray<FBlast> PendingBlasts;
+
+	// Scratch, reused every step
+	TArray<FMove> Moves;
+	TArray<FArmaSimRay> Rays;
+	TArray<FArmaSimHit> Hits;
+	TArray<FCrossing> Crossings;
+	TArray<FArmaSimWallInRange> BlastWalls;
+};
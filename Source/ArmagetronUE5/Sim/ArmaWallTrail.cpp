@@ -0,0 +1,137 @@
+// ArmaWallTrail.cpp - Cycle wall trail implementation
+
+#include "ArmaWallTrail.h"
+
+void FArmaWallTrail::Add(FVector2D Start, FVector2D End, int32 Wall, float CreationTime)
+{
+	const double PrevOffset = Segments.IsEmpty() ? TailOffset : HeadOffset;
+
+	FArmaTrailSegment& Segment = Segments.Emplace_GetRef();
+	Segment.Start = Start;
+	Segment.End = End;
+	Segment.Wall = Wall;
+	Segment.CreationTime = CreationTime;
+	Segment.StartOffset = PrevOffset;
+	Segment.EndOffset = PrevOffset + (End - Start).Size();
+	HeadOffset = Segment.EndOffset;
+}
+
+void FArmaWallTrail::Reset()
+{
+	Segments.Reset();
+	TailOffset = 0.0;
+	HeadOffset = 0.0;
+}
+
+int32 FArmaWallTrail::CountSegmentsWithin(float Distance) const
+{
+	// First segment whose end lies beyond the tail + Distance
+	const double Limit = TailOffset + Distance;
+	int32 Lo = 0;
+	int32 Hi = Segments.Num();
+	while (Lo < Hi)
+	{
+		const int32 Mid = (Lo + Hi) / 2;
+		if (Segments[Mid].EndOffset <= Limit)
+		{
+			Lo = Mid + 1;
+		}
+		else
+		{
+			Hi = Mid;
+		}
+	}
+	return Lo;
+}
+
+int32 FArmaWallTrail::FindWall(int32 Wall) const
+{
+	// Explosions mostly hit the fresh end of a trail
+	for (int32 i = Segments.Num() - 1; i >= 0; i--)
+	{
+		if (Segments[i].Wall == Wall)
+		{
+			return i;
+		}
+	}
+	return INDEX_NONE;
+}
+
+FArmaTrailSegment FArmaWallTrail::RemoveOldest()
+{
+	FArmaTrailSegment Oldest = Segments.PopFrontValue();
+	TailOffset = Oldest.EndOffset;
+	return Oldest;
+}
+
+FVector2D FArmaWallTrail::TrimOldest(float Distance)
+{
+	FArmaTrailSegment& Oldest = Segments.First();
+	if (Distance <= 0.0f)
+	{
+		return Oldest.Start;
+	}
+
+	// The tail may still be inside a hole in front of the segment
+	const double NewTail = FMath::Min(TailOffset + Distance, Oldest.EndOffset);
+	if (NewTail > Oldest.StartOffset)
+	{
+		const double Alpha = (NewTail - Oldest.StartOffset) / (Oldest.EndOffset - Oldest.StartOffset);
+		Oldest.Start = FMath::Lerp(Oldest.Start, Oldest.End, Alpha);
+		Oldest.StartOffset = NewTail;
+	}
+	TailOffset = FMath::Max(TailOffset, NewTail);
+	return Oldest.Start;
+}
+
+FVector2D FArmaWallTrail::CutStart(int32 Index, float Distance)
+{
+	FArmaTrailSegment& Segment = Segments[Index];
+	const double Length = Segment.EndOffset - Segment.StartOffset;
+	if (Distance > 0.0f && Length > 0.0)
+	{
+		const double Cut = FMath::Min((double)Distance, Length);
+		Segment.Start = FMath::Lerp(Segment.Start, Segment.End, Cut / Length);
+		Segment.StartOffset += Cut;
+	}
+	return Segment.Start;
+}
+
+FVector2D FArmaWallTrail::CutEnd(int32 Index, float Distance)
+{
+	FArmaTrailSegment& Segment = Segments[Index];
+	const double Length = Segment.EndOffset - Segment.StartOffset;
+	if (Distance < Length && Length > 0.0)
+	{
+		const double Kept = FMath::Max((double)Distance, 0.0);
+		Segment.End = FMath::Lerp(Segment.Start, Segment.End, Kept / Length);
+		Segment.EndOffset = Segment.StartOffset + Kept;
+	}
+	return Segment.End;
+}
+
+void FArmaWallTrail::Split(int32 Index, float HoleBegin, float HoleEnd, int32 FarWall)
+{
+	// The ring has no insert; the newer segments are taken off and put back behind the far piece
+	TArray<FArmaTrailSegment, TInlineAllocator<8>> Newer;
+	while (Segments.Num() > Index + 1)
+	{
+		Newer.Add(Segments.PopValue());
+	}
+
+	FArmaTrailSegment Far = Segments.Last();
+	const double Length = Far.EndOffset - Far.StartOffset;
+	if (Length > 0.0)
+	{
+		Far.Start = FMath::Lerp(Far.Start, Far.End, FMath::Clamp(HoleEnd / Length, 0.0, 1.0));
+	}
+	Far.StartOffset += FMath::Clamp((double)HoleEnd, 0.0, Length);
+	Far.Wall = FarWall;
+
+	CutEnd(Index, HoleBegin);
+	Segments.Add(Far);
+	for (int32 i = Newer.Num() - 1; i >= 0; i--)
+	{
+		Segments.Add(Newer[i]);
+	}
+}
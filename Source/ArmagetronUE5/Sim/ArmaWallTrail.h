@@ -0,0 +1,75 @@
+// ArmaWallTrail.h - A cycle's finalized wall segments in laying order, for WALLS_LENGTH decay
+// Based on the original's gCycle wall list: the tail is eaten from the oldest end
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/RingBuffer.h"
+
+/**
+ * One finalized segment of a cycle's trail
+ */
+struct FArmaTrailSegment
+{
+	FVector2D Start = FVector2D::ZeroVector;	// Moves forward as the tail shrinks
+	FVector2D End = FVector2D::ZeroVector;
+	int32 Wall = INDEX_NONE;					// Id the wall backend gave the segment, INDEX_NONE once blown away
+	float CreationTime = 0.0f;
+
+	double StartOffset = 0.0;					// Trail distance laid down up to Start
+	double EndOffset = 0.0;						// Trail distance laid down up to End (prefix sum)
+};
+
+/**
+ * FArmaWallTrail - Ring buffer of a cycle's segments, oldest first
+ * Every segment stores the running trail distance at its ends, so the total length,
+ * the oldest segment and the number of segments inside a given distance from the
+ * tail are all found without walking the trail.
+ *
+ * Explosion holes leave gaps between segments (or segments without a wall). Lengths
+ * still count the distance as laid, holes included, so WALLS_LENGTH eats through a
+ * hole at the same rate as through the wall it replaced.
+ */
+class ARMAGETRONUE5_API FArmaWallTrail
+{
+public:
+	void Add(FVector2D Start, FVector2D End, int32 Wall, float CreationTime);
+	void Reset();
+
+	int32 Num() const { return Segments.Num(); }
+	bool IsEmpty() const { return Segments.IsEmpty(); }
+
+	// 0 = oldest
+	const FArmaTrailSegment& operator[](int32 Index) const { return Segments[Index]; }
+	const FArmaTrailSegment& Oldest() const { return Segments.First(); }
+
+	// Length still standing, from the (possibly shrunk) tail to the newest segment's end
+	float GetLength() const { return Segments.IsEmpty() ? 0.0f : (float)(HeadOffset - TailOffset); }
+	float GetOldestLength() const { return Segments.IsEmpty() ? 0.0f : (float)(Segments.First().EndOffset - TailOffset); }
+
+	// Number of oldest segments lying entirely within Distance of the tail (binary search)
+	int32 CountSegmentsWithin(float Distance) const;
+
+	// Index of the segment holding Wall, INDEX_NONE if none does
+	int32 FindWall(int32 Wall) const;
+
+	// Drop the oldest segment; the caller removes its wall
+	FArmaTrailSegment RemoveOldest();
+
+	// Shrink the oldest segment by Distance (less than its length), returns its new start
+	FVector2D TrimOldest(float Distance);
+
+	// Explosion holes, distances along the segment from its start. The caller changes the
+	// walls to match: the start moves to Distance / the end back to Distance (returned),
+	// the stretch between is cut out (the far piece becomes segment Index + 1 with FarWall),
+	// or the whole wall is gone and the segment only keeps its place in the trail
+	FVector2D CutStart(int32 Index, float Distance);
+	FVector2D CutEnd(int32 Index, float Distance);
+	void Split(int32 Index, float HoleBegin, float HoleEnd, int32 FarWall);
+	void ClearWall(int32 Index) { Segments[Index].Wall = INDEX_NONE; }
+
+private:
+	TRingBuffer<FArmaTrailSegment> Segments;
+	double TailOffset = 0.0;					// Trail distance at the oldest segment's current start
+	double HeadOffset = 0.0;					// Trail distance at the newest segment's end as laid
+};